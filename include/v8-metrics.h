@@ -156,6 +156,27 @@ struct WasmModulesPerIsolate {
   size_t count = 0;
 };
 
+/**
+ * Reported when a function whose optimized code keeps getting deoptimized
+ * is considered unstable (see --deopt-storm-backoff), and again on each
+ * further deoptimization of that function.
+ */
+struct DeoptimizationStorm {
+  // Reason of the deoptimization that triggered this event.
+  const char* reason = nullptr;
+  // Bytecode offset at which that deoptimization happened, or -1 if unknown.
+  int bytecode_offset = -1;
+  // Number of deoptimizations of the function's optimized code so far.
+  size_t deopt_count = 0;
+  // Number of inline cache state changes observed for the function since its
+  // previous deoptimization.
+  size_t map_churn = 0;
+  // Exponent of the backoff applied to the next optimization attempt.
+  int backoff_exponent = 0;
+  // Whether the function will no longer be optimized with TurboFan.
+  bool limited_to_maglev = false;
+};
+
 /**
  * This class serves as a base class for recording event-based metrics in V8.
  * There a two kinds of metrics, those which are expected to be thread-safe and
@@ -208,6 +229,7 @@ class V8_EXPORT Recorder {
   ADD_MAIN_THREAD_EVENT(WasmModuleDecoded)
   ADD_MAIN_THREAD_EVENT(WasmModuleCompiled)
   ADD_MAIN_THREAD_EVENT(WasmModuleInstantiated)
+  ADD_MAIN_THREAD_EVENT(DeoptimizationStorm)
 #undef ADD_MAIN_THREAD_EVENT
 
   // Thread-safe events are not allowed to access the context and therefore do
@@ -196,6 +196,20 @@ class V8_EXPORT WasmStreaming final {
   std::unique_ptr<WasmStreamingImpl> impl_;
 };
 
+/**
+ * Access to the binary execution trace which V8 writes if the
+ * --wasm-trace-file flag is given, see tools/wasm/memory-trace-analyzer.py.
+ */
+class V8_EXPORT WasmTrace {
+ public:
+  /**
+   * Writes the events recorded so far by all threads to the trace file, such
+   * that a running application can be analyzed. Returns false if no trace
+   * file is configured.
+   */
+  static bool Flush();
+};
+
 }  // namespace v8
 
 #endif  // INCLUDE_V8_WASM_H_
@@ -124,14 +124,17 @@
 #include "src/strings/char-predicates-inl.h"
 #include "src/strings/string-hasher.h"
 #include "src/strings/unicode-inl.h"
+#include "src/strings/utf8-simd.h"
 #include "src/tracing/trace-event.h"
 #include "src/utils/detachable-vector.h"
 #include "src/utils/identity-map.h"
+#include "src/utils/memcopy.h"
 #include "src/utils/version.h"
 
 #if V8_ENABLE_WEBASSEMBLY
 #include "src/debug/debug-wasm-objects.h"
 #include "src/trap-handler/trap-handler.h"
+#include "src/wasm/memory-tracing.h"
 #include "src/wasm/streaming-decoder.h"
 #include "src/wasm/value-type.h"
 #include "src/wasm/wasm-engine.h"
@@ -5773,20 +5776,10 @@ int String::Utf8Length(Isolate* v8_isolate) const {
   i::DisallowGarbageCollection no_gc;
   i::String::FlatContent flat = str->GetFlatContent(no_gc);
   DCHECK(flat.IsFlat());
-  int utf8_length = 0;
   if (flat.IsOneByte()) {
-    for (uint8_t c : flat.ToOneByteVector()) {
-      utf8_length += c >> 7;
-    }
-    utf8_length += length;
-  } else {
-    int last_character = unibrow::Utf16::kNoPreviousCharacter;
-    for (uint16_t c : flat.ToUC16Vector()) {
-      utf8_length += unibrow::Utf8::Length(c, last_character);
-      last_character = c;
-    }
+    return i::Utf8EncodedLength(flat.ToOneByteVector());
   }
-  return utf8_length;
+  return i::Utf8EncodedLength(flat.ToUC16Vector());
 }
 
 namespace {
@@ -5826,29 +5819,29 @@ static int WriteUtf8Impl(base::Vector<const Char> string, char* write_start,
       up_to = std::min(up_to, read_index + writable_length);
     }
     // Write the characters to the stream.
-    if (sizeof(Char) == 1) {
-      // Simply memcpy if we only have ASCII characters.
-      uint8_t char_mask = 0;
-      for (int i = read_index; i < up_to; i++) char_mask |= read_start[i];
-      if ((char_mask & 0x80) == 0) {
-        int copy_length = up_to - read_index;
-        memcpy(current_write, read_start + read_index, copy_length);
-        current_write += copy_length;
-        read_index = up_to;
-      } else {
-        for (; read_index < up_to; read_index++) {
-          current_write += unibrow::Utf8::EncodeOneByte(
-              current_write, static_cast<uint8_t>(read_start[read_index]));
-          DCHECK(write_capacity == -1 ||
-                 (current_write - write_start) <= write_capacity);
-        }
+    // Copy runs of ASCII characters, and encode the others one by one.
+    while (read_index < up_to) {
+      int ascii_length = i::AsciiPrefixLength(base::Vector<const Char>(
+          read_start + read_index, up_to - read_index));
+      i::CopyChars(reinterpret_cast<uint8_t*>(current_write),
+                   read_start + read_index, ascii_length);
+      current_write += ascii_length;
+      read_index += ascii_length;
+      if (sizeof(Char) == 2 && ascii_length > 0) {
+        prev_char = read_start[read_index - 1];
       }
-    } else {
-      for (; read_index < up_to; read_index++) {
+      for (; read_index < up_to &&
+             read_start[read_index] > unibrow::Utf8::kMaxOneByteChar;
+           read_index++) {
         uint16_t character = read_start[read_index];
-        current_write += unibrow::Utf8::Encode(current_write, character,
-                                               prev_char, replace_invalid_utf8);
-        prev_char = character;
+        if (sizeof(Char) == 1) {
+          current_write += unibrow::Utf8::EncodeOneByte(
+              current_write, static_cast<uint8_t>(character));
+        } else {
+          current_write += unibrow::Utf8::Encode(
+              current_write, character, prev_char, replace_invalid_utf8);
+          prev_char = character;
+        }
         DCHECK(write_capacity == -1 ||
                (current_write - write_start) <= write_capacity);
       }
@@ -8724,6 +8717,15 @@ MaybeLocal<WasmModuleObject> WasmModuleObject::Compile(
 #endif  // V8_ENABLE_WEBASSEMBLY
 }
 
+// static
+bool WasmTrace::Flush() {
+#if V8_ENABLE_WEBASSEMBLY
+  return i::wasm::FlushWasmTraceBuffers();
+#else
+  return false;
+#endif  // V8_ENABLE_WEBASSEMBLY
+}
+
 void* v8::ArrayBuffer::Allocator::Reallocate(void* data, size_t old_length,
                                              size_t new_length) {
   if (old_length == new_length) return data;
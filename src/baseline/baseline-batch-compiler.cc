@@ -14,6 +14,7 @@
 #include "src/heap/heap-inl.h"
 #include "src/heap/local-heap-inl.h"
 #include "src/heap/parked-scope.h"
+#include "src/logging/counters.h"
 #include "src/objects/fixed-array-inl.h"
 #include "src/objects/js-function-inl.h"
 #include "src/utils/locked-queue-inl.h"
@@ -163,7 +164,13 @@ class ConcurrentBaselineCompiler {
         std::unique_ptr<BaselineBatchCompilerJob> job;
         if (!incoming_queue_->Dequeue(&job)) break;
         DCHECK_NOT_NULL(job);
-        job->Compile(&local_isolate);
+        base::TimeDelta time_taken;
+        {
+          base::ScopedTimer timer(&time_taken);
+          job->Compile(&local_isolate);
+        }
+        isolate_->counters()->sparkplug_batch_compile()->AddTimedSample(
+            time_taken);
         outgoing_queue_->Enqueue(std::move(job));
       }
       isolate_->stack_guard()->RequestInstallBaselineCode();
@@ -207,19 +214,47 @@ class ConcurrentBaselineCompiler {
   void CompileBatch(Handle<WeakFixedArray> task_queue, int batch_size) {
     DCHECK(v8_flags.concurrent_sparkplug);
     RCS_SCOPE(isolate_, RuntimeCallCounterId::kCompileBaseline);
-    incoming_queue_.Enqueue(std::make_unique<BaselineBatchCompilerJob>(
-        isolate_, task_queue, batch_size));
+    base::TimeDelta time_taken;
+    {
+      base::ScopedTimer timer(&time_taken);
+      incoming_queue_.Enqueue(std::make_unique<BaselineBatchCompilerJob>(
+          isolate_, task_queue, batch_size));
+    }
+    isolate_->counters()->sparkplug_batch_prepare()->AddTimedSample(
+        time_taken);
     job_handle_->NotifyConcurrencyIncrease();
   }
 
   void InstallBatch() {
+    // Installing is the only part of concurrent Sparkplug compilation that
+    // runs on the main thread. Bound the time spent per interrupt, and leave
+    // the remaining batches for the next one, so that a burst of finished
+    // batches on a large bundle doesn't cause a long pause. At least one batch
+    // is installed per interrupt, so that installation always makes progress.
+    const base::TimeDelta budget = base::TimeDelta::FromMicroseconds(
+        v8_flags.concurrent_sparkplug_install_budget_us);
+    base::ElapsedTimer timer;
+    timer.Start();
     while (!outgoing_queue_.IsEmpty()) {
       std::unique_ptr<BaselineBatchCompilerJob> job;
       outgoing_queue_.Dequeue(&job);
-      job->Install(isolate_);
+      base::TimeDelta time_taken;
+      {
+        base::ScopedTimer job_timer(&time_taken);
+        job->Install(isolate_);
+      }
+      isolate_->counters()->sparkplug_batch_install()->AddTimedSample(
+          time_taken);
+      if (!budget.IsZero() && timer.Elapsed() >= budget &&
+          !outgoing_queue_.IsEmpty()) {
+        isolate_->stack_guard()->RequestInstallBaselineCode();
+        break;
+      }
     }
   }
 
+  size_t NumBatchesToInstall() const { return outgoing_queue_.size(); }
+
  private:
   Isolate* isolate_;
   std::unique_ptr<JobHandle> job_handle_ = nullptr;
@@ -286,6 +321,11 @@ void BaselineBatchCompiler::InstallBatch() {
   concurrent_compiler_->InstallBatch();
 }
 
+size_t BaselineBatchCompiler::NumBatchesToInstallForTesting() const {
+  DCHECK(v8_flags.concurrent_sparkplug);
+  return concurrent_compiler_->NumBatchesToInstall();
+}
+
 void BaselineBatchCompiler::EnsureQueueCapacity() {
   if (compilation_queue_.is_null()) {
     compilation_queue_ = isolate_->global_handles()->Create(
@@ -32,6 +32,10 @@ class BaselineBatchCompiler {
 
   void InstallBatch();
 
+  // Returns the number of concurrently compiled batches which are waiting to
+  // be installed on the main thread.
+  size_t NumBatchesToInstallForTesting() const;
+
  private:
   // Ensure there is enough space in the compilation queue to enqueue another
   // function, growing the queue if necessary.
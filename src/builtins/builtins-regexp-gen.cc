@@ -511,6 +511,36 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
   GotoIf(TaggedIsSmi(var_code.value()), &runtime);
   TNode<Code> code = CAST(var_code.value());
 
+  // If every match contains a certain literal, scan for it first: without it
+  // there is no match, and otherwise matching can start close to it.
+  TVARIABLE(IntPtrT, var_last_index, int_last_index);
+  {
+    Label next(this);
+    TNode<Object> required_literal = UnsafeLoadFixedArrayElement(
+        data, JSRegExp::kIrregexpRequiredLiteralIndex);
+    GotoIf(TaggedIsSmi(required_literal), &next);
+
+    TNode<BoolT> is_one_byte =
+        IsOneByteStringInstanceType(to_direct.instance_type());
+    MachineType type_ptr = MachineType::Pointer();
+    TNode<IntPtrT> skip = UncheckedCast<IntPtrT>(CallCFunction(
+        ExternalConstant(ExternalReference::re_skip_to_required_literal()),
+        MachineType::IntPtr(), std::make_pair(MachineType::AnyTagged(), data),
+        std::make_pair(type_ptr, var_string_start.value()),
+        std::make_pair(type_ptr, var_string_end.value()),
+        std::make_pair(MachineType::Int32(), is_one_byte),
+        std::make_pair(type_ptr, isolate_address)));
+    GotoIf(IntPtrLessThan(skip, IntPtrConstant(0)), &if_failure);
+
+    TNode<IntPtrT> skip_bytes = Select<IntPtrT>(
+        is_one_byte, [=] { return skip; },
+        [=] { return WordShl(skip, IntPtrConstant(1)); });
+    var_last_index = IntPtrAdd(int_last_index, skip);
+    var_string_start = RawPtrAdd(var_string_start.value(), skip_bytes);
+    Goto(&next);
+    BIND(&next);
+  }
+
   Label if_success(this), if_exception(this, Label::kDeferred);
   {
     IncrementCounter(isolate()->counters()->regexp_entry_native(), 1);
@@ -530,7 +560,7 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
 
     // Argument 1: Previous index.
     MachineType arg1_type = type_int32;
-    TNode<Int32T> arg1 = TruncateIntPtrToInt32(int_last_index);
+    TNode<Int32T> arg1 = TruncateIntPtrToInt32(var_last_index.value());
 
     // Argument 2: Start of string data. This argument is ignored in the
     // interpreter.
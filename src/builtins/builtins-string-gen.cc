@@ -125,6 +125,21 @@ TNode<IntPtrT> StringBuiltinsAssembler::SearchOneByteInOneByteString(
       });
 }
 
+TNode<IntPtrT> StringBuiltinsAssembler::SearchStringInRope(
+    const TNode<ConsString> subject, const TNode<String> search,
+    const TNode<IntPtrT> start_position) {
+  const TNode<ExternalReference> function_addr =
+      ExternalConstant(ExternalReference::string_search_in_rope());
+  const TNode<ExternalReference> isolate_ptr =
+      ExternalConstant(ExternalReference::isolate_address(isolate()));
+  return UncheckedCast<IntPtrT>(
+      CallCFunction(function_addr, MachineType::IntPtr(),
+                    std::make_pair(MachineType::Pointer(), isolate_ptr),
+                    std::make_pair(MachineType::AnyTagged(), subject),
+                    std::make_pair(MachineType::AnyTagged(), search),
+                    std::make_pair(MachineType::IntPtr(), start_position)));
+}
+
 void StringBuiltinsAssembler::GenerateStringEqual(TNode<String> left,
                                                   TNode<String> right,
                                                   TNode<IntPtrT> length) {
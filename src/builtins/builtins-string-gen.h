@@ -88,6 +88,11 @@ class StringBuiltinsAssembler : public CodeStubAssembler {
   TNode<IntPtrT> SearchOneByteInOneByteString(
       const TNode<RawPtrT> subject_ptr, const TNode<IntPtrT> subject_length,
       const TNode<RawPtrT> search_ptr, const TNode<IntPtrT> start_position);
+  // Calls String::SearchInRope, which searches a long cons string without
+  // flattening it.
+  TNode<IntPtrT> SearchStringInRope(const TNode<ConsString> subject,
+                                    const TNode<String> search,
+                                    const TNode<IntPtrT> start_position);
 
  protected:
   enum class StringComparison {
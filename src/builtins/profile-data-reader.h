@@ -44,6 +44,9 @@ class ProfileDataFromFile {
   static const ProfileDataFromFile* TryRead(const char* name);
 
  protected:
+  // Computes hints from counters collected at runtime rather than from a file.
+  friend class BasicBlockProfiler;
+
   int hash_ = 0;
 
   // Branch hints, indicated by true or false to reflect the hinted result of
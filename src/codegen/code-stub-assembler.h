@@ -2953,6 +2953,11 @@ class V8_EXPORT_PRIVATE CodeStubAssembler
         ExternalReference::address_of_builtin_subclassing_flag());
   }
 
+  TNode<BoolT> HasCallTargetHistogramFlag() {
+    return LoadRuntimeFlag(
+        ExternalReference::address_of_call_target_histogram_flag());
+  }
+
   TNode<BoolT> HasSharedStringTableFlag() {
     return LoadRuntimeFlag(
         ExternalReference::address_of_shared_string_table_flag());
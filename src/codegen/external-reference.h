@@ -107,6 +107,7 @@ class StatsCounter;
   V(address_of_FLAG_harmony_regexp_unicode_sets,                               \
     "v8_flags.harmony_regexp_unicode_sets")                                    \
   V(address_of_builtin_subclassing_flag, "v8_flags.builtin_subclassing")       \
+  V(address_of_call_target_histogram_flag, "v8_flags.call_target_histogram")   \
   V(address_of_double_abs_constant, "double_absolute_constant")                \
   V(address_of_double_neg_constant, "double_negate_constant")                  \
   V(address_of_enable_experimental_regexp_engine,                              \
@@ -241,6 +242,7 @@ class StatsCounter;
   V(replace_unpaired_surrogates, "Utf16::ReplaceUnpairedSurrogates")           \
   V(try_string_to_index_or_lookup_existing,                                    \
     "try_string_to_index_or_lookup_existing")                                  \
+  V(string_search_in_rope, "String::SearchInRope")                             \
   V(string_from_forward_table, "string_from_forward_table")                    \
   V(raw_hash_from_forward_table, "raw_hash_from_forward_table")                \
   V(name_dictionary_lookup_forwarded_string,                                   \
@@ -308,6 +310,7 @@ class StatsCounter;
   IF_WASM(V, wasm_memory_fill, "wasm::memory_fill")                            \
   IF_WASM(V, wasm_array_copy, "wasm::array_copy")                              \
   IF_WASM(V, wasm_array_fill, "wasm::array_fill")                              \
+  IF_WASM(V, wasm_trace_event, "wasm::trace_event")                            \
   IF_WASM(V, wasm_string_to_f64, "wasm_string_to_f64")                         \
   IF_WASM(V, wasm_atomic_notify, "wasm_atomic_notify")                         \
   IF_WASM(V, wasm_WebAssemblyCompile, "wasm::WebAssemblyCompile")              \
@@ -411,6 +414,7 @@ class StatsCounter;
   V(re_match_for_call_from_js, "IrregexpInterpreter::MatchForCallFromJs")      \
   V(re_experimental_match_for_call_from_js,                                    \
     "ExperimentalRegExp::MatchForCallFromJs")                                  \
+  V(re_skip_to_required_literal, "RegExp::SkipToRequiredLiteral()")          \
   V(typed_array_and_rab_gsab_typed_array_elements_kind_shifts,                 \
     "TypedArrayAndRabGsabTypedArrayElementsKindShifts")                        \
   V(typed_array_and_rab_gsab_typed_array_elements_kind_sizes,                  \
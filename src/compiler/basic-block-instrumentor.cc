@@ -53,14 +53,18 @@ static const Operator* PointerConstant(CommonOperatorBuilder* common,
 
 BasicBlockProfilerData* BasicBlockInstrumentor::Instrument(
     OptimizedCompilationInfo* info, Graph* graph, Schedule* schedule,
-    Isolate* isolate) {
-  // Basic block profiling disables concurrent compilation, so handle deref is
-  // fine.
+    Isolate* isolate, BasicBlockProfilerData* data) {
+  // Basic block profiling disables concurrent compilation, and
+  // --turbo-profile-guided-layout instruments from within an unparked scope,
+  // so handle deref is fine.
   AllowHandleDereference allow_handle_dereference;
   // Skip the exit block in profiles, since the register allocator can't handle
   // it and entry into it means falling off the end of the function anyway.
   size_t n_blocks = schedule->RpoBlockCount();
-  BasicBlockProfilerData* data = BasicBlockProfiler::Get()->NewData(n_blocks);
+  if (data == nullptr) {
+    data = BasicBlockProfiler::Get()->NewData(n_blocks);
+  }
+  DCHECK_EQ(n_blocks, data->n_blocks());
   // Set the function name.
   data->SetFunctionName(info->GetDebugName());
   // Capture the schedule string before instrumentation.
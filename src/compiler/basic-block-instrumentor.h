@@ -20,9 +20,11 @@ class Schedule;
 
 class BasicBlockInstrumentor : public AllStatic {
  public:
-  static BasicBlockProfilerData* Instrument(OptimizedCompilationInfo* info,
-                                            Graph* graph, Schedule* schedule,
-                                            Isolate* isolate);
+  // Instruments the scheduled graph to increment the counters in {data}, or
+  // in a new BasicBlockProfilerData if {data} is nullptr.
+  static BasicBlockProfilerData* Instrument(
+      OptimizedCompilationInfo* info, Graph* graph, Schedule* schedule,
+      Isolate* isolate, BasicBlockProfilerData* data = nullptr);
 };
 
 // A profiler which works when reorder_builtins flag was set as true, it will
@@ -683,11 +683,25 @@ ProcessedFeedback const& JSHeapBroker::ReadFeedbackForCall(
   if (nexus.IsUninitialized()) return NewInsufficientFeedback(nexus.kind());
 
   OptionalHeapObjectRef target_ref;
+  ZoneVector<CallFeedback::PolymorphicTarget> polymorphic_targets(zone());
   {
     MaybeObject maybe_target = nexus.GetFeedback();
     Tagged<HeapObject> target_object;
     if (maybe_target.GetHeapObject(&target_object)) {
-      target_ref = TryMakeRef(this, target_object);
+      if (IsWeakFixedArray(target_object)) {
+        // A call target histogram, see --call-target-histogram.
+        std::vector<std::pair<Handle<JSFunction>, int>> targets;
+        nexus.ExtractCallTargetHistogram(&targets);
+        float const call_count = std::max(nexus.GetCallCount(), 1);
+        for (auto const& [function, count] : targets) {
+          OptionalJSFunctionRef function_ref = TryMakeRef(this, function);
+          if (!function_ref.has_value()) continue;
+          polymorphic_targets.push_back(
+              {function_ref.value(), std::min(count / call_count, 1.0f)});
+        }
+      } else {
+        target_ref = TryMakeRef(this, target_object);
+      }
     }
   }
 
@@ -695,7 +709,7 @@ ProcessedFeedback const& JSHeapBroker::ReadFeedbackForCall(
   SpeculationMode mode = nexus.GetSpeculationMode();
   CallFeedbackContent content = nexus.GetCallFeedbackContent();
   return *zone()->New<CallFeedback>(target_ref, frequency, mode, content,
-                                    nexus.kind());
+                                    nexus.kind(), polymorphic_targets);
 }
 
 BinaryOperationHint JSHeapBroker::GetFeedbackForBinaryOperation(
@@ -145,6 +145,33 @@ JSInliningHeuristic::Candidate JSInliningHeuristic::CollectFunctions(
     out.num_functions = 1;
     return out;
   }
+  if (v8_flags.call_target_histogram &&
+      node->opcode() == IrOpcode::kJSCall) {
+    // Speculate on the most frequent targets of a polymorphic call site.
+    FeedbackSource const& feedback = CallParametersOf(node->op()).feedback();
+    if (feedback.IsValid()) {
+      ProcessedFeedback const& processed =
+          broker()->GetFeedbackForCall(feedback);
+      if (processed.kind() == ProcessedFeedback::kCall) {
+        int n = 0;
+        for (auto const& target : processed.AsCall().polymorphic_targets()) {
+          if (n == functions_size) break;
+          if (target.share < v8_flags.min_call_target_share) break;
+          out.functions[n] = target.function;
+          if (CanConsiderForInlining(broker(), target.function)) {
+            out.bytecode[n] =
+                target.function.shared(broker()).GetBytecodeArray(broker());
+          }
+          ++n;
+        }
+        if (n > 0) {
+          out.num_functions = n;
+          out.has_generic_fallback = true;
+          return out;
+        }
+      }
+    }
+  }
   out.num_functions = 0;
   return out;
 }
@@ -173,7 +200,8 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   Candidate candidate = CollectFunctions(node, kMaxCallPolymorphism);
   if (candidate.num_functions == 0) {
     return NoChange();
-  } else if (candidate.num_functions > 1 && !v8_flags.polymorphic_inlining) {
+  } else if ((candidate.num_functions > 1 || candidate.has_generic_fallback) &&
+             !v8_flags.polymorphic_inlining) {
     TRACE("Not considering call site #"
           << node->id() << ":" << node->op()->mnemonic()
           << ", because polymorphic inlining is disabled");
@@ -652,7 +680,8 @@ void JSInliningHeuristic::CreateOrReuseDispatch(
     Node** calls, Node** inputs, int input_count, int* num_calls) {
   SourcePositionTable::Scope position(
       source_positions_, source_positions_->GetSourcePosition(node));
-  if (TryReuseDispatch(node, callee, if_successes, calls, inputs, input_count,
+  if (!candidate.has_generic_fallback &&
+      TryReuseDispatch(node, callee, if_successes, calls, inputs, input_count,
                        num_calls)) {
     return;
   }
@@ -660,19 +689,28 @@ void JSInliningHeuristic::CreateOrReuseDispatch(
   static_assert(JSCallOrConstructNode::kHaveIdenticalLayouts);
 
   Node* fallthrough_control = NodeProperties::GetControlInput(node);
-  *num_calls = candidate.num_functions;
+  *num_calls =
+      candidate.num_functions + (candidate.has_generic_fallback ? 1 : 0);
 
   // Create the appropriate control flow to dispatch to the cloned calls.
   for (int i = 0; i < *num_calls; ++i) {
     // TODO(2206): Make comparison be based on underlying SharedFunctionInfo
     // instead of the target JSFunction reference directly.
+    // The generic fallback call (if any) keeps the original {callee}.
     Node* target =
-        jsgraph()->ConstantNoHole(candidate.functions[i].value(), broker());
+        i < candidate.num_functions
+            ? jsgraph()->ConstantNoHole(candidate.functions[i].value(),
+                                        broker())
+            : callee;
     if (i != (*num_calls - 1)) {
       Node* check =
           graph()->NewNode(simplified()->ReferenceEqual(), callee, target);
-      Node* branch =
-          graph()->NewNode(common()->Branch(), check, fallthrough_control);
+      // Keep the generic fallback call out of line.
+      BranchHint hint = i == *num_calls - 2 && candidate.has_generic_fallback
+                            ? BranchHint::kTrue
+                            : BranchHint::kNone;
+      Node* branch = graph()->NewNode(common()->Branch(hint), check,
+                                      fallthrough_control);
       fallthrough_control = graph()->NewNode(common()->IfFalse(), branch);
       if_successes[i] = graph()->NewNode(common()->IfTrue(), branch);
     } else {
@@ -706,7 +744,7 @@ Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate,
 #if V8_ENABLE_WEBASSEMBLY
   DCHECK_NE(node->opcode(), IrOpcode::kJSWasmCall);
 #endif  // V8_ENABLE_WEBASSEMBLY
-  if (num_calls == 1) {
+  if (num_calls == 1 && !candidate.has_generic_fallback) {
     Reduction const reduction = inliner_.ReduceJSCall(node);
     if (reduction.Changed()) {
       total_inlined_bytecode_size_ += candidate.bytecode[0].value().length();
@@ -715,10 +753,10 @@ Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate,
   }
 
   // Expand the JSCall/JSConstruct node to a subgraph first if
-  // we have multiple known target functions.
-  DCHECK_LT(1, num_calls);
-  Node* calls[kMaxCallPolymorphism + 1];
-  Node* if_successes[kMaxCallPolymorphism];
+  // we have multiple known target functions, or a generic fallback.
+  DCHECK(num_calls > 1 || candidate.has_generic_fallback);
+  Node* calls[kMaxCallPolymorphism + 2];
+  Node* if_successes[kMaxCallPolymorphism + 1];
   Node* callee = NodeProperties::GetValueInput(node, 0);
 
   // Setup the inputs for the cloned call nodes.
@@ -735,7 +773,7 @@ Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate,
   // Check if we have an exception projection for the call {node}.
   Node* if_exception = nullptr;
   if (NodeProperties::IsExceptionalCall(node, &if_exception)) {
-    Node* if_exceptions[kMaxCallPolymorphism + 1];
+    Node* if_exceptions[kMaxCallPolymorphism + 2];
     for (int i = 0; i < num_calls; ++i) {
       if_successes[i] = graph()->NewNode(common()->IfSuccess(), calls[i]);
       if_exceptions[i] =
@@ -766,9 +804,16 @@ Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate,
                        num_calls + 1, calls);
   ReplaceWithValue(node, value, effect, control);
 
+  // The generic fallback call has the same feedback as the original call
+  // {node}, so make sure we don't expand it again.
+  if (candidate.has_generic_fallback) {
+    seen_.insert(calls[num_calls - 1]->id());
+  }
+
   // Inline the individual, cloned call sites.
-  for (int i = 0; i < num_calls && total_inlined_bytecode_size_ <
-                                       max_inlined_bytecode_size_absolute_;
+  for (int i = 0;
+       i < candidate.num_functions &&
+       total_inlined_bytecode_size_ < max_inlined_bytecode_size_absolute_;
        ++i) {
     if (candidate.can_inline_function[i] &&
         (small_function || total_inlined_bytecode_size_ <
@@ -814,7 +859,9 @@ void JSInliningHeuristic::PrintCandidates() {
   for (const Candidate& candidate : candidates_) {
     os << "- candidate: " << candidate.node->op()->mnemonic() << " node #"
        << candidate.node->id() << " with frequency " << candidate.frequency
-       << ", " << candidate.num_functions << " target(s):" << std::endl;
+       << ", " << candidate.num_functions << " target(s)"
+       << (candidate.has_generic_fallback ? " and generic fallback" : "")
+       << ":" << std::endl;
     for (int i = 0; i < candidate.num_functions; ++i) {
       SharedFunctionInfoRef shared =
           candidate.functions[i].has_value()
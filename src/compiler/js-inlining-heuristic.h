@@ -74,6 +74,9 @@ class JSInliningHeuristic final : public AdvancedReducer {
     // we use {num_functions == 1 && functions[0].is_null()} as an indicator.
     OptionalSharedFunctionInfoRef shared_info;
     int num_functions;
+    // Whether the {functions} come from a call target histogram, in which
+    // case the dispatch falls back to a generic call for all other targets.
+    bool has_generic_fallback = false;
     Node* node = nullptr;     // The call site at which to inline.
     CallFrequency frequency;  // Relative frequency of this call site.
     int total_size = 0;
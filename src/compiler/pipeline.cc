@@ -637,6 +637,13 @@ class PipelineData {
     profile_data_ = profile_data;
   }
 
+  // The hash of the graph before scheduling, if the generated code should be
+  // instrumented to collect block counts for --turbo-profile-guided-layout.
+  base::Optional<int> layout_profiling_hash() const {
+    return layout_profiling_hash_;
+  }
+  void set_layout_profiling_hash(int hash) { layout_profiling_hash_ = hash; }
+
   // RuntimeCallStats that is only available during job execution but not
   // finalization.
   // TODO(delphick): Currently even during execution this can be nullptr, due to
@@ -742,6 +749,7 @@ class PipelineData {
 
   RuntimeCallStats* runtime_call_stats_ = nullptr;
   const ProfileDataFromFile* profile_data_ = nullptr;
+  base::Optional<int> layout_profiling_hash_;
 
   bool has_js_wasm_calls_ = false;
   bool inline_wasm_into_js_ = false;
@@ -2920,6 +2928,18 @@ bool PipelineImpl::CreateGraph() {
   return true;
 }
 
+namespace {
+int HashGraphForPGO(Graph* graph);
+
+size_t CountDeferredBlocks(Schedule* schedule) {
+  size_t deferred_blocks = 0;
+  for (BasicBlock* block : *schedule->rpo_order()) {
+    if (block->deferred()) ++deferred_blocks;
+  }
+  return deferred_blocks;
+}
+}  // namespace
+
 bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   PipelineData* data = this->data_;
 
@@ -3061,8 +3081,33 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
     data->node_origins()->RemoveDecorator();
   }
 
+  if (v8_flags.turbo_profile_guided_layout && info()->has_shared_info()) {
+    DCHECK(!v8_flags.turboshaft);
+    // Block ids are deterministic for a given graph, so block counts collected
+    // by earlier code generated from an identical graph can be used to defer
+    // the cold successors of branches. Otherwise, instrument this code so that
+    // the next optimization of the function can use its counts.
+    UnparkedScopeIfNeeded scope(data->broker());
+    AllowHandleDereference allow_deref;
+    int hash = HashGraphForPGO(data->graph());
+    if (const ProfileDataFromFile* profile_data =
+            BasicBlockProfiler::Get()->GetRuntimeProfileData(
+                *info()->shared_info(), hash)) {
+      data->set_profile_data(profile_data);
+    } else {
+      data->set_layout_profiling_hash(hash);
+    }
+  }
+
   ComputeScheduledGraph();
 
+  if (v8_flags.turbo_profile_guided_layout && data->profile_data()) {
+    UnparkedScopeIfNeeded scope(data->broker());
+    AllowHandleDereference allow_deref;
+    BasicBlockProfiler::Get()->RecordLayout(
+        *info()->shared_info(), CountDeferredBlocks(data->schedule()));
+  }
+
   if (v8_flags.turboshaft) {
     UnparkedScopeIfNeeded scope(data->broker(),
                                 v8_flags.turboshaft_trace_reduction);
@@ -4073,7 +4118,22 @@ bool PipelineImpl::SelectInstructions(Linkage* linkage) {
     BasicBlockCallGraphProfiler::StoreCallGraph(info(), data->schedule());
   }
 
-  if (v8_flags.turbo_profiling) {
+  if (data->layout_profiling_hash().has_value()) {
+    // The counters are owned by the function's layout profile, so they are
+    // not handed to the generated code object.
+    UnparkedScopeIfNeeded unparked_scope(data->broker());
+    AllowHandleDereference allow_deref;
+    if (BasicBlockProfilerData* profiler_data =
+            BasicBlockProfiler::Get()->NewLayoutProfilingData(
+                *info()->shared_info(), data->schedule()->RpoBlockCount(),
+                *data->layout_profiling_hash())) {
+      BasicBlockProfiler::Get()->RecordLayout(
+          *info()->shared_info(), CountDeferredBlocks(data->schedule()));
+      BasicBlockInstrumentor::Instrument(info(), data->graph(),
+                                         data->schedule(), data->isolate(),
+                                         profiler_data);
+    }
+  } else if (v8_flags.turbo_profiling) {
     UnparkedScopeIfNeeded unparked_scope(data->broker());
     data->info()->set_profiler_data(BasicBlockInstrumentor::Instrument(
         info(), data->graph(), data->schedule(), data->isolate()));
@@ -184,25 +184,39 @@ class MegaDOMPropertyAccessFeedback : public ProcessedFeedback {
 
 class CallFeedback : public ProcessedFeedback {
  public:
+  // A target from the call target histogram of a polymorphic call site (see
+  // --call-target-histogram), with the share of calls that went to it.
+  struct PolymorphicTarget {
+    JSFunctionRef function;
+    float share;
+  };
+
   CallFeedback(OptionalHeapObjectRef target, float frequency,
                SpeculationMode mode, CallFeedbackContent call_feedback_content,
-               FeedbackSlotKind slot_kind)
+               FeedbackSlotKind slot_kind,
+               ZoneVector<PolymorphicTarget> const& polymorphic_targets)
       : ProcessedFeedback(kCall, slot_kind),
         target_(target),
         frequency_(frequency),
         mode_(mode),
-        content_(call_feedback_content) {}
+        content_(call_feedback_content),
+        polymorphic_targets_(polymorphic_targets) {}
 
   OptionalHeapObjectRef target() const { return target_; }
   float frequency() const { return frequency_; }
   SpeculationMode speculation_mode() const { return mode_; }
   CallFeedbackContent call_feedback_content() const { return content_; }
+  // Ordered by descending share.
+  ZoneVector<PolymorphicTarget> const& polymorphic_targets() const {
+    return polymorphic_targets_;
+  }
 
  private:
   OptionalHeapObjectRef const target_;
   float const frequency_;
   SpeculationMode const mode_;
   CallFeedbackContent const content_;
+  ZoneVector<PolymorphicTarget> const polymorphic_targets_;
 };
 
 template <class T, ProcessedFeedback::Kind K>
@@ -3688,13 +3688,52 @@ const Operator* WasmGraphBuilder::GetSafeStoreOperator(int offset,
   return mcgraph()->machine()->UnalignedStore(store_rep);
 }
 
+void WasmGraphBuilder::MarkExecutedForCodeFlushing(
+    uint32_t declared_func_index) {
+  // The tiering budget is unused while TurboFan code is installed; any
+  // non-zero value tells {NativeModule::AgeTurbofanCode} that the function
+  // executed.
+  Node* budget_array =
+      LOAD_INSTANCE_FIELD(TieringBudgetArray, MachineType::Pointer());
+  gasm_->Store(
+      StoreRepresentation(MachineRepresentation::kWord32, kNoWriteBarrier),
+      budget_array,
+      gasm_->IntPtrConstant(declared_func_index * kInt32Size),
+      Int32Constant(1));
+}
+
+void WasmGraphBuilder::BuildTraceEvent(wasm::WasmTraceRecordKind kind,
+                                       wasm::WasmCodePosition position,
+                                       Node* offset, MachineRepresentation rep,
+                                       bool is_store) {
+  uint32_t event = wasm::EncodeWasmTraceEvent(
+      kind, wasm::ExecutionTier::kTurbofan, rep, is_store);
+  Node* function =
+      gasm_->ExternalConstant(ExternalReference::wasm_trace_event());
+  auto sig = FixedSizeSignature<MachineType>::Params(
+      MachineType::Uint32(), MachineType::Int32(), MachineType::Int32(),
+      MachineType::Pointer());
+  BuildCCall(&sig, function, Int32Constant(static_cast<int32_t>(event)),
+             Int32Constant(func_index_), Int32Constant(position), offset);
+}
+
 void WasmGraphBuilder::TraceFunctionEntry(wasm::WasmCodePosition position) {
+  if (v8_flags.wasm_trace_file.value() != nullptr) {
+    BuildTraceEvent(wasm::WasmTraceRecordKind::kFunctionEntry, position,
+                    gasm_->UintPtrConstant(0));
+    return;
+  }
   Node* call = BuildCallToRuntime(Runtime::kWasmTraceEnter, nullptr, 0);
   SetSourcePosition(call, position);
 }
 
 void WasmGraphBuilder::TraceFunctionExit(base::Vector<Node*> vals,
                                          wasm::WasmCodePosition position) {
+  if (v8_flags.wasm_trace_file.value() != nullptr) {
+    BuildTraceEvent(wasm::WasmTraceRecordKind::kFunctionExit, position,
+                    gasm_->UintPtrConstant(0));
+    return;
+  }
   Node* info = gasm_->IntPtrConstant(0);
   size_t num_returns = vals.size();
   if (num_returns == 1) {
@@ -3715,11 +3754,17 @@ void WasmGraphBuilder::TraceMemoryOperation(bool is_store,
                                             MachineRepresentation rep,
                                             Node* index, uintptr_t offset,
                                             wasm::WasmCodePosition position) {
+  Node* effective_offset = gasm_->IntAdd(gasm_->UintPtrConstant(offset), index);
+  if (v8_flags.wasm_trace_file.value() != nullptr) {
+    BuildTraceEvent(wasm::WasmTraceRecordKind::kMemoryAccess, position,
+                    effective_offset, rep, is_store);
+    return;
+  }
+
   int kAlign = 4;  // Ensure that the LSB is 0, such that this looks like a Smi.
   TNode<RawPtrT> info =
       gasm_->StackSlot(sizeof(wasm::MemoryTracingInfo), kAlign);
 
-  Node* effective_offset = gasm_->IntAdd(gasm_->UintPtrConstant(offset), index);
   auto store = [&](int field_offset, MachineRepresentation rep, Node* data) {
     gasm_->Store(StoreRepresentation(rep, kNoWriteBarrier), info,
                  Int32Constant(field_offset), data);
@@ -5282,14 +5327,81 @@ void WasmGraphBuilder::MemTypeToUintPtrOrOOBTrap(
   TrapIfTrue(wasm::kTrapMemOutOfBounds, any_high_word, position);
 }
 
+namespace {
+// Bulk memory operations with a constant size of at most this many bytes are
+// executed inline instead of calling out to C.
+constexpr uint64_t kMaxInlineBulkMemorySize = 16;
+
+// Returns the size of a bulk memory operation if it is small and constant,
+// and 0 otherwise.
+uint8_t InlineBulkMemorySize(bool is_memory64, Node* size) {
+  uint64_t value;
+  if (is_memory64) {
+    Uint64Matcher match(size);
+    if (!match.HasResolvedValue()) return 0;
+    value = match.ResolvedValue();
+  } else {
+    Uint32Matcher match(size);
+    if (!match.HasResolvedValue()) return 0;
+    value = match.ResolvedValue();
+  }
+  return value <= kMaxInlineBulkMemorySize ? static_cast<uint8_t>(value) : 0;
+}
+
+// The widest machine type to use for the next {remaining} bytes of an inline
+// bulk memory operation.
+MachineType InlineBulkMemoryChunkType(uint8_t remaining) {
+  if (remaining >= 8 && kSystemPointerSize == kInt64Size) {
+    return MachineType::Uint64();
+  }
+  if (remaining >= 4) return MachineType::Uint32();
+  if (remaining >= 2) return MachineType::Uint16();
+  return MachineType::Uint8();
+}
+}  // namespace
+
 void WasmGraphBuilder::MemoryCopy(const wasm::WasmMemory* dst_memory,
                                   const wasm::WasmMemory* src_memory, Node* dst,
                                   Node* src, Node* size,
                                   wasm::WasmCodePosition position) {
+  DCHECK_EQ(dst_memory->is_memory64, src_memory->is_memory64);
+  if (uint8_t inline_size =
+          InlineBulkMemorySize(dst_memory->is_memory64, size)) {
+    // Both ranges are checked explicitly, and all bytes are loaded before the
+    // first store, such that nothing is written if the copy traps, and
+    // overlapping ranges are handled correctly.
+    Node* src_index =
+        BoundsCheckMem(src_memory, inline_size, src, 0, position,
+                       EnforceBoundsCheck::kNeedsBoundsCheck)
+            .first;
+    Node* dst_index =
+        BoundsCheckMem(dst_memory, inline_size, dst, 0, position,
+                       EnforceBoundsCheck::kNeedsBoundsCheck)
+            .first;
+    Node* src_start = MemBuffer(src_memory->index, 0);
+    Node* dst_start = MemBuffer(dst_memory->index, 0);
+    base::SmallVector<std::pair<MachineType, Node*>, 4> chunks;
+    for (uint8_t offset = 0; offset < inline_size;) {
+      MachineType type = InlineBulkMemoryChunkType(inline_size - offset);
+      chunks.emplace_back(
+          type, gasm_->LoadUnaligned(
+                    type, src_start,
+                    gasm_->IntAdd(src_index, gasm_->UintPtrConstant(offset))));
+      offset += ElementSizeInBytes(type.representation());
+    }
+    uint8_t offset = 0;
+    for (auto [type, value] : chunks) {
+      gasm_->StoreUnaligned(
+          type.representation(), dst_start,
+          gasm_->IntAdd(dst_index, gasm_->UintPtrConstant(offset)), value);
+      offset += ElementSizeInBytes(type.representation());
+    }
+    return;
+  }
+
   Node* function =
       gasm_->ExternalConstant(ExternalReference::wasm_memory_copy());
 
-  DCHECK_EQ(dst_memory->is_memory64, src_memory->is_memory64);
   MemTypeToUintPtrOrOOBTrap(dst_memory->is_memory64, {&dst, &src, &size},
                             position);
 
@@ -5312,6 +5424,36 @@ void WasmGraphBuilder::MemoryCopy(const wasm::WasmMemory* dst_memory,
 void WasmGraphBuilder::MemoryFill(const wasm::WasmMemory* memory, Node* dst,
                                   Node* value, Node* size,
                                   wasm::WasmCodePosition position) {
+  if (uint8_t inline_size = InlineBulkMemorySize(memory->is_memory64, size)) {
+    Node* index = BoundsCheckMem(memory, inline_size, dst, 0, position,
+                                 EnforceBoundsCheck::kNeedsBoundsCheck)
+                      .first;
+    Node* mem_start = MemBuffer(memory->index, 0);
+    // Replicate the fill byte into all bytes of a word. Narrower stores only
+    // use the lower bytes.
+    Node* pattern32 =
+        gasm_->Int32Mul(gasm_->Word32And(value, Int32Constant(0xff)),
+                        Int32Constant(0x01010101));
+    Node* pattern64 = nullptr;
+    for (uint8_t offset = 0; offset < inline_size;) {
+      MachineType type = InlineBulkMemoryChunkType(inline_size - offset);
+      Node* pattern = pattern32;
+      if (type.representation() == MachineRepresentation::kWord64) {
+        if (pattern64 == nullptr) {
+          Node* low = gasm_->ChangeUint32ToUint64(pattern32);
+          pattern64 = gasm_->Word64Or(
+              gasm_->Word64Shl(low, Int32Constant(32)), low);
+        }
+        pattern = pattern64;
+      }
+      gasm_->StoreUnaligned(
+          type.representation(), mem_start,
+          gasm_->IntAdd(index, gasm_->UintPtrConstant(offset)), pattern);
+      offset += ElementSizeInBytes(type.representation());
+    }
+    return;
+  }
+
   Node* function =
       gasm_->ExternalConstant(ExternalReference::wasm_memory_fill());
 
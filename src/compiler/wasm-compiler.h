@@ -60,6 +60,7 @@ class WasmCode;
 class WireBytesStorage;
 enum class LoadTransformationKind : uint8_t;
 enum Suspend : bool;
+enum class WasmTraceRecordKind : uint8_t;
 }  // namespace wasm
 
 namespace compiler {
@@ -292,6 +293,8 @@ class WasmGraphBuilder {
   }
 
   void TraceFunctionEntry(wasm::WasmCodePosition position);
+  // Marks the function as executed for code aging (--wasm-code-flushing).
+  void MarkExecutedForCodeFlushing(uint32_t declared_func_index);
   void TraceFunctionExit(base::Vector<Node*> vals,
                          wasm::WasmCodePosition position);
 
@@ -616,6 +619,9 @@ class WasmGraphBuilder {
     inlining_id_ = inlining_id;
   }
 
+  // The function index recorded in --wasm-trace-file events.
+  void set_func_index(int func_index) { func_index_ = func_index; }
+
   bool has_cached_memory() const {
     return cached_memory_index_ != kNoCachedMemoryIndex;
   }
@@ -673,6 +679,11 @@ class WasmGraphBuilder {
 
   template <typename... Args>
   Node* BuildCCall(MachineSignature* sig, Node* function, Args... args);
+  // Records an event of the binary trace of --wasm-trace-file.
+  void BuildTraceEvent(
+      wasm::WasmTraceRecordKind kind, wasm::WasmCodePosition position,
+      Node* offset, MachineRepresentation rep = MachineRepresentation::kNone,
+      bool is_store = false);
   Node* BuildCallNode(const wasm::FunctionSig* sig, base::Vector<Node*> args,
                       wasm::WasmCodePosition position, Node* instance_node,
                       const Operator* op, Node* frame_state = nullptr);
@@ -885,6 +896,7 @@ class WasmGraphBuilder {
 
   compiler::SourcePositionTable* const source_position_table_ = nullptr;
   int inlining_id_ = -1;
+  int func_index_ = -1;
   Parameter0Mode parameter_mode_;
   Isolate* const isolate_;
   SetOncePointer<Node> instance_node_;
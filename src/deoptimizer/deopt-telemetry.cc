@@ -0,0 +1,166 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/deoptimizer/deopt-telemetry.h"
+
+#include <algorithm>
+
+#include "src/codegen/compiler.h"
+#include "src/diagnostics/code-tracer.h"
+#include "src/execution/isolate.h"
+#include "src/logging/metrics.h"
+#include "src/objects/js-function-inl.h"
+#include "src/objects/script-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+
+namespace v8 {
+namespace internal {
+
+// static
+bool DeoptTelemetry::KeyFor(Tagged<SharedFunctionInfo> shared, Key* key) {
+  if (!IsScript(shared->script())) return false;
+  *key = {Script::cast(shared->script())->id(), shared->function_literal_id()};
+  return true;
+}
+
+DeoptTelemetry::Entry* DeoptTelemetry::Lookup(
+    Tagged<SharedFunctionInfo> shared) {
+  Key key;
+  if (!KeyFor(shared, &key)) return nullptr;
+  auto it = entries_.find(key);
+  return it == entries_.end() ? nullptr : &it->second;
+}
+
+// static
+int DeoptTelemetry::BackoffExponent(const Entry& entry) {
+  if (!IsUnstable(entry)) return 0;
+  return std::min(entry.deopt_count - v8_flags.deopt_storm_threshold + 1,
+                  v8_flags.deopt_storm_max_backoff.value());
+}
+
+void DeoptTelemetry::RecordDeopt(Tagged<JSFunction> function,
+                                 CodeKind code_kind, DeoptimizeReason reason,
+                                 BytecodeOffset bytecode_offset) {
+  Tagged<SharedFunctionInfo> shared = function->shared();
+  Key key;
+  if (!KeyFor(shared, &key)) return;
+  if (entries_.size() >= kMaxEntries && entries_.count(key) == 0) {
+    EvictLeastRecentlyDeoptimized();
+  }
+  Entry& entry = entries_[key];
+  entry.last_deopt = ++deopt_sequence_;
+  entry.stable_ticks = 0;
+  entry.history.Push({reason, code_kind, bytecode_offset.ToInt(),
+                      entry.ic_changes_since_last_deopt});
+  const int map_churn = entry.ic_changes_since_last_deopt;
+  entry.ic_changes_since_last_deopt = 0;
+  ++entry.deopt_count;
+  if (code_kind == CodeKind::TURBOFAN) ++entry.turbofan_deopt_count;
+
+  if (!IsUnstable(entry)) return;
+
+  const int backoff = BackoffExponent(entry);
+  const bool limited_to_maglev = ShouldLimitToMaglev(shared);
+  if (V8_UNLIKELY(v8_flags.trace_deopt_storm)) {
+    CodeTracer::Scope scope(isolate_->GetCodeTracer());
+    PrintF(scope.file(), "[deopt storm: ");
+    ShortPrint(function, scope.file());
+    PrintF(scope.file(),
+           " deopted %d times (last: %s at bytecode offset %d, map churn %d), "
+           "backoff 2^%d%s]\n",
+           entry.deopt_count, DeoptimizeReasonToString(reason),
+           bytecode_offset.ToInt(), map_churn, backoff,
+           limited_to_maglev ? ", limited to maglev" : "");
+    PrintHistory(entry, scope.file());
+  }
+
+  v8::metrics::DeoptimizationStorm event;
+  event.reason = DeoptimizeReasonToString(reason);
+  event.bytecode_offset = bytecode_offset.ToInt();
+  event.deopt_count = entry.deopt_count;
+  event.map_churn = map_churn;
+  event.backoff_exponent = backoff;
+  event.limited_to_maglev = limited_to_maglev;
+  isolate_->metrics_recorder()->DelayMainThreadEvent(
+      event, isolate_->GetOrRegisterRecorderContextId(
+                 handle(function->native_context(), isolate_)));
+}
+
+// static
+void DeoptTelemetry::PrintHistory(const Entry& entry, FILE* file) {
+  // Prints the most recent deopt first.
+  entry.history.Reduce(
+      [file](Record unused, const Record& record) {
+        PrintF(file, "  %s deopt: %s at bytecode offset %d, map churn %d\n",
+               CodeKindToString(record.code_kind),
+               DeoptimizeReasonToString(record.reason),
+               record.bytecode_offset, record.map_churn);
+        return unused;
+      },
+      Record());
+}
+
+int DeoptTelemetry::BackoffExponent(Tagged<SharedFunctionInfo> shared) {
+  if (V8_LIKELY(entries_.empty())) return 0;
+  Entry* entry = Lookup(shared);
+  return entry == nullptr ? 0 : BackoffExponent(*entry);
+}
+
+namespace {
+
+bool CanCompileWithMaglev(Tagged<SharedFunctionInfo> shared) {
+  return maglev::IsMaglevEnabled() &&
+         shared->PassesFilter(v8_flags.maglev_filter) &&
+         !shared->maglev_compilation_failed();
+}
+
+}  // namespace
+
+bool DeoptTelemetry::ShouldLimitToMaglev(Tagged<SharedFunctionInfo> shared) {
+  if (V8_LIKELY(entries_.empty())) return false;
+  if (!CanCompileWithMaglev(shared)) return false;
+  Entry* entry = Lookup(shared);
+  return entry != nullptr && IsLimitedToMaglev(*entry);
+}
+
+bool DeoptTelemetry::ShouldLimitToMaglevOnTick(
+    Tagged<SharedFunctionInfo> shared) {
+  if (V8_LIKELY(entries_.empty())) return false;
+  if (!CanCompileWithMaglev(shared)) return false;
+  Key key;
+  if (!KeyFor(shared, &key)) return false;
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return false;
+  Entry& entry = it->second;
+  if (!IsLimitedToMaglev(entry)) return false;
+  if (++entry.stable_ticks < v8_flags.deopt_storm_decay_ticks) return true;
+
+  // The feedback has been stable for a while, give TurboFan another chance
+  // once the counts have decayed below the threshold.
+  entry.stable_ticks = 0;
+  entry.deopt_count /= 2;
+  entry.turbofan_deopt_count /= 2;
+  if (V8_UNLIKELY(v8_flags.trace_deopt_storm)) {
+    CodeTracer::Scope scope(isolate_->GetCodeTracer());
+    PrintF(scope.file(), "[deopt storm: decayed %s to %d deopts]\n",
+           shared->DebugNameCStr().get(), entry.deopt_count);
+  }
+  if (entry.deopt_count == 0) {
+    entries_.erase(it);
+    return false;
+  }
+  return IsLimitedToMaglev(entry);
+}
+
+void DeoptTelemetry::EvictLeastRecentlyDeoptimized() {
+  DCHECK(!entries_.empty());
+  auto victim = std::min_element(
+      entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+        return a.second.last_deopt < b.second.last_deopt;
+      });
+  entries_.erase(victim);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,129 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_DEOPTIMIZER_DEOPT_TELEMETRY_H_
+#define V8_DEOPTIMIZER_DEOPT_TELEMETRY_H_
+
+#include <unordered_map>
+#include <utility>
+
+#include "src/base/functional.h"
+#include "src/base/ring-buffer.h"
+#include "src/deoptimizer/deoptimize-reason.h"
+#include "src/flags/flags.h"
+#include "src/objects/code-kind.h"
+#include "src/objects/tagged.h"
+#include "src/utils/utils.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class JSFunction;
+class SharedFunctionInfo;
+
+// Records how often the optimized code of a function deoptimized, in order to
+// detect functions that deoptimize and reoptimize repeatedly ("deopt storms"),
+// e.g. when the polymorphism of a call site keeps changing. The
+// TieringManager consults this to back off from reoptimizing such functions
+// (see --deopt-storm-backoff).
+//
+// The deopt counts decay: once the feedback of an unstable function has not
+// changed for --deopt-storm-decay-ticks interrupt ticks, they are halved, and
+// the entry is dropped when they reach zero.
+//
+// Each entry keeps the kHistorySize most recent deopts of its function, which
+// --trace-deopt-storm prints when the function is considered unstable.
+//
+// Entries are keyed by script id and function literal id, which are stable
+// across GCs, so no weak handling of SharedFunctionInfos is necessary. Only
+// functions that deoptimized at least once get an entry, and at most
+// kMaxEntries are kept; the entry that deoptimized least recently is evicted
+// first.
+class DeoptTelemetry final {
+ public:
+  static constexpr size_t kMaxEntries = 1024;
+  static constexpr uint8_t kHistorySize = 8;
+
+  struct Record {
+    DeoptimizeReason reason = DeoptimizeReason::kUnknown;
+    CodeKind code_kind = CodeKind::TURBOFAN;
+    int bytecode_offset = -1;
+    // Number of IC state changes between the previous deopt and this one.
+    int map_churn = 0;
+  };
+
+  struct Entry {
+    int deopt_count = 0;
+    int turbofan_deopt_count = 0;
+    int ic_changes_since_last_deopt = 0;
+    // Interrupt ticks without IC changes while the function was limited to
+    // Maglev.
+    int stable_ticks = 0;
+    // Sequence number of the last deopt, used for eviction.
+    uint64_t last_deopt = 0;
+    base::RingBuffer<Record, kHistorySize> history;
+  };
+
+  explicit DeoptTelemetry(Isolate* isolate) : isolate_(isolate) {}
+  DeoptTelemetry(const DeoptTelemetry&) = delete;
+  DeoptTelemetry& operator=(const DeoptTelemetry&) = delete;
+
+  // Called on the main thread after optimized code of {function} has been
+  // invalidated by an eager deopt.
+  void RecordDeopt(Tagged<JSFunction> function, CodeKind code_kind,
+                   DeoptimizeReason reason, BytecodeOffset bytecode_offset);
+
+  // Called whenever the IC state of one of the function's feedback slots
+  // changes. Only counted for functions that have deoptimized before.
+  void RecordICChange(Tagged<SharedFunctionInfo> shared) {
+    if (V8_LIKELY(entries_.empty())) return;
+    if (Entry* entry = Lookup(shared)) {
+      ++entry->ic_changes_since_last_deopt;
+      entry->stable_ticks = 0;
+    }
+  }
+
+  // Returns the exponent by which the interrupt budget for the next
+  // optimization of {shared} is scaled (as a power of 2), or 0 if the
+  // function is stable.
+  int BackoffExponent(Tagged<SharedFunctionInfo> shared);
+
+  // Whether {shared} should stay in Maglev rather than tier up to TurboFan.
+  // Always false if {shared} cannot be compiled with Maglev.
+  bool ShouldLimitToMaglev(Tagged<SharedFunctionInfo> shared);
+
+  // Called on each interrupt tick at which {shared}, running Maglev code,
+  // would otherwise tier up to TurboFan. Decays the deopt counts once the
+  // feedback has been stable for long enough, and returns whether the
+  // function should still stay in Maglev.
+  bool ShouldLimitToMaglevOnTick(Tagged<SharedFunctionInfo> shared);
+
+  size_t function_count() const { return entries_.size(); }
+
+ private:
+  using Key = std::pair<int, int>;
+
+  static bool KeyFor(Tagged<SharedFunctionInfo> shared, Key* key);
+  Entry* Lookup(Tagged<SharedFunctionInfo> shared);
+  static void PrintHistory(const Entry& entry, FILE* file);
+  void EvictLeastRecentlyDeoptimized();
+
+  static bool IsUnstable(const Entry& entry) {
+    return entry.deopt_count >= v8_flags.deopt_storm_threshold;
+  }
+  static int BackoffExponent(const Entry& entry);
+  static bool IsLimitedToMaglev(const Entry& entry) {
+    return entry.turbofan_deopt_count >= v8_flags.deopt_storm_threshold;
+  }
+
+  Isolate* const isolate_;
+  uint64_t deopt_sequence_ = 0;
+  std::unordered_map<Key, Entry, base::hash<Key>> entries_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_DEOPTIMIZER_DEOPT_TELEMETRY_H_
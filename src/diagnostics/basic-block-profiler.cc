@@ -7,10 +7,14 @@
 #include <algorithm>
 #include <numeric>
 #include <sstream>
+#include <unordered_map>
 
+#include "src/base/atomic-utils.h"
 #include "src/base/lazy-instance.h"
 #include "src/builtins/profile-data-reader.h"
+#include "src/flags/flags.h"
 #include "src/heap/heap-inl.h"
+#include "src/objects/script-inl.h"
 #include "src/objects/shared-function-info-inl.h"
 
 namespace v8 {
@@ -215,6 +219,127 @@ std::vector<bool> BasicBlockProfiler::GetCoverageBitmap(Isolate* isolate) {
   return out;
 }
 
+// static
+bool BasicBlockProfiler::LayoutProfileKeyFor(Tagged<SharedFunctionInfo> shared,
+                                             LayoutProfileKey* key) {
+  if (!IsScript(shared->script())) return false;
+  *key = {Script::cast(shared->script())->id(), shared->function_literal_id()};
+  return true;
+}
+
+BasicBlockProfiler::LayoutProfile* BasicBlockProfiler::FindLayoutProfile(
+    Tagged<SharedFunctionInfo> shared) {
+  LayoutProfileKey key;
+  if (!LayoutProfileKeyFor(shared, &key)) return nullptr;
+  auto it = layout_profiles_.find(key);
+  return it == layout_profiles_.end() ? nullptr : &it->second;
+}
+
+BasicBlockProfilerData* BasicBlockProfiler::NewLayoutProfilingData(
+    Tagged<SharedFunctionInfo> shared, size_t n_blocks, int hash) {
+  base::MutexGuard lock(&data_list_mutex_);
+  LayoutProfileKey key;
+  if (!LayoutProfileKeyFor(shared, &key)) return nullptr;
+  auto it = layout_profiles_.find(key);
+  if (it == layout_profiles_.end()) {
+    if (layout_profiles_.size() >=
+        v8_flags.turbo_profile_guided_layout_max_functions) {
+      return nullptr;
+    }
+    it = layout_profiles_.emplace(key, LayoutProfile{}).first;
+  }
+  LayoutProfile& profile = it->second;
+  if (profile.instrumentation_count == kMaxLayoutInstrumentations) {
+    return nullptr;
+  }
+  ++profile.instrumentation_count;
+  profile.hash = hash;
+  profile.deferred_block_count = 0;
+  if (profile.hints) retired_layout_hints_.push_back(std::move(profile.hints));
+
+  // Code instrumented with the previous counters might still run. Reusing
+  // them at the same size is safe, the stale counts just add noise to the
+  // profile.
+  if (profile.data != nullptr && profile.data->n_blocks() == n_blocks) {
+    profile.data->ResetCounts();
+    profile.data->branches_.clear();
+  } else {
+    layout_data_list_.push_back(
+        std::make_unique<BasicBlockProfilerData>(n_blocks));
+    profile.data = layout_data_list_.back().get();
+  }
+  profile.data->SetHash(hash);
+  return profile.data;
+}
+
+const ProfileDataFromFile* BasicBlockProfiler::GetRuntimeProfileData(
+    Tagged<SharedFunctionInfo> shared, int hash) {
+  base::MutexGuard lock(&data_list_mutex_);
+  LayoutProfile* profile = FindLayoutProfile(shared);
+  if (profile == nullptr || profile->hash != hash) return nullptr;
+  if (profile->hints) return profile->hints.get();
+
+  // The counters are written by running code without synchronization, so the
+  // values read here are only approximate, which is fine for layout
+  // decisions.
+  BasicBlockProfilerData* data = profile->data;
+  std::unordered_map<int32_t, uint64_t> counts_by_block_id;
+  for (size_t i = 0; i < data->n_blocks(); ++i) {
+    counts_by_block_id[data->block_ids_[i]] +=
+        base::AsAtomic32::Relaxed_Load(&data->counts_[i]);
+  }
+
+  // Same policy as tools/builtins-pgo/get_hints.py: a branch is hinted once
+  // the hot side has run often enough and dominates the cold side.
+  const uint64_t min_count = v8_flags.turbo_profile_guided_layout_min_count;
+  const uint64_t ratio = v8_flags.turbo_profile_guided_layout_threshold_ratio;
+  auto count_of = [&](int32_t block_id) -> uint64_t {
+    auto count = counts_by_block_id.find(block_id);
+    return count == counts_by_block_id.end() ? 0 : count->second;
+  };
+  auto hints = std::make_unique<ProfileDataFromFile>();
+  hints->hash_ = hash;
+  bool any_hot_branch = false;
+  for (const auto& branch : data->branches_) {
+    uint64_t true_count = count_of(branch.first);
+    uint64_t false_count = count_of(branch.second);
+    any_hot_branch |= true_count + false_count >= min_count;
+    bool hint;
+    if (true_count >= min_count && true_count / ratio >= false_count) {
+      hint = true;
+    } else if (false_count >= min_count &&
+               false_count / ratio >= true_count) {
+      hint = false;
+    } else {
+      continue;
+    }
+    hints->block_hints_by_id.insert(std::make_pair(
+        std::make_pair(static_cast<size_t>(branch.first),
+                       static_cast<size_t>(branch.second)),
+        hint));
+  }
+  // Don't cache a decision before the instrumented code has had a chance to
+  // run; a later reoptimization may find a more useful profile.
+  if (!any_hot_branch) return nullptr;
+  profile->hints = std::move(hints);
+  return profile->hints.get();
+}
+
+void BasicBlockProfiler::RecordLayout(Tagged<SharedFunctionInfo> shared,
+                                      size_t deferred_blocks) {
+  base::MutexGuard lock(&data_list_mutex_);
+  if (LayoutProfile* profile = FindLayoutProfile(shared)) {
+    profile->deferred_block_count = deferred_blocks;
+  }
+}
+
+const BasicBlockProfiler::LayoutProfile*
+BasicBlockProfiler::GetLayoutProfileForTesting(
+    Tagged<SharedFunctionInfo> shared) {
+  base::MutexGuard lock(&data_list_mutex_);
+  return FindLayoutProfile(shared);
+}
+
 void BasicBlockProfilerData::Log(Isolate* isolate, std::ostream& os) {
   bool any_nonzero_counter = false;
   constexpr char kNext[] = "\t";
@@ -7,12 +7,14 @@
 
 #include <iosfwd>
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "src/base/macros.h"
 #include "src/base/platform/mutex.h"
+#include "src/builtins/profile-data-reader.h"
 #include "src/common/globals.h"
 #include "src/objects/shared-function-info.h"
 
@@ -92,10 +94,66 @@ class BasicBlockProfiler {
   // snapshot.
   V8_EXPORT_PRIVATE std::vector<bool> GetCoverageBitmap(Isolate* isolate);
 
+  // The block counts collected for --turbo-profile-guided-layout, keyed by
+  // script id and function literal id. Only the most recently instrumented
+  // code of a function contributes to its profile.
+  struct LayoutProfile {
+    // The hash of the graph that the instrumented code was generated from.
+    int hash = 0;
+    // Number of times code for the function was instrumented.
+    int instrumentation_count = 0;
+    // Number of deferred blocks in the last schedule that was instrumented
+    // for or used the profile.
+    size_t deferred_block_count = 0;
+    // The counters written by the instrumented code.
+    BasicBlockProfilerData* data = nullptr;
+    // Branch hints computed from the counters, once they are meaningful.
+    std::unique_ptr<ProfileDataFromFile> hints;
+  };
+
+  // Returns the counters that code for {shared}, generated from a graph with
+  // the given hash, should be instrumented with, or nullptr if the function
+  // should not be instrumented (again). This replaces the previous profile of
+  // the function. Its counters are reused if they have the right size;
+  // otherwise they are retired, but kept alive since code that was
+  // instrumented with them might still run.
+  V8_EXPORT_PRIVATE BasicBlockProfilerData* NewLayoutProfilingData(
+      Tagged<SharedFunctionInfo> shared, size_t n_blocks, int hash);
+
+  // Returns branch hints derived from the block counts that earlier
+  // instrumented code for {shared} and the given graph hash has collected at
+  // runtime, or nullptr if no such code has run often enough yet. The
+  // returned object stays alive for the lifetime of the process, so it can
+  // be handed to the scheduler.
+  V8_EXPORT_PRIVATE const ProfileDataFromFile* GetRuntimeProfileData(
+      Tagged<SharedFunctionInfo> shared, int hash);
+
+  // Records the layout of a schedule that was instrumented for, or computed
+  // with the hints of, the layout profile of {shared}.
+  void RecordLayout(Tagged<SharedFunctionInfo> shared, size_t deferred_blocks);
+
+  V8_EXPORT_PRIVATE const LayoutProfile* GetLayoutProfileForTesting(
+      Tagged<SharedFunctionInfo> shared);
+
   const DataList* data_list() { return &data_list_; }
 
  private:
+  using LayoutProfileKey = std::pair<int, int>;
+
+  // At most this many compilations of a function are instrumented, so that
+  // the retired counters of a function are bounded.
+  static constexpr int kMaxLayoutInstrumentations = 3;
+
+  static bool LayoutProfileKeyFor(Tagged<SharedFunctionInfo> shared,
+                                  LayoutProfileKey* key);
+  LayoutProfile* FindLayoutProfile(Tagged<SharedFunctionInfo> shared);
+
   DataList data_list_;
+  std::map<LayoutProfileKey, LayoutProfile> layout_profiles_;
+  // Owns the counters and hints of all layout profiles, including retired
+  // ones.
+  DataList layout_data_list_;
+  std::vector<std::unique_ptr<ProfileDataFromFile>> retired_layout_hints_;
   base::Mutex data_list_mutex_;
 };
 
@@ -1784,6 +1784,8 @@ void JSRegExp::JSRegExpVerify(Isolate* isolate) {
       CHECK_EQ(arr->get(JSRegExp::kIrregexpTicksUntilTierUpIndex),
                uninitialized);
       CHECK_EQ(arr->get(JSRegExp::kIrregexpBacktrackLimit), uninitialized);
+      CHECK_EQ(arr->get(JSRegExp::kIrregexpRequiredLiteralIndex),
+               uninitialized);
       break;
     }
     case JSRegExp::IRREGEXP: {
@@ -1824,6 +1826,17 @@ void JSRegExp::JSRegExpVerify(Isolate* isolate) {
       CHECK(IsSmi(arr->get(JSRegExp::kIrregexpMaxRegisterCountIndex)));
       CHECK(IsSmi(arr->get(JSRegExp::kIrregexpTicksUntilTierUpIndex)));
       CHECK(IsSmi(arr->get(JSRegExp::kIrregexpBacktrackLimit)));
+
+      Tagged<Object> required_literal =
+          arr->get(JSRegExp::kIrregexpRequiredLiteralIndex);
+      // Smi : No required literal (-1).
+      // String: Flat literal which occurs in every match.
+      CHECK((IsSmi(required_literal) &&
+             Smi::ToInt(required_literal) == JSRegExp::kUninitializedValue) ||
+            (IsString(required_literal) &&
+             String::cast(required_literal)->IsFlat()));
+      CHECK(IsSmi(arr->get(JSRegExp::kIrregexpRequiredLiteralMinOffsetIndex)));
+      CHECK(IsSmi(arr->get(JSRegExp::kIrregexpRequiredLiteralMaxOffsetIndex)));
       break;
     }
     default:
@@ -98,6 +98,7 @@
 #include "src/objects/visitors.h"
 #include "src/profiler/heap-profiler.h"
 #include "src/profiler/tracing-cpu-profiler.h"
+#include "src/regexp/experimental/experimental-dfa.h"
 #include "src/regexp/regexp-stack.h"
 #include "src/roots/static-roots.h"
 #include "src/snapshot/embedded/embedded-data-inl.h"
@@ -3974,6 +3975,9 @@ Isolate::~Isolate() {
   delete regexp_stack_;
   regexp_stack_ = nullptr;
 
+  delete lazy_dfa_cache_;
+  lazy_dfa_cache_ = nullptr;
+
   delete descriptor_lookup_cache_;
   descriptor_lookup_cache_ = nullptr;
 
@@ -4540,6 +4544,7 @@ bool Isolate::Init(SnapshotData* startup_snapshot_data,
   store_stub_cache_ = new StubCache(this);
   materialized_object_store_ = new MaterializedObjectStore(this);
   regexp_stack_ = new RegExpStack();
+  lazy_dfa_cache_ = new LazyDfaCache(allocator());
   date_cache_ = new DateCache();
   heap_profiler_ = new HeapProfiler(heap());
   interpreter_ = new interpreter::Interpreter(this);
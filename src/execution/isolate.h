@@ -127,6 +127,7 @@ class HeapObjectToIndexHashMap;
 class HeapProfiler;
 class InnerPointerToCodeCache;
 class LazyCompileDispatcher;
+class LazyDfaCache;
 class LocalIsolate;
 class V8FileLogger;
 class MaterializedObjectStore;
@@ -1368,6 +1369,8 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
 
   RegExpStack* regexp_stack() const { return regexp_stack_; }
 
+  LazyDfaCache* lazy_dfa_cache() const { return lazy_dfa_cache_; }
+
   size_t total_regexp_code_generated() const {
     return total_regexp_code_generated_;
   }
@@ -2315,6 +2318,7 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
       regexp_macro_assembler_canonicalize_;
 #endif  // !V8_INTL_SUPPORT
   RegExpStack* regexp_stack_ = nullptr;
+  LazyDfaCache* lazy_dfa_cache_ = nullptr;
   std::vector<int> regexp_indices_;
   DateCache* date_cache_ = nullptr;
   base::RandomNumberGenerator* random_number_generator_ = nullptr;
@@ -213,9 +213,21 @@ int TieringManager::InterruptBudgetFor(
     // operation for forward jump.
     return INT_MAX / 2;
   }
-  return ::i::InterruptBudgetFor(
+  int budget = ::i::InterruptBudgetFor(
       override_active_tier ? override_active_tier : function->GetActiveTier(),
       function->tiering_state(), bytecode_length);
+  if (V8_UNLIKELY(v8_flags.deopt_storm_backoff)) {
+    // Functions that keep deoptimizing wait exponentially longer before they
+    // are optimized again, giving their feedback time to stabilize.
+    int backoff =
+        isolate->tiering_manager()->deopt_telemetry()->BackoffExponent(
+            function->shared());
+    if (backoff > 0) {
+      budget = budget > ((INT_MAX / 2) >> backoff) ? INT_MAX / 2
+                                                   : budget << backoff;
+    }
+  }
+  return budget;
 }
 
 namespace {
@@ -343,6 +355,19 @@ OptimizationDecision TieringManager::ShouldOptimize(
     return OptimizationDecision::DoNotOptimize();
   }
 
+  if (V8_UNLIKELY(v8_flags.deopt_storm_backoff) &&
+      current_code_kind == CodeKind::MAGLEV &&
+      deopt_telemetry_.ShouldLimitToMaglevOnTick(shared)) {
+    // The function's TurboFan code kept deoptimizing; stay in Maglev, which
+    // is cheaper to recompile whenever the feedback changes again. Functions
+    // that don't run Maglev code still tier up to TurboFan.
+    if (v8_flags.trace_opt_verbose) {
+      PrintF("[not marking function %s for TurboFan: unstable]\n",
+             shared->DebugNameCStr().get());
+    }
+    return OptimizationDecision::DoNotOptimize();
+  }
+
   if (!v8_flags.turbofan || !shared->PassesFilter(v8_flags.turbo_filter)) {
     return OptimizationDecision::DoNotOptimize();
   }
@@ -356,6 +381,9 @@ OptimizationDecision TieringManager::ShouldOptimize(
 }
 
 void TieringManager::NotifyICChanged(Tagged<FeedbackVector> vector) {
+  if (V8_UNLIKELY(v8_flags.deopt_storm_backoff)) {
+    deopt_telemetry_.RecordICChange(vector->shared_function_info());
+  }
   CodeKind code_kind = vector->has_optimized_code()
                            ? vector->optimized_code()->kind()
                        : vector->shared_function_info()->HasBaselineCode()
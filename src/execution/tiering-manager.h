@@ -8,6 +8,7 @@
 #include <optional>
 
 #include "src/common/assert-scope.h"
+#include "src/deoptimizer/deopt-telemetry.h"
 #include "src/handles/handles.h"
 #include "src/utils/allocation.h"
 
@@ -26,7 +27,8 @@ void TraceManualRecompile(Tagged<JSFunction> function, CodeKind code_kind,
 
 class TieringManager {
  public:
-  explicit TieringManager(Isolate* isolate) : isolate_(isolate) {}
+  explicit TieringManager(Isolate* isolate)
+      : isolate_(isolate), deopt_telemetry_(isolate) {}
 
   void OnInterruptTick(Handle<JSFunction> function, CodeKind code_kind);
 
@@ -42,6 +44,8 @@ class TieringManager {
 
   void MarkForTurboFanOptimization(Tagged<JSFunction> function);
 
+  DeoptTelemetry* deopt_telemetry() { return &deopt_telemetry_; }
+
  private:
   // Make the decision whether to optimize the given function, and mark it for
   // optimization if the decision was 'yes'.
@@ -65,6 +69,7 @@ class TieringManager {
   };
 
   Isolate* const isolate_;
+  DeoptTelemetry deopt_telemetry_;
 };
 
 }  // namespace internal
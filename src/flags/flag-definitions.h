@@ -805,6 +805,20 @@ DEFINE_INT(minimum_invocations_after_ic_update, 500,
            "How long to minimally wait after IC update before tier up")
 DEFINE_INT(minimum_invocations_before_optimization, 2,
            "Minimum number of invocations we need before non-OSR optimization")
+DEFINE_BOOL(deopt_storm_backoff, false,
+            "back off exponentially from reoptimizing functions that keep "
+            "deoptimizing, and keep unstable functions in Maglev")
+DEFINE_INT(deopt_storm_threshold, 3,
+           "number of deopts of optimized code after which a function is "
+           "considered unstable")
+DEFINE_INT(deopt_storm_max_backoff, 6,
+           "maximal exponent of the interrupt budget backoff applied to "
+           "unstable functions")
+DEFINE_INT(deopt_storm_decay_ticks, 16,
+           "number of interrupt ticks without feedback changes after which "
+           "the deopt counts of an unstable function are halved")
+DEFINE_BOOL(trace_deopt_storm, false,
+            "trace deopt storm detection and the resulting backoff")
 
 // Tiering: JIT fuzzing.
 //
@@ -910,6 +924,10 @@ DEFINE_UINT(
     "max number of threads that concurrent Sparkplug can use (0 for unbounded)")
 DEFINE_BOOL(concurrent_sparkplug_high_priority_threads, false,
             "use high priority compiler threads for concurrent Sparkplug")
+DEFINE_UINT(concurrent_sparkplug_install_budget_us, 500,
+            "main thread time budget in microseconds for installing "
+            "concurrently compiled Sparkplug code per interrupt (0 for "
+            "unbounded)")
 #else
 DEFINE_BOOL(baseline_batch_compilation, false, "batch compile Sparkplug code")
 DEFINE_BOOL_READONLY(concurrent_sparkplug, false,
@@ -1110,6 +1128,12 @@ DEFINE_INT(max_optimized_bytecode_size, 60 * KB,
            "the compiler to hit (release) assertions")
 DEFINE_FLOAT(min_inlining_frequency, 0.15, "minimum frequency for inlining")
 DEFINE_BOOL(polymorphic_inlining, true, "polymorphic inlining")
+DEFINE_BOOL(call_target_histogram, false,
+            "record the most frequent targets of polymorphic call sites "
+            "instead of going megamorphic")
+DEFINE_FLOAT(min_call_target_share, 0.1,
+             "minimum share of the calls at a polymorphic call site that a "
+             "target needs in order to be inlined")
 DEFINE_BOOL(stress_inline, false,
             "set high thresholds for inlining to inline as much as possible")
 DEFINE_VALUE_IMPLICATION(stress_inline, max_inlined_bytecode_size, 999999)
@@ -1159,6 +1183,22 @@ DEFINE_STRING(
     "(requires that V8 was built with v8_enable_builtins_profiling=true)")
 DEFINE_BOOL(reorder_builtins, false,
             "enable builtin reordering when run mksnapshot.")
+DEFINE_EXPERIMENTAL_FEATURE(
+    turbo_profile_guided_layout,
+    "instrument optimized JS code with basic block counters and use the "
+    "collected counts to move cold blocks out of line on reoptimization")
+// Block ids are only stable between compilations of the same graph if the
+// TurboFan scheduler produces the final schedule.
+DEFINE_NEG_IMPLICATION(turbo_profile_guided_layout, turboshaft)
+DEFINE_UINT(turbo_profile_guided_layout_min_count, 1000,
+            "minimum number of executions of the hot side of a branch before "
+            "--turbo-profile-guided-layout hints it")
+DEFINE_UINT(turbo_profile_guided_layout_threshold_ratio, 40,
+            "minimum ratio of hot to cold executions of a branch before "
+            "--turbo-profile-guided-layout hints it")
+DEFINE_SIZE_T(turbo_profile_guided_layout_max_functions, 4096,
+              "maximum number of functions that --turbo-profile-guided-layout "
+              "instruments")
 
 DEFINE_BOOL(abort_on_bad_builtin_profile_data, false,
             "flag for mksnapshot, abort if builtins profile can't be applied")
@@ -1325,6 +1365,9 @@ DEFINE_BOOL(wasm_native_module_cache_enabled, true,
 // The actual value used at runtime is clamped to kV8MaxWasmMemory{32,64}Pages.
 DEFINE_UINT(wasm_max_mem_pages, kMaxUInt32,
             "maximum number of 64KiB memory pages per wasm memory")
+DEFINE_SIZE_T(wasm_bulk_memory_nontemporal_threshold, 4 * MB,
+              "minimum size of wasm memory.copy and memory.fill operations "
+              "which use non-temporal stores on x64 (0 to disable)")
 DEFINE_UINT(wasm_max_table_size, wasm::kV8MaxWasmTableSize,
             "maximum table size of a wasm instance")
 DEFINE_UINT(wasm_max_committed_code_mb, kMaxCommittedWasmCodeMB,
@@ -1365,6 +1408,9 @@ DEFINE_IMPLICATION(liftoff_only, liftoff)
 DEFINE_NEG_IMPLICATION(liftoff_only, wasm_tier_up)
 DEFINE_NEG_IMPLICATION(liftoff_only, wasm_dynamic_tiering)
 DEFINE_NEG_IMPLICATION(fuzzing, liftoff_only)
+DEFINE_BOOL(liftoff_loop_register_locals, false,
+            "keep the most frequently used locals of each loop in registers "
+            "across loop iterations in Liftoff code")
 DEFINE_DEBUG_BOOL(
     enable_testing_opcode_in_wasm, false,
     "enables a testing opcode in wasm that is only implemented in TurboFan")
@@ -1375,6 +1421,15 @@ DEFINE_DEBUG_BOOL(trace_liftoff, false,
                   "trace Liftoff, the baseline compiler for WebAssembly")
 DEFINE_BOOL(trace_wasm_memory, false,
             "print all memory updates performed in wasm code")
+DEFINE_STRING(wasm_trace_file, nullptr,
+              "write the events of --trace-wasm-memory and --trace-wasm to "
+              "this file in a binary format, instead of printing them")
+DEFINE_UINT(wasm_trace_memory_sample_rate, 1,
+            "only write every n-th memory access to --wasm-trace-file")
+DEFINE_BOOL(wasm_trace_loops, false,
+            "write loop entries and iterations to --wasm-trace-file (Liftoff "
+            "code only)")
+DEFINE_IMPLICATION(wasm_trace_loops, liftoff_only)
 // Fuzzers use {wasm_tier_mask_for_testing}, {wasm_debug_mask_for_testing}, and
 // {wasm_turboshaft_mask_for_testing} together with {liftoff} and
 // {no_wasm_tier_up} to force some functions to be compiled with TurboFan or for
@@ -1396,6 +1451,9 @@ DEFINE_NEG_IMPLICATION(experimental_wasm_pgo_to_file, single_threaded)
 DEFINE_BOOL(
     experimental_wasm_pgo_from_file, false,
     "experimental: read and use Wasm PGO data from a local file (for testing)")
+DEFINE_STRING(wasm_code_cache_dir, nullptr,
+              "experimental: directory of a file-backed cache of compiled Wasm "
+              "modules, shared between processes")
 
 DEFINE_BOOL(validate_asm, true, "validate asm.js modules before compiling")
 // asm.js validation is disabled since it triggers wasm code generation.
@@ -1493,6 +1551,12 @@ DEFINE_BOOL(asm_wasm_lazy_compilation, false,
 DEFINE_IMPLICATION(validate_asm, asm_wasm_lazy_compilation)
 DEFINE_BOOL(wasm_lazy_compilation, true,
             "enable lazy compilation for all wasm modules")
+DEFINE_BOOL(wasm_shared_import_wrappers, true,
+            "share compiled import wrappers between all wasm modules of the "
+            "process")
+DEFINE_UINT(wasm_shared_import_wrapper_cache_size, 4 * 1024,
+            "maximum size of the shared import wrapper cache in KB; least "
+            "recently used wrappers are evicted beyond that")
 DEFINE_DEBUG_BOOL(trace_wasm_lazy_compilation, false,
                   "trace lazy compilation of wasm functions")
 DEFINE_BOOL(wasm_lazy_validation, false,
@@ -1504,6 +1568,12 @@ DEFINE_BOOL(wasm_code_gc, true, "enable garbage collection of wasm code")
 DEFINE_BOOL(trace_wasm_code_gc, false, "trace garbage collection of wasm code")
 DEFINE_BOOL(stress_wasm_code_gc, false,
             "stress test garbage collection of wasm code")
+DEFINE_BOOL(wasm_code_flushing, false,
+            "flush TurboFan code of wasm functions which did not execute for "
+            "a number of major GCs, and tier them up again when they get hot")
+DEFINE_INT(wasm_code_flushing_age, 5,
+           "number of major GCs without execution after which the TurboFan "
+           "code of a wasm function gets flushed")
 DEFINE_INT(wasm_max_initial_code_space_reservation, 0,
            "maximum size of the initial wasm code space reservation (in MB)")
 
@@ -1747,6 +1817,22 @@ DEFINE_BOOL(memory_reducer_single_gc, false,
 DEFINE_WEAK_IMPLICATION(future, memory_reducer_single_gc)
 DEFINE_INT(memory_reducer_gc_count, 3,
            "Maximum number of memory reducer GCs scheduled")
+#ifdef V8_USE_ZLIB
+DEFINE_BOOL(compress_cold_strings, false,
+            "compress large script sources in the memory reducer and on "
+            "memory pressure (experimental)")
+#else
+DEFINE_BOOL_READONLY(compress_cold_strings, false,
+                     "compress large script sources in the memory reducer "
+                     "and on memory pressure (experimental)")
+#endif  // V8_USE_ZLIB
+DEFINE_INT(cold_string_compression_min_length, 64 * KB,
+           "minimum length of strings compressed by --compress-cold-strings")
+DEFINE_INT(cold_string_compression_max_pass_size_kb, 8 * KB,
+           "maximum size of the sources compressed by one pass of "
+           "--compress-cold-strings (in KBytes)")
+DEFINE_BOOL(trace_cold_string_compression, false,
+            "print cold string compression behavior")
 DEFINE_INT(heap_growing_percent, 0,
            "specifies heap growing factor as (1 + heap_growing_percent/100)")
 DEFINE_INT(v8_os_page_size, 0, "override OS page size (in KBytes)")
@@ -2298,6 +2384,9 @@ DEFINE_INT(regexp_tier_up_ticks, 1,
            "tiering-up to the compiler")
 DEFINE_BOOL(regexp_peephole_optimization, REGEXP_PEEPHOLE_OPTIMIZATION_BOOL,
             "enable peephole optimization for regexp bytecode")
+DEFINE_BOOL(regexp_required_literal, true,
+            "scan the subject for a literal which every match contains "
+            "before running the regexp")
 DEFINE_BOOL(trace_regexp_peephole_optimization, false,
             "trace regexp bytecode peephole optimization")
 DEFINE_BOOL(trace_regexp_bytecodes, false, "trace regexp bytecode execution")
@@ -2313,6 +2402,14 @@ DEFINE_BOOL(default_to_experimental_regexp_engine, false,
             "run regexps with the experimental engine where possible")
 DEFINE_IMPLICATION(default_to_experimental_regexp_engine,
                    enable_experimental_regexp_engine)
+DEFINE_BOOL(experimental_regexp_engine_for_unsafe_patterns, false,
+            "run regexps with the experimental engine where possible if they "
+            "may backtrack exponentially, such as /(a+)+b/")
+DEFINE_IMPLICATION(experimental_regexp_engine_for_unsafe_patterns,
+                   enable_experimental_regexp_engine)
+DEFINE_BOOL(experimental_regexp_engine_lazy_dfa, true,
+            "reject subjects without a match with a lazily built DFA before "
+            "running the experimental regexp engine")
 DEFINE_BOOL(trace_experimental_regexp_engine, false,
             "trace execution of experimental regexp engine")
 
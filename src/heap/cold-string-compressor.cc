@@ -0,0 +1,282 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/cold-string-compressor.h"
+
+#include "include/v8-primitive.h"
+#include "src/base/platform/elapsed-timer.h"
+#include "src/execution/isolate.h"
+#include "src/heap/heap.h"
+#include "src/objects/script-inl.h"
+#include "src/objects/string-inl.h"
+#include "src/utils/utils.h"
+
+#ifdef V8_USE_ZLIB
+#include "third_party/zlib/google/compression_utils_portable.h"
+#endif  // V8_USE_ZLIB
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Strings are only compressed if this saves at least a quarter of their size.
+constexpr size_t kMaxCompressedSizePercentage = 75;
+
+bool Compress(const uint8_t* data, size_t size,
+              std::unique_ptr<uint8_t[]>* compressed,
+              size_t* compressed_size) {
+#ifdef V8_USE_ZLIB
+  // Compressing into a buffer of the largest acceptable size, rather than of
+  // compressBound(size), bounds the temporary memory, and zlib gives up as
+  // soon as the output would be too large.
+  uLongf buffer_size =
+      static_cast<uLongf>(size * kMaxCompressedSizePercentage / 100);
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[buffer_size]);
+  if (zlib_internal::CompressHelper(
+          zlib_internal::ZRAW, buffer.get(), &buffer_size, data,
+          static_cast<uLong>(size), Z_BEST_SPEED, nullptr, nullptr) != Z_OK) {
+    return false;
+  }
+  // Copy the result into a buffer of the right size.
+  compressed->reset(new uint8_t[buffer_size]);
+  MemCopy(compressed->get(), buffer.get(), buffer_size);
+  *compressed_size = buffer_size;
+  return true;
+#else
+  return false;
+#endif  // V8_USE_ZLIB
+}
+
+// An external string resource which decompresses its characters on demand.
+// It is not cacheable, so the string is morphed into an uncached external
+// string which asks the resource for the characters on every access.
+template <typename Base, typename Char>
+class CompressedStringResource final : public Base,
+                                       public CompressedStringData {
+ public:
+  CompressedStringResource(ColdStringCompressor* compressor,
+                           std::unique_ptr<uint8_t[]> compressed,
+                           size_t compressed_size, size_t uncompressed_size)
+      : CompressedStringData(std::move(compressed), compressed_size,
+                             uncompressed_size),
+        compressor_(compressor) {
+    compressor_->Register(this);
+  }
+
+  const Char* data() const override {
+    return reinterpret_cast<const Char*>(GetUncompressed());
+  }
+  size_t length() const override { return uncompressed_size() / sizeof(Char); }
+  bool IsCacheable() const override { return false; }
+  void Lock() const override { LockUncompressed(); }
+  void Unlock() const override { UnlockUncompressed(); }
+
+  void Dispose() override {
+    compressor_->Unregister(this);
+    delete this;
+  }
+
+ private:
+  ColdStringCompressor* const compressor_;
+};
+
+using CompressedOneByteStringResource =
+    CompressedStringResource<v8::String::ExternalOneByteStringResource, char>;
+using CompressedTwoByteStringResource =
+    CompressedStringResource<v8::String::ExternalStringResource, uint16_t>;
+
+}  // namespace
+
+CompressedStringData::CompressedStringData(
+    std::unique_ptr<uint8_t[]> compressed, size_t compressed_size,
+    size_t uncompressed_size)
+    : compressed_(std::move(compressed)),
+      compressed_size_(compressed_size),
+      uncompressed_size_(uncompressed_size) {}
+
+CompressedStringData::~CompressedStringData() {
+  delete[] uncompressed_.load(std::memory_order_relaxed);
+}
+
+const uint8_t* CompressedStringData::GetUncompressed() const {
+  if (!accessed_.load(std::memory_order_relaxed)) {
+    accessed_.store(true, std::memory_order_relaxed);
+  }
+  uint8_t* uncompressed = uncompressed_.load(std::memory_order_acquire);
+  if (V8_LIKELY(uncompressed != nullptr)) return uncompressed;
+
+  base::MutexGuard guard(&mutex_);
+  uncompressed = uncompressed_.load(std::memory_order_relaxed);
+  if (uncompressed != nullptr) return uncompressed;
+  uncompressed = new uint8_t[uncompressed_size_];
+#ifdef V8_USE_ZLIB
+  uLongf size = static_cast<uLongf>(uncompressed_size_);
+  CHECK_EQ(zlib_internal::UncompressHelper(
+               zlib_internal::ZRAW, uncompressed, &size, compressed_.get(),
+               static_cast<uLong>(compressed_size_)),
+           Z_OK);
+  CHECK_EQ(uncompressed_size_, size);
+#else
+  UNREACHABLE();
+#endif  // V8_USE_ZLIB
+  uncompressed_.store(uncompressed, std::memory_order_release);
+  return uncompressed;
+}
+
+void CompressedStringData::LockUncompressed() const {
+  {
+    base::MutexGuard guard(&mutex_);
+    lock_count_++;
+  }
+  GetUncompressed();
+}
+
+void CompressedStringData::UnlockUncompressed() const {
+  base::MutexGuard guard(&mutex_);
+  DCHECK_LT(0, lock_count_);
+  lock_count_--;
+}
+
+size_t CompressedStringData::ReleaseUnusedUncompressed() {
+  base::MutexGuard guard(&mutex_);
+  if (accessed_.exchange(false, std::memory_order_relaxed)) return 0;
+  if (lock_count_ > 0) return 0;
+  uint8_t* uncompressed =
+      uncompressed_.exchange(nullptr, std::memory_order_relaxed);
+  if (uncompressed == nullptr) return 0;
+  delete[] uncompressed;
+  return uncompressed_size_;
+}
+
+ColdStringCompressor::ColdStringCompressor(Heap* heap) : heap_(heap) {}
+
+ColdStringCompressor::~ColdStringCompressor() {
+  // All external strings are finalized before the heap is torn down.
+  DCHECK(strings_.empty());
+}
+
+void ColdStringCompressor::Register(CompressedStringData* data) {
+  strings_.insert(data);
+}
+
+void ColdStringCompressor::Unregister(CompressedStringData* data) {
+  strings_.erase(data);
+}
+
+void ColdStringCompressor::CompressColdStrings(ReleaseUncompressed release) {
+  Isolate* isolate = heap_->isolate();
+  base::ElapsedTimer timer;
+  if (v8_flags.trace_cold_string_compression) timer.Start();
+
+  size_t released_bytes = 0;
+  if (release == ReleaseUncompressed::kYes) {
+    for (CompressedStringData* data : strings_) {
+      released_bytes += data->ReleaseUnusedUncompressed();
+    }
+  }
+
+  int compressed_strings = 0;
+  size_t uncompressed_bytes = 0;
+  size_t compressed_bytes = 0;
+  size_t attempted_bytes = 0;
+  const size_t max_attempted_bytes =
+      static_cast<size_t>(v8_flags.cold_string_compression_max_pass_size_kb) *
+      KB;
+  bool completed = true;
+  // The incompressible sources which are still alive, such that the entries
+  // of dead scripts are dropped after a complete pass.
+  std::unordered_map<int, int> alive_incompressible_sources;
+  DisallowGarbageCollection no_gc;
+  Script::Iterator iterator(isolate);
+  for (Tagged<Script> script = iterator.Next(); !script.is_null();
+       script = iterator.Next()) {
+    // Sources of eval and new Function are usually short-lived or
+    // generated, and their scripts are not kept by the embedder.
+    if (script->compilation_type() != Script::CompilationType::kHost) {
+      continue;
+    }
+    Tagged<Object> source = script->source();
+    if (!IsSeqString(source)) continue;
+    Tagged<SeqString> string = SeqString::cast(source);
+    if (string->length() < v8_flags.cold_string_compression_min_length ||
+        IsInternalizedString(string) || string->IsShared()) {
+      continue;
+    }
+    const bool is_one_byte = IsSeqOneByteString(string);
+    if (!string->SupportsExternalization(
+            is_one_byte ? v8::String::ONE_BYTE_ENCODING
+                        : v8::String::TWO_BYTE_ENCODING)) {
+      continue;
+    }
+    auto incompressible = incompressible_sources_.find(script->id());
+    if (incompressible != incompressible_sources_.end() &&
+        incompressible->second == string->length()) {
+      alive_incompressible_sources.insert(*incompressible);
+      continue;
+    }
+
+    const uint8_t* chars;
+    size_t size;
+    if (is_one_byte) {
+      chars = SeqOneByteString::cast(string)->GetChars(no_gc);
+      size = string->length();
+    } else {
+      chars = reinterpret_cast<const uint8_t*>(
+          SeqTwoByteString::cast(string)->GetChars(no_gc));
+      size = string->length() * sizeof(base::uc16);
+    }
+    // Compression runs synchronously, also on critical memory pressure, so
+    // limit the work per pass. The remaining sources are compressed by later
+    // passes. A single source larger than the limit is still compressed.
+    if (attempted_bytes > 0 && attempted_bytes + size > max_attempted_bytes) {
+      completed = false;
+      break;
+    }
+    attempted_bytes += size;
+    std::unique_ptr<uint8_t[]> compressed;
+    size_t compressed_size;
+    if (!Compress(chars, size, &compressed, &compressed_size)) {
+      alive_incompressible_sources.emplace(script->id(), string->length());
+      continue;
+    }
+
+    bool success;
+    if (is_one_byte) {
+      auto* resource = new CompressedOneByteStringResource(
+          this, std::move(compressed), compressed_size, size);
+      success = string->MakeExternal(resource);
+      if (!success) resource->Dispose();
+    } else {
+      auto* resource = new CompressedTwoByteStringResource(
+          this, std::move(compressed), compressed_size, size);
+      success = string->MakeExternal(resource);
+      if (!success) resource->Dispose();
+    }
+    if (!success) continue;
+    compressed_strings++;
+    uncompressed_bytes += size;
+    compressed_bytes += compressed_size;
+  }
+  if (completed) {
+    incompressible_sources_ = std::move(alive_incompressible_sources);
+  } else {
+    incompressible_sources_.insert(alive_incompressible_sources.begin(),
+                                   alive_incompressible_sources.end());
+  }
+
+  if (v8_flags.trace_cold_string_compression) {
+    isolate->PrintWithTimestamp(
+        "Cold string compression: compressed %d strings (%zu KB to %zu KB), "
+        "released %zu KB of uncompressed data, %zu compressed strings in "
+        "total, %zu incompressible, %s, took %.1f ms\n",
+        compressed_strings, uncompressed_bytes / KB, compressed_bytes / KB,
+        released_bytes / KB, strings_.size(), incompressible_sources_.size(),
+        completed ? "completed" : "stopped at the work limit",
+        timer.Elapsed().InMillisecondsF());
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
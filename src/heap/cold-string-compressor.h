@@ -0,0 +1,106 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_COLD_STRING_COMPRESSOR_H_
+#define V8_HEAP_COLD_STRING_COMPRESSOR_H_
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// The compressed characters of a string, which are decompressed on demand.
+// This is the part of the external string resources created by the
+// ColdStringCompressor which does not depend on the encoding.
+class CompressedStringData {
+ public:
+  CompressedStringData(std::unique_ptr<uint8_t[]> compressed,
+                       size_t compressed_size, size_t uncompressed_size);
+  ~CompressedStringData();
+  CompressedStringData(const CompressedStringData&) = delete;
+  CompressedStringData& operator=(const CompressedStringData&) = delete;
+
+  // Returns the uncompressed characters, decompressing them if needed, and
+  // marks them as accessed.
+  const uint8_t* GetUncompressed() const;
+
+  // While locked, the uncompressed characters are not released.
+  void LockUncompressed() const;
+  void UnlockUncompressed() const;
+
+  // Releases the uncompressed characters if they were not accessed since the
+  // previous call and are not locked. Returns the number of bytes freed.
+  size_t ReleaseUnusedUncompressed();
+
+  size_t compressed_size() const { return compressed_size_; }
+  size_t uncompressed_size() const { return uncompressed_size_; }
+
+ private:
+  const std::unique_ptr<uint8_t[]> compressed_;
+  const size_t compressed_size_;
+  const size_t uncompressed_size_;
+  mutable base::Mutex mutex_;
+  mutable std::atomic<uint8_t*> uncompressed_{nullptr};
+  mutable std::atomic<bool> accessed_{false};
+  // Guarded by {mutex_}.
+  mutable int lock_count_ = 0;
+};
+
+// Compresses long-lived large strings which are rarely accessed. This is
+// done for the sources of scripts: after compilation they are only needed to
+// lazily compile functions, for Function.prototype.toString and for the
+// debugger.
+//
+// A compressed string is morphed into an uncached external string whose
+// resource is not cacheable, so that V8 asks the resource for the characters
+// on every access. The resource decompresses them on the first access and
+// keeps them until a later pass finds that they were not accessed in the
+// meantime. Since V8 only uses the characters of such resources within a
+// task, or between Lock() and Unlock(), they are only released by the
+// memory reducer, which runs in a task of its own.
+class ColdStringCompressor final {
+ public:
+  explicit ColdStringCompressor(Heap* heap);
+  ~ColdStringCompressor();
+  ColdStringCompressor(const ColdStringCompressor&) = delete;
+  ColdStringCompressor& operator=(const ColdStringCompressor&) = delete;
+
+  enum class ReleaseUncompressed { kNo, kYes };
+
+  // Compresses the sources of scripts compiled by the embedder which are
+  // sequential strings of at least --cold-string-compression-min-length
+  // characters, up to --cold-string-compression-max-pass-size-kb of sources
+  // per pass. If {release} is kYes, also releases the uncompressed characters
+  // of compressed strings which were not accessed since the previous pass.
+  void CompressColdStrings(ReleaseUncompressed release);
+
+  void Register(CompressedStringData* data);
+  void Unregister(CompressedStringData* data);
+
+  size_t number_of_compressed_strings() const { return strings_.size(); }
+  size_t number_of_incompressible_sources() const {
+    return incompressible_sources_.size();
+  }
+
+ private:
+  Heap* const heap_;
+  std::unordered_set<CompressedStringData*> strings_;
+  // Maps the ids of scripts whose sources didn't compress well enough to the
+  // length of their sources, so that they are not compressed again.
+  std::unordered_map<int, int> incompressible_sources_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_COLD_STRING_COMPRESSOR_H_
@@ -3713,6 +3713,9 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpCaptureNameMapIndex, uninitialized);
   store->set(JSRegExp::kIrregexpTicksUntilTierUpIndex, ticks_until_tier_up);
   store->set(JSRegExp::kIrregexpBacktrackLimit, Smi::FromInt(backtrack_limit));
+  store->set(JSRegExp::kIrregexpRequiredLiteralIndex, uninitialized);
+  store->set(JSRegExp::kIrregexpRequiredLiteralMinOffsetIndex, Smi::zero());
+  store->set(JSRegExp::kIrregexpRequiredLiteralMaxOffsetIndex, uninitialized);
   regexp->set_data(store);
 }
 
@@ -3737,6 +3740,9 @@ void Factory::SetRegExpExperimentalData(Handle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpCaptureNameMapIndex, uninitialized);
   store->set(JSRegExp::kIrregexpTicksUntilTierUpIndex, uninitialized);
   store->set(JSRegExp::kIrregexpBacktrackLimit, uninitialized);
+  store->set(JSRegExp::kIrregexpRequiredLiteralIndex, uninitialized);
+  store->set(JSRegExp::kIrregexpRequiredLiteralMinOffsetIndex, uninitialized);
+  store->set(JSRegExp::kIrregexpRequiredLiteralMaxOffsetIndex, uninitialized);
   regexp->set_data(store);
 }
 
@@ -45,6 +45,7 @@
 #include "src/heap/basic-memory-chunk.h"
 #include "src/heap/code-range.h"
 #include "src/heap/code-stats.h"
+#include "src/heap/cold-string-compressor.h"
 #include "src/heap/collection-barrier.h"
 #include "src/heap/combined-heap.h"
 #include "src/heap/concurrent-allocator.h"
@@ -4256,6 +4257,11 @@ void Heap::CheckMemoryPressure() {
       MemoryPressureLevel::kNone, std::memory_order_relaxed);
   if (memory_pressure_level == MemoryPressureLevel::kCritical) {
     TRACE_EVENT0("devtools.timeline,v8", "V8.CheckMemoryPressure");
+    if (cold_string_compressor_) {
+      // Compress before the GC, so that it frees the old characters.
+      cold_string_compressor_->CompressColdStrings(
+          ColdStringCompressor::ReleaseUncompressed::kNo);
+    }
     CollectGarbageOnMemoryPressure();
   } else if (memory_pressure_level == MemoryPressureLevel::kModerate) {
     if (v8_flags.incremental_marking && incremental_marking()->IsStopped()) {
@@ -5716,6 +5722,9 @@ void Heap::SetUpSpaces(LinearAllocationArea& new_allocation_info,
   gc_idle_time_handler_.reset(new GCIdleTimeHandler());
   memory_measurement_.reset(new MemoryMeasurement(isolate()));
   if (v8_flags.memory_reducer) memory_reducer_.reset(new MemoryReducer(this));
+  if (v8_flags.compress_cold_strings) {
+    cold_string_compressor_.reset(new ColdStringCompressor(this));
+  }
   if (V8_UNLIKELY(TracingFlags::is_gc_stats_enabled())) {
     live_object_stats_.reset(new ObjectStats(this));
     dead_object_stats_.reset(new ObjectStats(this));
@@ -6040,6 +6049,8 @@ void Heap::TearDown() {
     memory_reducer_.reset();
   }
 
+  cold_string_compressor_.reset();
+
   live_object_stats_.reset();
   dead_object_stats_.reset();
 
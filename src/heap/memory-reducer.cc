@@ -5,6 +5,7 @@
 #include "src/heap/memory-reducer.h"
 
 #include "src/flags/flags.h"
+#include "src/heap/cold-string-compressor.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/incremental-marking.h"
@@ -78,6 +79,12 @@ void MemoryReducer::NotifyTimer(const Event& event) {
       heap()->isolate()->PrintWithTimestamp("Memory reducer: started GC #%d\n",
                                             state_.started_gcs());
     }
+    if (ColdStringCompressor* compressor = heap()->cold_string_compressor()) {
+      // The timer runs in a task of its own, so no one is using uncompressed
+      // characters of uncacheable resources without locking them.
+      compressor->CompressColdStrings(
+          ColdStringCompressor::ReleaseUncompressed::kYes);
+    }
     heap()->StartIncrementalMarking(GCFlag::kReduceMemoryFootprint,
                                     GarbageCollectionReason::kMemoryReducer,
                                     kGCCallbackFlagCollectAllExternalMemory);
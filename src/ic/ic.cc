@@ -3577,5 +3577,18 @@ RUNTIME_FUNCTION(Runtime_HasElementWithInterceptor) {
   return ReadOnlyRoots(isolate).boolean_value(maybe.FromJust());
 }
 
+RUNTIME_FUNCTION(Runtime_UpdateCallTargetHistogram) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(3, args.length());
+  Handle<FeedbackVector> vector = args.at<FeedbackVector>(0);
+  int index = args.tagged_index_value_at(1);
+  Handle<Object> target = args.at(2);
+
+  FeedbackSlot slot = FeedbackVector::ToSlot(index);
+  FeedbackNexus nexus(vector, slot);
+  nexus.UpdateCallTargetHistogram(target);
+  return ReadOnlyRoots(isolate).undefined_value();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -224,6 +224,13 @@ namespace internal {
   HT(maglev_optimize_finalize, V8.MaglevOptimizeFinalize, 100000, MICROSECOND) \
   HT(maglev_optimize_total_time, V8.MaglevOptimizeTotalTime, 1000000,          \
      MICROSECOND)                                                              \
+  /* Sparkplug timers. */                                                      \
+  HT(sparkplug_batch_prepare, V8.SparkplugBatchPrepareMicroSeconds, 100000,    \
+     MICROSECOND)                                                              \
+  HT(sparkplug_batch_compile, V8.SparkplugBatchCompileMicroSeconds, 1000000,   \
+     MICROSECOND)                                                              \
+  HT(sparkplug_batch_install, V8.SparkplugBatchInstallMicroSeconds, 100000,    \
+     MICROSECOND)                                                              \
   /* TurboFan timers. */                                                       \
   HT(turbofan_optimize_prepare, V8.TurboFanOptimizePrepare, 1000000,           \
      MICROSECOND)                                                              \
@@ -260,6 +267,15 @@ namespace internal {
      V8.WasmCompileModuleStreamingMicroSeconds, 100000000, MICROSECOND)        \
   HT(wasm_streaming_finish_wasm_module_time,                                   \
      V8.WasmFinishModuleStreamingMicroSeconds, 100000000, MICROSECOND)         \
+  /* Per-stage times of streaming compilation: decoding on the streaming */    \
+  /* thread, validation on background threads, and the time spent waiting */   \
+  /* for validation after the last byte was received. */                       \
+  HT(wasm_streaming_decode_time, V8.WasmStreamingDecodeMicroSeconds,           \
+     100000000, MICROSECOND)                                                   \
+  HT(wasm_streaming_validate_time, V8.WasmStreamingValidateMicroSeconds,       \
+     100000000, MICROSECOND)                                                   \
+  HT(wasm_streaming_validate_wait_time,                                        \
+     V8.WasmStreamingValidateWaitMicroSeconds, 100000000, MICROSECOND)         \
   HT(wasm_deserialization_time, V8.WasmDeserializationTimeMilliSeconds, 10000, \
      MILLISECOND)                                                              \
   HT(wasm_compile_asm_function_time, V8.WasmCompileFunctionMicroSeconds.asm,   \
@@ -366,6 +382,13 @@ namespace internal {
   SC(maps_created, V8.MapsCreated)                                             \
   SC(megamorphic_stub_cache_updates, V8.MegamorphicStubCacheUpdates)           \
   SC(regexp_entry_runtime, V8.RegExpEntryRuntime)                              \
+  /* Insertions into the string table which lost the race for a slot. */       \
+  SC(string_table_insert_cas_failures, V8.StringTableInsertCasFailures)        \
+  /* Insertions which waited for another thread to fill a slot. */             \
+  SC(string_table_insert_waits, V8.StringTableInsertWaits)                     \
+  SC(string_table_resizes, V8.StringTableResizes)                              \
+  /* Chunks copied by threads which joined a string table resize. */           \
+  SC(string_table_resize_chunks_helped, V8.StringTableResizeChunksHelped)      \
   SC(stack_interrupts, V8.StackInterrupts)                                     \
   SC(new_space_bytes_available, V8.MemoryNewSpaceBytesAvailable)               \
   SC(new_space_bytes_committed, V8.MemoryNewSpaceBytesCommitted)               \
@@ -385,7 +408,9 @@ namespace internal {
   SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes)                      \
   SC(wasm_reloc_size, V8.WasmRelocBytes)                                       \
   SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions)           \
-  SC(wasm_compiled_export_wrapper, V8.WasmCompiledExportWrappers)
+  SC(wasm_compiled_export_wrapper, V8.WasmCompiledExportWrappers)              \
+  SC(wasm_reused_import_wrapper, V8.WasmReusedImportWrappers)                  \
+  SC(wasm_flushed_functions, V8.WasmFlushedFunctions)
 
 // List of counters that can be incremented from generated code. We need them in
 // a separate list to be able to relocate them.
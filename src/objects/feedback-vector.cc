@@ -4,6 +4,8 @@
 
 #include "src/objects/feedback-vector.h"
 
+#include <algorithm>
+
 #include "src/base/optional.h"
 #include "src/common/globals.h"
 #include "src/deoptimizer/deoptimizer.h"
@@ -810,6 +812,10 @@ InlineCacheState FeedbackNexus::ic_state() const {
       } else if (feedback.GetHeapObjectIfStrong(&heap_object) &&
                  IsAllocationSite(heap_object)) {
         return InlineCacheState::MONOMORPHIC;
+      } else if (feedback.GetHeapObjectIfStrong(&heap_object) &&
+                 IsWeakFixedArray(heap_object)) {
+        // A call target histogram, see --call-target-histogram.
+        return InlineCacheState::POLYMORPHIC;
       }
 
       CHECK_EQ(feedback, UninitializedSentinel());
@@ -1060,6 +1066,114 @@ float FeedbackNexus::ComputeCallFrequency() {
   return static_cast<float>(call_count / invocation_count);
 }
 
+void FeedbackNexus::UpdateCallTargetHistogram(Handle<Object> target) {
+  DCHECK(IsCallICKind(kind()));
+  DCHECK(v8_flags.call_target_histogram);
+  Isolate* isolate = GetIsolate();
+
+  Handle<WeakFixedArray> histogram;
+  Tagged<HeapObject> heap_object;
+  MaybeObject feedback = GetFeedback();
+  if (feedback.GetHeapObjectIfStrong(&heap_object) &&
+      IsWeakFixedArray(heap_object)) {
+    histogram = handle(WeakFixedArray::cast(heap_object), isolate);
+  } else if (feedback.GetHeapObjectIfWeak(&heap_object) &&
+             IsJSFunction(heap_object) &&
+             GetCallFeedbackContent() == CallFeedbackContent::kTarget) {
+    // Transition from MONOMORPHIC, attributing all previous calls except the
+    // current one to the monomorphic target.
+    Handle<JSFunction> monomorphic_target(JSFunction::cast(heap_object),
+                                          isolate);
+    int count = std::min(std::max(GetCallCount() - 1, 1),
+                         kCallTargetHistogramMaxCount);
+    histogram = CreateArrayOfSize(kCallTargetHistogramEntrySize);
+    histogram->Set(0, HeapObjectReference::Weak(*monomorphic_target));
+    histogram->Set(1, MaybeObject::FromSmi(Smi::FromInt(count)));
+    SetFeedback(*histogram);
+  } else {
+    ConfigureMegamorphic();
+    return;
+  }
+
+  // Only JSFunctions of the current native context can be inlined, calls to
+  // any other target are just reflected in the total call count. The
+  // CollectCallFeedback builtin already filters them out.
+  if (!IsJSFunction(*target) ||
+      JSFunction::cast(*target)->native_context() !=
+          isolate->raw_native_context()) {
+    return;
+  }
+
+  int free_index = -1;
+  for (int i = 0; i < histogram->length();
+       i += kCallTargetHistogramEntrySize) {
+    MaybeObject entry = histogram->Get(i);
+    if (entry.IsCleared()) {
+      free_index = i;
+      continue;
+    }
+    if (entry.GetHeapObjectAssumeWeak() == *target) {
+      // We might get here with a stale view of the histogram, e.g. after an
+      // intervening GC cleared another entry.
+      int count = Smi::ToInt(histogram->Get(i + 1).ToSmi());
+      if (count < kCallTargetHistogramMaxCount) {
+        histogram->Set(i + 1, MaybeObject::FromSmi(Smi::FromInt(count + 1)));
+      }
+      return;
+    }
+  }
+
+  int index = free_index;
+  if (index == -1) {
+    // A full histogram is terminal, the CollectCallFeedback builtin doesn't
+    // even call into the runtime for it.
+    if (histogram->length() ==
+        kCallTargetHistogramCapacity * kCallTargetHistogramEntrySize) {
+      return;
+    }
+    // Grow the histogram by one entry.
+    Handle<WeakFixedArray> new_histogram =
+        CreateArrayOfSize(histogram->length() + kCallTargetHistogramEntrySize);
+    for (int j = 0; j < histogram->length(); ++j) {
+      new_histogram->Set(j, histogram->Get(j));
+    }
+    index = histogram->length();
+    SetFeedback(*new_histogram);
+    histogram = new_histogram;
+  }
+  histogram->Set(index, HeapObjectReference::Weak(HeapObject::cast(*target)));
+  histogram->Set(index + 1, MaybeObject::FromSmi(Smi::FromInt(1)));
+}
+
+void FeedbackNexus::ExtractCallTargetHistogram(
+    std::vector<std::pair<Handle<JSFunction>, int>>* targets) const {
+  DCHECK(IsCallICKind(kind()));
+  DisallowGarbageCollection no_gc;
+
+  Tagged<HeapObject> heap_object;
+  if (!GetFeedback().GetHeapObjectIfStrong(&heap_object) ||
+      !IsWeakFixedArray(heap_object)) {
+    return;
+  }
+  Tagged<WeakFixedArray> histogram = WeakFixedArray::cast(heap_object);
+  for (int i = 0; i < histogram->length();
+       i += kCallTargetHistogramEntrySize) {
+    Tagged<HeapObject> target;
+    Tagged<Smi> count;
+    if (!histogram->Get(i).GetHeapObjectIfWeak(&target) ||
+        !histogram->Get(i + 1).ToSmi(&count)) {
+      continue;
+    }
+    targets->emplace_back(config()->NewHandle(JSFunction::cast(target)),
+                          Smi::ToInt(count));
+  }
+  std::stable_sort(targets->begin(), targets->end(),
+                   [](const std::pair<Handle<JSFunction>, int>& a,
+                      const std::pair<Handle<JSFunction>, int>& b) {
+                     return a.second > b.second;
+                   });
+}
+
 void FeedbackNexus::ConfigureMonomorphic(Handle<Name> name,
                                          Handle<Map> receiver_map,
                                          const MaybeObjectHandle& handler) {
@@ -887,6 +887,22 @@ class V8_EXPORT_PRIVATE FeedbackNexus final {
   using CallFeedbackContentField = base::BitField<CallFeedbackContent, 1, 1>;
   using CallCountField = base::BitField<uint32_t, 2, 30>;
 
+  // With --call-target-histogram, a Call IC that sees a second JSFunction
+  // target does not go megamorphic, but records the most frequent targets
+  // together with (approximate) call counts in a WeakFixedArray of
+  // (weak target, Smi count) entries. A full histogram is terminal: calls to
+  // targets that are not recorded only bump the total call count, so
+  // megamorphic call sites don't keep calling into the runtime.
+  static constexpr int kCallTargetHistogramEntrySize = 2;
+  static constexpr int kCallTargetHistogramCapacity = 8;
+  static constexpr int kCallTargetHistogramMaxCount = CallCountField::kMax;
+  // Records a call to {target} that is not yet in the call target histogram,
+  // creating the histogram if the Call IC is monomorphic.
+  void UpdateCallTargetHistogram(Handle<Object> target);
+  // Returns the recorded targets and their counts, most frequent first.
+  void ExtractCallTargetHistogram(
+      std::vector<std::pair<Handle<JSFunction>, int>>* targets) const;
+
   // For InstanceOf ICs.
   MaybeHandle<JSObject> GetConstructorFeedback() const;
 
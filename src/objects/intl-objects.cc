@@ -316,9 +316,9 @@ Tagged<String> Intl::ConvertOneByteToLower(Tagged<String> src,
 
     // If not ASCII, we keep the result up to index_to_first_unprocessed and
     // process the rest.
-    for (int index = index_to_first_unprocessed; index < length; ++index) {
-      dst_data[index] = ToLatin1Lower(static_cast<uint16_t>(src_data[index]));
-    }
+    Latin1ConvertToLower(dst_data + index_to_first_unprocessed,
+                         src_data + index_to_first_unprocessed,
+                         length - index_to_first_unprocessed);
   } else {
     DCHECK(src_flat.IsTwoByte());
     int index_to_first_unprocessed = FindFirstUpperOrNonAscii(src, length);
@@ -390,9 +390,10 @@ MaybeHandle<String> Intl::ConvertToUpper(Isolate* isolate, Handle<String> s) {
         }
         // If not ASCII, we keep the result up to index_to_first_unprocessed and
         // process the rest.
-        is_result_single_byte =
-            ToUpperOneByte(src.SubVector(index_to_first_unprocessed, length),
-                           dest + index_to_first_unprocessed, &sharp_s_count);
+        is_result_single_byte = Latin1ConvertToUpper(
+            dest + index_to_first_unprocessed,
+            src.begin() + index_to_first_unprocessed,
+            length - index_to_first_unprocessed, &sharp_s_count);
       } else {
         DCHECK(flat.IsTwoByte());
         base::Vector<const uint16_t> src = flat.ToUC16Vector();
@@ -212,7 +212,20 @@ class JSRegExp : public TorqueGeneratedJSRegExp<JSRegExp, JSObject> {
   // above to save space.
   static constexpr int kIrregexpBacktrackLimit =
       kIrregexpTicksUntilTierUpIndex + 1;
-  static constexpr int kIrregexpDataSize = kIrregexpBacktrackLimit + 1;
+  // A literal string which occurs in every match, or a Smi marker value equal
+  // to kUninitializedValue. Before running the matcher, the subject is
+  // scanned for it to reject the subject or to skip ahead.
+  static constexpr int kIrregexpRequiredLiteralIndex =
+      kIrregexpBacktrackLimit + 1;
+  // Smis holding the smallest and largest distance of the required literal
+  // from the start of a match. The largest distance is kUninitializedValue if
+  // it is unbounded.
+  static constexpr int kIrregexpRequiredLiteralMinOffsetIndex =
+      kIrregexpRequiredLiteralIndex + 1;
+  static constexpr int kIrregexpRequiredLiteralMaxOffsetIndex =
+      kIrregexpRequiredLiteralMinOffsetIndex + 1;
+  static constexpr int kIrregexpDataSize =
+      kIrregexpRequiredLiteralMaxOffsetIndex + 1;
 
   // TODO(mbid,v8:10765): At the moment the EXPERIMENTAL data array conforms
   // to the format of an IRREGEXP data array, with most fields set to some
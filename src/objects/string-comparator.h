@@ -8,6 +8,7 @@
 #include "src/base/logging.h"
 #include "src/common/globals.h"
 #include "src/objects/string.h"
+#include "src/strings/string-compare-simd.h"
 #include "src/utils/utils.h"
 
 namespace v8 {
@@ -56,7 +57,7 @@ class StringComparator {
   static inline bool Equals(State* state_1, State* state_2, int to_check) {
     const Chars1* a = reinterpret_cast<const Chars1*>(state_1->buffer8_);
     const Chars2* b = reinterpret_cast<const Chars2*>(state_2->buffer8_);
-    return CompareCharsEqual(a, b, to_check);
+    return CompareCharsEqualVectorized(a, b, to_check);
   }
 
   bool Equals(Tagged<String> string_1, Tagged<String> string_2,
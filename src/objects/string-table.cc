@@ -8,11 +8,13 @@
 
 #include "src/base/atomicops.h"
 #include "src/base/macros.h"
+#include "src/base/platform/yield-processor.h"
 #include "src/common/assert-scope.h"
 #include "src/common/globals.h"
 #include "src/common/ptr-compr-inl.h"
 #include "src/execution/isolate-utils-inl.h"
 #include "src/heap/safepoint.h"
+#include "src/logging/counters.h"
 #include "src/objects/internal-index.h"
 #include "src/objects/object-list-macros.h"
 #include "src/objects/slots-inl.h"
@@ -34,16 +36,14 @@ static constexpr int kStringTableMinCapacity = 2048;
 bool StringTableHasSufficientCapacityToAdd(int capacity, int number_of_elements,
                                            int number_of_deleted_elements,
                                            int number_of_additional_elements) {
-  int nof = number_of_elements + number_of_additional_elements;
-  // Return true if:
-  //   50% is still free after adding number_of_additional_elements elements and
-  //   at most 50% of the free elements are deleted elements.
-  if ((nof < capacity) &&
-      ((number_of_deleted_elements <= (capacity - nof) / 2))) {
-    int needed_free = nof / 2;
-    if (nof + needed_free <= capacity) return true;
-  }
-  return false;
+  // Insertions don't reuse deleted elements, so they take up space like live
+  // elements until the table is rebuilt.
+  int used = number_of_elements + number_of_deleted_elements +
+             number_of_additional_elements;
+  // Return true if 50% of the live and deleted elements is still free after
+  // adding number_of_additional_elements elements.
+  int needed_free = used / 2;
+  return used < capacity && used + needed_free <= capacity;
 }
 
 int ComputeStringTableCapacity(int at_least_space_for) {
@@ -69,6 +69,33 @@ int ComputeStringTableCapacityWithShrink(int current_capacity,
   return new_capacity;
 }
 
+// Returns the capacity to resize the table to before adding
+// number_of_additional_elements elements, or -1 if it can stay as it is. We
+// first try to shrink the table, if it is sufficiently empty; otherwise we make
+// sure to grow it so that it has enough space.
+int ComputeStringTableResizeCapacity(int capacity, int number_of_elements,
+                                     int number_of_deleted_elements,
+                                     int number_of_additional_elements) {
+  int nof = number_of_elements + number_of_additional_elements;
+  int capacity_after_shrinking =
+      ComputeStringTableCapacityWithShrink(capacity, nof);
+  if (capacity_after_shrinking < capacity) {
+    DCHECK(StringTableHasSufficientCapacityToAdd(
+        capacity_after_shrinking, number_of_elements, 0,
+        number_of_additional_elements));
+    return capacity_after_shrinking;
+  }
+  if (!StringTableHasSufficientCapacityToAdd(capacity, number_of_elements,
+                                             number_of_deleted_elements,
+                                             number_of_additional_elements)) {
+    // This may be the current capacity, if the table mostly consists of
+    // deleted elements, in which case resizing rebuilds the table without
+    // them.
+    return ComputeStringTableCapacity(nof);
+  }
+  return -1;
+}
+
 template <typename IsolateT, typename StringTableKey>
 bool KeyIsMatch(IsolateT* isolate, StringTableKey* key, Tagged<String> string) {
   if (string->hash() != key->hash()) return false;
@@ -88,11 +115,35 @@ bool KeyIsMatch(IsolateT* isolate, StringTableKey* key, Tagged<String> string) {
 // The elements themselves are stored as an open-addressed hash table, with
 // quadratic probing and Smi 0 and Smi 1 as the empty and deleted sentinels,
 // respectively.
+//
+// Insertions don't take a lock. An inserter first reserves room for one more
+// element in number_of_elements_, and then claims the first empty slot on the
+// probe sequence of its key by compare-and-swapping it to the reserved
+// sentinel (Smi 2), before storing its string in the slot. Slots only ever go
+// from empty to reserved to a string outside of GCs, so an inserter which
+// finds a reserved slot waits for its string, which may be equal to the key,
+// to guarantee that equal strings are never inserted twice. Deleted slots are
+// not reused for the same reason. They count towards the load factor like
+// live elements and are dropped when the table is resized, which is why a
+// table with many of them is rebuilt at the same capacity.
+//
+// Resizing is incremental and cooperative: the thread which starts a resize
+// closes the table for reservations and publishes the new table in
+// next_data_. Threads then claim chunks of kMigrationChunkSize slots and copy
+// their strings to the new table, turning each empty slot into the migrated
+// sentinel (Smi 3) so that it can't receive insertions anymore. Inserters
+// which hit the migrated sentinel help with the remaining chunks and retry on
+// the new table once it is published. None of this reaches a safepoint, so
+// GCs never see the reserved or migrated sentinels or a partial migration.
 class StringTable::Data {
  public:
+  static constexpr Tagged<Smi> reserved_element() { return Smi::FromInt(2); }
+  static constexpr Tagged<Smi> migrated_element() { return Smi::FromInt(3); }
+
+  static constexpr int kMigrationChunkSize = 256;
+  static_assert(kStringTableMinCapacity % kMigrationChunkSize == 0);
+
   static std::unique_ptr<Data> New(int capacity);
-  static std::unique_ptr<Data> Resize(PtrComprCageBase cage_base,
-                                      std::unique_ptr<Data> data, int capacity);
 
   OffHeapObjectSlot slot(InternalIndex index) const {
     return OffHeapObjectSlot(&elements_[index.as_uint32()]);
@@ -106,24 +157,47 @@ class StringTable::Data {
     slot(index).Release_Store(entry);
   }
 
-  void ElementAdded() {
-    DCHECK_LT(number_of_elements_ + 1, capacity());
-    DCHECK(StringTableHasSufficientCapacityToAdd(
-        capacity(), number_of_elements(), number_of_deleted_elements(), 1));
+  // Stores {value} at {index} if the slot still holds {expected}, and returns
+  // whether it did.
+  bool CompareAndSwap(InternalIndex index, Tagged<Object> expected,
+                      Tagged<Object> value) {
+    Tagged_t expected_value = CompressElement(expected);
+    return AsAtomicTagged::Release_CompareAndSwap(
+               &elements_[index.as_uint32()], expected_value,
+               CompressElement(value)) == expected_value;
+  }
 
-    number_of_elements_++;
+  // Reserves room for one more element, unless the table has to be resized
+  // first or is being resized.
+  bool TryReserveElement() {
+    int nof = number_of_elements_.load(std::memory_order_relaxed);
+    do {
+      if ((nof & kClosedBit) != 0) return false;
+      if (ComputeStringTableResizeCapacity(capacity_, nof,
+                                           number_of_deleted_elements_,
+                                           1) != -1) {
+        return false;
+      }
+    } while (!number_of_elements_.compare_exchange_weak(
+        nof, nof + 1, std::memory_order_relaxed));
+    return true;
+  }
+  void ReleaseReservedElement() {
+    number_of_elements_.fetch_sub(1, std::memory_order_relaxed);
   }
-  void DeletedElementOverwritten() {
-    DCHECK_LT(number_of_elements_ + 1, capacity());
+
+  void ElementAdded() {
+    DCHECK_LT(number_of_elements() + 1, capacity());
     DCHECK(StringTableHasSufficientCapacityToAdd(
-        capacity(), number_of_elements(), number_of_deleted_elements() - 1, 1));
+        capacity(), number_of_elements(), number_of_deleted_elements(), 1));
 
-    number_of_elements_++;
-    number_of_deleted_elements_--;
+    number_of_elements_.fetch_add(1, std::memory_order_relaxed);
   }
   void ElementsRemoved(int count) {
-    DCHECK_LE(count, number_of_elements_);
-    number_of_elements_ -= count;
+    DCHECK_LE(count, number_of_elements());
+    DCHECK_EQ(number_of_elements_.load(std::memory_order_relaxed) & kClosedBit,
+              0);
+    number_of_elements_.fetch_sub(count, std::memory_order_relaxed);
     number_of_deleted_elements_ += count;
   }
 
@@ -132,7 +206,10 @@ class StringTable::Data {
   void operator delete(void* description);
 
   int capacity() const { return capacity_; }
-  int number_of_elements() const { return number_of_elements_; }
+  // Includes the elements which concurrent insertions have reserved room for.
+  int number_of_elements() const {
+    return number_of_elements_.load(std::memory_order_relaxed) & ~kClosedBit;
+  }
   int number_of_deleted_elements() const { return number_of_deleted_elements_; }
 
   template <typename IsolateT, typename StringTableKey>
@@ -147,6 +224,36 @@ class StringTable::Data {
                                           StringTableKey* key,
                                           uint32_t hash) const;
 
+  // Inserts the string of {key}, for which the caller has reserved an element,
+  // unless an equal string is already present. Returns the string in the
+  // table, or a null handle if the table is being resized, in which case the
+  // reservation is dropped and the caller has to retry on the new table.
+  template <typename IsolateT, typename StringTableKey>
+  Handle<String> TryInsert(IsolateT* isolate, StringTableKey* key,
+                           Counters* counters);
+
+  // Closes the table for reservations and returns the number of elements,
+  // including the reserved ones, which the new table has to make room for.
+  int Close() {
+    int nof = number_of_elements_.fetch_or(kClosedBit,
+                                           std::memory_order_relaxed);
+    DCHECK_EQ(nof & kClosedBit, 0);
+    return nof;
+  }
+
+  Data* next_data() const { return next_data_.load(std::memory_order_acquire); }
+  void StartMigration(Data* new_data) {
+    DCHECK_NE(number_of_elements_.load(std::memory_order_relaxed) & kClosedBit,
+              0);
+    DCHECK_NULL(next_data());
+    next_data_.store(new_data, std::memory_order_release);
+  }
+
+  // Copies unclaimed chunks to next_data() until all chunks are claimed, and
+  // returns the number of chunks copied by this thread.
+  int MigrateChunks(PtrComprCageBase cage_base);
+  void WaitForMigration() const;
+
   // Helper method for StringTable::TryStringToIndexOrLookupExisting.
   template <typename Char>
   static Address TryStringToIndexOrLookupExisting(Isolate* isolate,
@@ -157,6 +264,10 @@ class StringTable::Data {
   void IterateElements(RootVisitor* visitor);
 
   Data* PreviousData() { return previous_data_.get(); }
+  void SetPreviousData(std::unique_ptr<Data> data) {
+    DCHECK_NULL(previous_data_);
+    previous_data_ = std::move(data);
+  }
   void DropPreviousData() { previous_data_.reset(); }
 
   void Print(PtrComprCageBase cage_base) const;
@@ -165,6 +276,17 @@ class StringTable::Data {
  private:
   explicit Data(int capacity);
 
+  // Set in number_of_elements_ once the table is closed for reservations.
+  static constexpr int kClosedBit = 1 << 30;
+
+  static Tagged_t CompressElement(Tagged<Object> element) {
+#ifdef V8_COMPRESS_POINTERS
+    return V8HeapCompressionScheme::CompressObject(element.ptr());
+#else
+    return element.ptr();
+#endif
+  }
+
   // Returns probe entry.
   inline static InternalIndex FirstProbe(uint32_t hash, uint32_t size) {
     return InternalIndex(hash & (size - 1));
@@ -175,9 +297,19 @@ class StringTable::Data {
     return InternalIndex((last.as_uint32() + number) & (size - 1));
   }
 
+  // Waits until the reserved slot at {index} holds a string, and returns it.
+  Tagged<Object> WaitForReservedElement(PtrComprCageBase cage_base,
+                                        InternalIndex index) const;
+
+  // Inserts {string} into a table which is being filled by a migration.
+  void InsertForMigration(PtrComprCageBase cage_base, Tagged<String> string);
+
  private:
   std::unique_ptr<Data> previous_data_;
-  int number_of_elements_;
+  std::atomic<Data*> next_data_;
+  std::atomic<int> next_chunk_;
+  std::atomic<int> migrated_chunks_;
+  std::atomic<int> number_of_elements_;
   int number_of_deleted_elements_;
   const int capacity_;
   Tagged_t elements_[1];
@@ -214,6 +346,9 @@ size_t StringTable::Data::GetCurrentMemoryUsage() const {
 
 StringTable::Data::Data(int capacity)
     : previous_data_(nullptr),
+      next_data_(nullptr),
+      next_chunk_(0),
+      migrated_chunks_(0),
       number_of_elements_(0),
       number_of_deleted_elements_(0),
       capacity_(capacity) {
@@ -225,29 +360,71 @@ std::unique_ptr<StringTable::Data> StringTable::Data::New(int capacity) {
   return std::unique_ptr<Data>(new (capacity) Data(capacity));
 }
 
-std::unique_ptr<StringTable::Data> StringTable::Data::Resize(
-    PtrComprCageBase cage_base, std::unique_ptr<Data> data, int capacity) {
-  std::unique_ptr<Data> new_data(new (capacity) Data(capacity));
+Tagged<Object> StringTable::Data::WaitForReservedElement(
+    PtrComprCageBase cage_base, InternalIndex index) const {
+  Tagged<Object> element;
+  do {
+    YIELD_PROCESSOR;
+    element = Get(cage_base, index);
+  } while (element == reserved_element());
+  return element;
+}
 
-  DCHECK_LT(data->number_of_elements(), new_data->capacity());
-  DCHECK(StringTableHasSufficientCapacityToAdd(
-      new_data->capacity(), new_data->number_of_elements(),
-      new_data->number_of_deleted_elements(), data->number_of_elements()));
+void StringTable::Data::InsertForMigration(PtrComprCageBase cage_base,
+                                           Tagged<String> string) {
+  // Only other migrating threads insert concurrently, and all of them insert
+  // different strings, so there is no need to look for equal ones.
+  uint32_t count = 1;
+  for (InternalIndex entry = FirstProbe(string->hash(), capacity_);;
+       entry = NextProbe(entry, count++, capacity_)) {
+    if (Get(cage_base, entry) == empty_element() &&
+        CompareAndSwap(entry, empty_element(), string)) {
+      return;
+    }
+  }
+}
 
-  // Rehash the elements.
-  for (InternalIndex i : InternalIndex::Range(data->capacity())) {
-    Tagged<Object> element = data->Get(cage_base, i);
-    if (element == empty_element() || element == deleted_element()) continue;
-    Tagged<String> string = String::cast(element);
-    uint32_t hash = string->hash();
-    InternalIndex insertion_index =
-        new_data->FindInsertionEntry(cage_base, hash);
-    new_data->Set(insertion_index, string);
+int StringTable::Data::MigrateChunks(PtrComprCageBase cage_base) {
+  Data* new_data = next_data();
+  DCHECK_NOT_NULL(new_data);
+  const int number_of_chunks = capacity_ / kMigrationChunkSize;
+  int migrated_chunks = 0;
+  for (int chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+       chunk < number_of_chunks;
+       chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed)) {
+    int copied_elements = 0;
+    for (int i = chunk * kMigrationChunkSize;
+         i < (chunk + 1) * kMigrationChunkSize; i++) {
+      InternalIndex entry(i);
+      Tagged<Object> element = Get(cage_base, entry);
+      while (element == empty_element() || element == reserved_element()) {
+        if (element == reserved_element()) {
+          element = WaitForReservedElement(cage_base, entry);
+        } else if (CompareAndSwap(entry, empty_element(),
+                                  migrated_element())) {
+          break;
+        } else {
+          // An inserter claimed the slot first.
+          element = Get(cage_base, entry);
+        }
+      }
+      if (!IsString(element)) continue;
+      new_data->InsertForMigration(cage_base, String::cast(element));
+      copied_elements++;
+    }
+    new_data->number_of_elements_.fetch_add(copied_elements,
+                                            std::memory_order_relaxed);
+    migrated_chunks_.fetch_add(1, std::memory_order_release);
+    migrated_chunks++;
   }
-  new_data->number_of_elements_ = data->number_of_elements();
+  return migrated_chunks;
+}
 
-  new_data->previous_data_ = std::move(data);
-  return new_data;
+void StringTable::Data::WaitForMigration() const {
+  const int number_of_chunks = capacity_ / kMigrationChunkSize;
+  while (migrated_chunks_.load(std::memory_order_acquire) < number_of_chunks) {
+    YIELD_PROCESSOR;
+  }
 }
 
 template <typename IsolateT, typename StringTableKey>
@@ -261,8 +438,15 @@ InternalIndex StringTable::Data::FindEntry(IsolateT* isolate,
     // TODO(leszeks): Consider delaying the decompression until after the
     // comparisons against empty/deleted.
     Tagged<Object> element = Get(isolate, entry);
-    if (element == empty_element()) return InternalIndex::NotFound();
-    if (element == deleted_element()) continue;
+    // A migrated slot was empty when the table was closed for insertions.
+    if (element == empty_element() || element == migrated_element()) {
+      return InternalIndex::NotFound();
+    }
+    // Skipping a reserved slot can at worst miss a string which is being
+    // inserted concurrently.
+    if (element == deleted_element() || element == reserved_element()) {
+      continue;
+    }
     Tagged<String> string = String::cast(element);
     if (KeyIsMatch(isolate, key, string)) return entry;
   }
@@ -311,6 +495,48 @@ InternalIndex StringTable::Data::FindEntryOrInsertionEntry(
   }
 }
 
+template <typename IsolateT, typename StringTableKey>
+Handle<String> StringTable::Data::TryInsert(IsolateT* isolate,
+                                            StringTableKey* key,
+                                            Counters* counters) {
+  uint32_t count = 1;
+  // The reservation guarantees that the hash table is never full.
+  for (InternalIndex entry = FirstProbe(key->hash(), capacity_);;
+       entry = NextProbe(entry, count++, capacity_)) {
+    Tagged<Object> element = Get(isolate, entry);
+    while (element == empty_element() || element == reserved_element()) {
+      if (element == reserved_element()) {
+        // Another thread is about to store a string, which may be equal to
+        // the key, in this slot.
+        counters->string_table_insert_waits()->Increment();
+        element = WaitForReservedElement(isolate, entry);
+      } else if (CompareAndSwap(entry, empty_element(), reserved_element())) {
+        // The slot is ours. No equal string can be inserted before the store
+        // below, so in-place internalization can transition the map now.
+        Handle<String> new_string = key->GetHandleForInsertion();
+        DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
+        Set(entry, *new_string);
+        return new_string;
+      } else {
+        counters->string_table_insert_cas_failures()->Increment();
+        element = Get(isolate, entry);
+      }
+    }
+
+    if (element == migrated_element()) {
+      ReleaseReservedElement();
+      return Handle<String>();
+    }
+    if (element == deleted_element()) continue;
+
+    Tagged<String> string = String::cast(element);
+    if (KeyIsMatch(isolate, key, string)) {
+      ReleaseReservedElement();
+      return handle(string, isolate);
+    }
+  }
+}
+
 void StringTable::Data::IterateElements(RootVisitor* visitor) {
   OffHeapObjectSlot first_slot = slot(InternalIndex(0));
   OffHeapObjectSlot end_slot = slot(InternalIndex(capacity_));
@@ -336,10 +562,7 @@ int StringTable::Capacity() const {
   return data_.load(std::memory_order_acquire)->capacity();
 }
 int StringTable::NumberOfElements() const {
-  {
-    base::MutexGuard table_write_guard(&write_mutex_);
-    return data_.load(std::memory_order_relaxed)->number_of_elements();
-  }
+  return data_.load(std::memory_order_acquire)->number_of_elements();
 }
 
 // InternalizedStringKey carries a string/internalized-string object as key.
@@ -425,7 +648,7 @@ class InternalizedStringKey final : public StringTableKey {
       // It is always safe to overwrite the map. The only transition possible
       // is another thread migrated the string to internalized already.
       // Migrations to thin are impossible, as we only call this method on table
-      // misses inside the critical section.
+      // misses, after claiming the slot for the string.
       string_->set_map_safe_transition_no_write_barrier(*internalized_map);
       DCHECK(IsInternalizedString(*string_));
       return string_;
@@ -519,8 +742,8 @@ Handle<String> StringTable::LookupString(Isolate* isolate,
   //  - In-place internalizable strings do not incur a copy regardless of string
   //    table sharing. The map mutation is threadsafe even with relaxed memory
   //    order, because for concurrent table lookups, the "losing" thread will be
-  //    correctly ordered by LookupKey's write mutex and see the updated map
-  //    during the re-lookup.
+  //    correctly ordered by the compare-and-swap of the table slot in
+  //    LookupKey and see the updated map during the re-lookup.
   //
   // For lookup misses, the internalized string map is the same map in RO space
   // regardless of which thread is doing the lookup.
@@ -557,16 +780,16 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
   //
   //   - The Heap access is allowed to be concurrent (using LocalHeap or
   //     similar),
-  //   - All writes to the string table are guarded by the Isolate string table
-  //     mutex,
-  //   - Resizes of the string table first copies the old contents to the new
-  //     table, and only then sets the new string table pointer to the new
+  //   - Writes to the string table only claim empty slots with a
+  //     compare-and-swap (see StringTable::Data),
+  //   - Resizes of the string table first copy the old contents to the new
+  //     table, and only then set the new string table pointer to the new
   //     table,
   //   - Only GCs can remove elements from the string table.
   //
   // These assumptions allow us to make the following statement:
   //
-  //   "Reads are allowed when not holding the lock, as long as false negatives
+  //   "Reads are allowed without synchronization, as long as false negatives
   //    (misses) are ok. We will never get a false positive (hit of an entry no
   //    longer in the table)"
   //
@@ -575,17 +798,17 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
   // for strong consistency of internalized string equality implying reference
   // equality.
   //
-  // We therefore try to optimistically read from the string table without
-  // taking the lock (both here and in the NoAllocate version of the lookup),
-  // and on a miss we take the lock and try to write the entry, with a second
-  // read lookup in case the non-locked read missed a write.
+  // We therefore first read from the string table (both here and in the
+  // NoAllocate version of the lookup), and on a miss try to claim a slot for
+  // the entry, which finds the entry after all if another thread inserted it
+  // in the meantime.
   //
-  // One complication is allocation -- we don't want to allocate while holding
-  // the string table lock. This applies to both allocation of new strings, and
-  // re-allocation of the string table on resize. So, we optimistically allocate
-  // (without copying values) outside the lock, and potentially discard the
-  // allocation if another write also did an allocation. This assumes that
-  // writes are rarer than reads.
+  // One complication is allocation -- we don't want to allocate while a slot
+  // is claimed, or while the table is being resized. This applies to both
+  // allocation of new strings, and re-allocation of the string table on
+  // resize. So, we optimistically allocate (without copying values) before
+  // inserting, and potentially discard the allocation if another write also
+  // did an allocation. This assumes that writes are rarer than reads.
 
   // Load the current string table data, in case another thread updates the
   // data while we're reading.
@@ -606,36 +829,22 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
 
   // No entry found, so adding new string.
   key->PrepareForInsertion(isolate);
-  {
-    base::MutexGuard table_write_guard(&write_mutex_);
-
-    Data* data = EnsureCapacity(isolate, 1);
-
-    // Check one last time if the key is present in the table, in case it was
-    // added after the check.
-    entry = data->FindEntryOrInsertionEntry(isolate, key, key->hash());
-
-    Tagged<Object> element = data->Get(isolate, entry);
-    if (element == empty_element()) {
-      // This entry is empty, so write it and register that we added an
-      // element.
-      Handle<String> new_string = key->GetHandleForInsertion();
-      DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
-      data->Set(entry, *new_string);
-      data->ElementAdded();
-      return new_string;
-    } else if (element == deleted_element()) {
-      // This entry was deleted, so overwrite it and register that we
-      // overwrote a deleted element.
-      Handle<String> new_string = key->GetHandleForInsertion();
-      DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
-      data->Set(entry, *new_string);
-      data->DeletedElementOverwritten();
-      return new_string;
-    } else {
-      // Return the existing string as a handle.
-      return handle(String::cast(element), isolate);
+  Counters* counters = isolate_->counters();
+  while (true) {
+    Data* data = data_.load(std::memory_order_acquire);
+    if (!data->TryReserveElement()) {
+      if (data->next_data() != nullptr) {
+        HelpResize(isolate, data);
+      } else {
+        base::MutexGuard table_write_guard(&write_mutex_);
+        EnsureCapacity(isolate, 1);
+      }
+      continue;
     }
+
+    Handle<String> result = data->TryInsert(isolate, key, counters);
+    if (!result.is_null()) return result;
+    HelpResize(isolate, data);
   }
 }
 
@@ -667,39 +876,55 @@ StringTable::Data* StringTable::EnsureCapacity(PtrComprCageBase cage_base,
   // the lock is held.
   Data* data = data_.load(std::memory_order_relaxed);
 
-  // Grow or shrink table if needed. We first try to shrink the table, if it
-  // is sufficiently empty; otherwise we make sure to grow it so that it has
-  // enough space.
-  int current_capacity = data->capacity();
-  int current_nof = data->number_of_elements();
-  int capacity_after_shrinking = ComputeStringTableCapacityWithShrink(
-      current_capacity, current_nof + additional_elements);
+  int new_capacity = ComputeStringTableResizeCapacity(
+      data->capacity(), data->number_of_elements(),
+      data->number_of_deleted_elements(), additional_elements);
+  if (new_capacity == -1) return data;
+
+  // Stop reservations, so that the new table is large enough for all strings
+  // which are inserted into the old one until it is migrated.
+  int current_nof = data->Close();
+  new_capacity =
+      std::max(new_capacity,
+               ComputeStringTableCapacity(current_nof + additional_elements));
+  return Resize(cage_base, data, new_capacity);
+}
 
-  int new_capacity = -1;
-  if (capacity_after_shrinking < current_capacity) {
-    DCHECK(StringTableHasSufficientCapacityToAdd(
-        capacity_after_shrinking, current_nof, 0, additional_elements));
-    new_capacity = capacity_after_shrinking;
-  } else if (!StringTableHasSufficientCapacityToAdd(
-                 current_capacity, current_nof,
-                 data->number_of_deleted_elements(), additional_elements)) {
-    new_capacity =
-        ComputeStringTableCapacity(current_nof + additional_elements);
-  }
-
-  if (new_capacity != -1) {
-    std::unique_ptr<Data> new_data =
-        Data::Resize(cage_base, std::unique_ptr<Data>(data), new_capacity);
-    // `new_data` is the new owner of `data`.
-    DCHECK_EQ(new_data->PreviousData(), data);
-    // Release-store the new data pointer as `data_`, so that it can be
-    // acquire-loaded by other threads. This string table becomes the owner of
-    // the pointer.
-    data = new_data.release();
-    data_.store(data, std::memory_order_release);
-  }
-
-  return data;
+StringTable::Data* StringTable::Resize(PtrComprCageBase cage_base, Data* data,
+                                       int capacity) {
+  write_mutex_.AssertHeld();
+
+  std::unique_ptr<Data> new_data = Data::New(capacity);
+  data->StartMigration(new_data.get());
+  data->MigrateChunks(cage_base);
+  // Wait for the chunks claimed by concurrent inserters.
+  data->WaitForMigration();
+
+  DCHECK_LT(new_data->number_of_elements(), new_data->capacity());
+  DCHECK(StringTableHasSufficientCapacityToAdd(
+      new_data->capacity(), new_data->number_of_elements(),
+      new_data->number_of_deleted_elements(), 0));
+  // `new_data` is the new owner of `data`.
+  new_data->SetPreviousData(std::unique_ptr<Data>(data));
+  // Release-store the new data pointer as `data_`, so that it can be
+  // acquire-loaded by other threads. This string table becomes the owner of
+  // the pointer.
+  Data* result = new_data.release();
+  data_.store(result, std::memory_order_release);
+  isolate_->counters()->string_table_resizes()->Increment();
+  return result;
+}
+
+void StringTable::HelpResize(PtrComprCageBase cage_base, Data* data) {
+  int migrated_chunks = data->MigrateChunks(cage_base);
+  isolate_->counters()->string_table_resize_chunks_helped()->Increment(
+      migrated_chunks);
+  // The thread which started the resize publishes the new table once all
+  // chunks are migrated. The old table can't be freed in the meantime, as
+  // that needs a GC.
+  while (data_.load(std::memory_order_acquire) == data) {
+    YIELD_PROCESSOR;
+  }
 }
 
 // static
@@ -41,7 +41,8 @@ class StringTableKey {
 class SeqOneByteString;
 
 // StringTable, for internalizing strings. The Lookup methods are designed to be
-// thread-safe, in combination with GC safepoints.
+// thread-safe, in combination with GC safepoints. Insertions don't take a lock,
+// and resizes are done cooperatively by all inserting threads.
 //
 // The string table layout is defined by its Data implementation class, see
 // StringTable::Data for details.
@@ -82,8 +83,7 @@ class V8_EXPORT_PRIVATE StringTable {
   void Print(PtrComprCageBase cage_base) const;
   size_t GetCurrentMemoryUsage() const;
 
-  // The following methods must be called either while holding the write lock,
-  // or while in a Heap safepoint.
+  // The following methods must be called while in a Heap safepoint.
   void IterateElements(RootVisitor* visitor);
   void DropOldData();
   void NotifyElementsRemoved(int count);
@@ -94,11 +94,15 @@ class V8_EXPORT_PRIVATE StringTable {
   class Data;
 
   Data* EnsureCapacity(PtrComprCageBase cage_base, int additional_elements);
+  Data* Resize(PtrComprCageBase cage_base, Data* data, int capacity);
+  // Helps migrating {data} to its resized copy, and returns once the copy has
+  // replaced it.
+  void HelpResize(PtrComprCageBase cage_base, Data* data);
 
   std::atomic<Data*> data_;
-  // Write mutex is mutable so that readers of concurrently mutated values (e.g.
-  // NumberOfElements) are allowed to lock it while staying const.
-  mutable base::Mutex write_mutex_;
+  // Write mutex serializes starting resizes and the insertions during isolate
+  // setup, which don't go through LookupKey.
+  base::Mutex write_mutex_;
   Isolate* isolate_;
 };
 
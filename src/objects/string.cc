@@ -23,6 +23,7 @@
 #include "src/objects/string-inl.h"
 #include "src/strings/char-predicates.h"
 #include "src/strings/string-builder-inl.h"
+#include "src/strings/string-compare-simd.h"
 #include "src/strings/string-hasher.h"
 #include "src/strings/string-search.h"
 #include "src/strings/string-stream.h"
@@ -298,15 +299,19 @@ bool String::MarkForExternalizationDuringGC(Isolate* isolate, T* resource) {
 
 namespace {
 
+// Resources which are not cacheable need an uncached external string, which
+// asks the resource for its data on every access.
 template <bool is_one_byte>
 Tagged<Map> ComputeExternalStringMap(Isolate* isolate, Tagged<String> string,
-                                     int size) {
+                                     int size, bool is_cacheable) {
   ReadOnlyRoots roots(isolate);
   StringShape shape(string, isolate);
   const bool is_internalized = shape.IsInternalized();
   const bool is_shared = shape.IsShared();
+  const bool is_uncached =
+      size < ExternalString::kSizeOfAllExternalStrings || !is_cacheable;
   if constexpr (is_one_byte) {
-    if (size < ExternalString::kSizeOfAllExternalStrings) {
+    if (is_uncached) {
       if (is_internalized) {
         return roots.uncached_external_internalized_one_byte_string_map();
       } else {
@@ -322,7 +327,7 @@ Tagged<Map> ComputeExternalStringMap(Isolate* isolate, Tagged<String> string,
       }
     }
   } else {
-    if (size < ExternalString::kSizeOfAllExternalStrings) {
+    if (is_uncached) {
       if (is_internalized) {
         return roots.uncached_external_internalized_two_byte_string_map();
       } else {
@@ -359,7 +364,8 @@ void String::MakeExternalDuringGC(Isolate* isolate, T* resource) {
   // the address of the backing store.  When we encounter uncached external
   // strings in generated code, we need to bailout to runtime.
   Tagged<Map> new_map =
-      ComputeExternalStringMap<is_one_byte>(isolate, *this, size);
+      ComputeExternalStringMap<is_one_byte>(isolate, *this, size,
+                                            resource->IsCacheable());
 
   // Byte size of the external String object.
   int new_size = this->SizeFromMap(new_map);
@@ -407,7 +413,6 @@ bool String::MakeExternal(v8::String::ExternalStringResource* resource) {
   // prohibited by the API.
   DCHECK(
       this->SupportsExternalization(v8::String::Encoding::TWO_BYTE_ENCODING));
-  DCHECK(resource->IsCacheable());
 #ifdef ENABLE_SLOW_DCHECKS
   if (v8_flags.enable_slow_asserts) {
     // Assert that the resource and the string are equivalent.
@@ -443,7 +448,8 @@ bool String::MakeExternal(v8::String::ExternalStringResource* resource) {
   // strings in generated code, we need to bailout to runtime.
   constexpr bool is_one_byte = false;
   Tagged<Map> new_map =
-      ComputeExternalStringMap<is_one_byte>(isolate, *this, size);
+      ComputeExternalStringMap<is_one_byte>(isolate, *this, size,
+                                            resource->IsCacheable());
 
   // Byte size of the external String object.
   int new_size = this->SizeFromMap(new_map);
@@ -491,7 +497,6 @@ bool String::MakeExternal(v8::String::ExternalOneByteStringResource* resource) {
   // prohibited by the API.
   DCHECK(
       this->SupportsExternalization(v8::String::Encoding::ONE_BYTE_ENCODING));
-  DCHECK(resource->IsCacheable());
 #ifdef ENABLE_SLOW_DCHECKS
   if (v8_flags.enable_slow_asserts) {
     // Assert that the resource and the string are equivalent.
@@ -532,7 +537,8 @@ bool String::MakeExternal(v8::String::ExternalOneByteStringResource* resource) {
   // strings in generated code, we need to bailout to runtime.
   constexpr bool is_one_byte = true;
   Tagged<Map> new_map =
-      ComputeExternalStringMap<is_one_byte>(isolate, *this, size);
+      ComputeExternalStringMap<is_one_byte>(isolate, *this, size,
+                                            resource->IsCacheable());
 
   if (!isolate->heap()->IsLargeObject(*this)) {
     // Byte size of the external String object.
@@ -1198,11 +1204,13 @@ bool String::SlowEquals(Isolate* isolate, Handle<String> one,
     return CompareCharsEqual(flat1.ToUC16Vector().begin(),
                              flat2.ToUC16Vector().begin(), one_length);
   } else if (flat1.IsOneByte() && flat2.IsTwoByte()) {
-    return CompareCharsEqual(flat1.ToOneByteVector().begin(),
-                             flat2.ToUC16Vector().begin(), one_length);
+    return CompareCharsEqualVectorized(flat1.ToOneByteVector().begin(),
+                                       flat2.ToUC16Vector().begin(),
+                                       one_length);
   } else if (flat1.IsTwoByte() && flat2.IsOneByte()) {
-    return CompareCharsEqual(flat1.ToUC16Vector().begin(),
-                             flat2.ToOneByteVector().begin(), one_length);
+    return CompareCharsEqualVectorized(flat1.ToUC16Vector().begin(),
+                                       flat2.ToOneByteVector().begin(),
+                                       one_length);
   }
   UNREACHABLE();
 }
@@ -1247,19 +1255,23 @@ ComparisonResult String::Compare(Isolate* isolate, Handle<String> x,
     base::Vector<const uint8_t> x_chars = x_content.ToOneByteVector();
     if (y_content.IsOneByte()) {
       base::Vector<const uint8_t> y_chars = y_content.ToOneByteVector();
-      r = CompareChars(x_chars.begin(), y_chars.begin(), prefix_length);
+      r = CompareCharsVectorized(x_chars.begin(), y_chars.begin(),
+                                 prefix_length);
     } else {
       base::Vector<const base::uc16> y_chars = y_content.ToUC16Vector();
-      r = CompareChars(x_chars.begin(), y_chars.begin(), prefix_length);
+      r = CompareCharsVectorized(x_chars.begin(), y_chars.begin(),
+                                 prefix_length);
     }
   } else {
     base::Vector<const base::uc16> x_chars = x_content.ToUC16Vector();
     if (y_content.IsOneByte()) {
       base::Vector<const uint8_t> y_chars = y_content.ToOneByteVector();
-      r = CompareChars(x_chars.begin(), y_chars.begin(), prefix_length);
+      r = CompareCharsVectorized(x_chars.begin(), y_chars.begin(),
+                                 prefix_length);
     } else {
       base::Vector<const base::uc16> y_chars = y_content.ToUC16Vector();
-      r = CompareChars(x_chars.begin(), y_chars.begin(), prefix_length);
+      r = CompareCharsVectorized(x_chars.begin(), y_chars.begin(),
+                                 prefix_length);
     }
   }
   if (r < 0) {
@@ -1318,8 +1330,146 @@ int SearchString(Isolate* isolate, String::FlatContent receiver_content,
                       start_index);
 }
 
+// Searches the segments of a cons string for a pattern one after the other.
+// A match which spans several segments is found in `carry_`, which holds the
+// characters before the current segment from which a match may still begin
+// (at most pattern length - 1), followed by further characters. Segments which
+// are shorter than that are collected in the carry until it holds enough new
+// characters, so that the carry is searched at most once per pattern length
+// - 1 characters of the subject.
+template <typename PatternChar>
+class SegmentedStringSearch {
+ public:
+  SegmentedStringSearch(Isolate* isolate,
+                        base::Vector<const PatternChar> pattern)
+      : pattern_(pattern),
+        one_byte_search_(isolate, pattern),
+        two_byte_search_(isolate, pattern) {}
+
+  int Search(Tagged<ConsString> subject, int start_index,
+             const DisallowGarbageCollection& no_gc) {
+    ConsStringIterator iter(subject, start_index);
+    // The index in {subject} of the current segment, after {offset}.
+    int index = start_index;
+    int offset;
+    for (Tagged<String> segment = iter.Next(&offset); !segment.is_null();
+         segment = iter.Next(&offset)) {
+      String::FlatContent content = segment->GetFlatContent(no_gc);
+      DCHECK(content.IsFlat());
+      int result;
+      if (content.IsOneByte()) {
+        result = SearchSegment(&one_byte_search_,
+                               content.ToOneByteVector().SubVectorFrom(offset),
+                               index);
+      } else {
+        result = SearchSegment(&two_byte_search_,
+                               content.ToUC16Vector().SubVectorFrom(offset),
+                               index);
+      }
+      if (result != -1) return result;
+      index += content.length() - offset;
+    }
+    // Search the characters collected from short segments at the end.
+    return SearchCarry(index, carry_.size());
+  }
+
+ private:
+  // Searches the carry, which ends at {end_index} in the subject, for a match
+  // which starts within its first {max_start} characters.
+  int SearchCarry(int end_index, size_t max_start) {
+    const size_t pattern_length = pattern_.size();
+    if (carry_.size() < pattern_length || max_start == 0) return -1;
+    const size_t length =
+        std::min(carry_.size(), max_start - 1 + pattern_length);
+    int result = two_byte_search_.Search(
+        base::Vector<const base::uc16>(carry_.data(), length), 0);
+    if (result == -1 || static_cast<size_t>(result) >= max_start) return -1;
+    return end_index - static_cast<int>(carry_.size()) + result;
+  }
+
+  // Keeps the last pattern length - 1 characters in the carry, from which a
+  // match may begin that ends in the next segments.
+  void TrimCarry() {
+    const size_t max_carry_length = pattern_.size() - 1;
+    if (carry_.size() <= max_carry_length) return;
+    size_t dropped = carry_.size() - max_carry_length;
+    std::copy(carry_.begin() + dropped, carry_.end(), carry_.begin());
+    carry_.pop_back(dropped);
+  }
+
+  template <typename SubjectChar>
+  int SearchSegment(StringSearch<PatternChar, SubjectChar>* search,
+                    base::Vector<const SubjectChar> segment, int index) {
+    const size_t max_carry_length = pattern_.size() - 1;
+    const int segment_length = segment.length();
+    if (segment.size() < max_carry_length) {
+      // Collect short segments until the carry holds at least pattern length
+      // - 1 characters in addition to those carried over, and search it then.
+      carry_.insert(carry_.end(), segment.begin(), segment.end());
+      if (carry_.size() < 2 * max_carry_length) return -1;
+      int result = SearchCarry(index + segment_length,
+                               carry_.size() - max_carry_length);
+      if (result != -1) return result;
+      TrimCarry();
+      return -1;
+    }
+
+    // Only matches which begin in the carried characters are looked for in
+    // the carry, as all others are found in the segment itself.
+    const size_t carry_length = carry_.size();
+    carry_.insert(carry_.end(), segment.begin(),
+                  segment.begin() + max_carry_length);
+    int result =
+        SearchCarry(index + static_cast<int>(max_carry_length), carry_length);
+    if (result != -1) return result;
+    if (segment.size() >= pattern_.size()) {
+      result = search->Search(segment, 0);
+      if (result != -1) return index + result;
+    }
+    carry_.clear();
+    carry_.insert(carry_.end(), segment.end() - max_carry_length,
+                  segment.end());
+    return -1;
+  }
+
+  base::Vector<const PatternChar> pattern_;
+  StringSearch<PatternChar, uint8_t> one_byte_search_;
+  StringSearch<PatternChar, base::uc16> two_byte_search_;
+  base::SmallVector<base::uc16, 32> carry_;
+};
+
+template <typename PatternChar>
+int SearchRope(Isolate* isolate, Tagged<ConsString> subject,
+               base::Vector<const PatternChar> pattern, int start_index,
+               const DisallowGarbageCollection& no_gc) {
+  SegmentedStringSearch<PatternChar> segmented_search(isolate, pattern);
+  return segmented_search.Search(subject, start_index, no_gc);
+}
+
 }  // namespace
 
+// static
+intptr_t String::SearchInRope(Isolate* isolate, Address raw_receiver,
+                              Address raw_search, intptr_t start_index) {
+  DisallowGarbageCollection no_gc;
+  Tagged<ConsString> receiver = ConsString::cast(Tagged<Object>(raw_receiver));
+  Tagged<String> search = String::cast(Tagged<Object>(raw_search));
+  DCHECK_LE(0, start_index);
+  DCHECK_LE(start_index + static_cast<intptr_t>(search->length()),
+            static_cast<intptr_t>(receiver->length()));
+  DCHECK_LT(0, search->length());
+  // Flattening the pattern would allocate.
+  if (!search->IsFlat()) return kSearchInRopeUnsupported;
+  String::FlatContent search_content = search->GetFlatContent(no_gc);
+  int index = static_cast<int>(start_index);
+  if (search_content.IsOneByte()) {
+    return SearchRope(isolate, receiver, search_content.ToOneByteVector(),
+                      index, no_gc);
+  }
+  return SearchRope(isolate, receiver, search_content.ToUC16Vector(), index,
+                    no_gc);
+}
+
 int String::IndexOf(Isolate* isolate, Handle<String> receiver,
                     Handle<String> search, int start_index) {
   DCHECK_LE(0, start_index);
@@ -1331,8 +1481,14 @@ int String::IndexOf(Isolate* isolate, Handle<String> receiver,
   uint32_t receiver_length = receiver->length();
   if (start_index + search_length > receiver_length) return -1;
 
-  receiver = String::Flatten(isolate, receiver);
   search = String::Flatten(isolate, search);
+  if (receiver_length >=
+          static_cast<uint32_t>(kMinLengthForSegmentedSearch) &&
+      IsConsString(*receiver) && !receiver->IsFlat()) {
+    return static_cast<int>(SearchInRope(isolate, receiver->ptr(),
+                                         search->ptr(), start_index));
+  }
+  receiver = String::Flatten(isolate, receiver);
 
   DisallowGarbageCollection no_gc;  // ensure vectors stay valid
   // Extract flattened substrings of cons strings before getting encoding.
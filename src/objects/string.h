@@ -324,6 +324,15 @@ class String : public TorqueGeneratedString<String, Name> {
   static int IndexOf(Isolate* isolate, Handle<String> receiver,
                      Handle<String> search, int start_index);
 
+  // Searches a cons string of at least kMinLengthForSegmentedSearch characters
+  // segment by segment, without flattening it. Does not allocate, so that it
+  // can be called from builtins. Returns kSearchInRopeUnsupported if {search}
+  // is not flat. {search} must not be empty and fit into {receiver} after
+  // {start_index}.
+  static intptr_t SearchInRope(Isolate* isolate, Address receiver,
+                               Address search, intptr_t start_index);
+  static constexpr intptr_t kSearchInRopeUnsupported = -2;
+
   static Tagged<Object> LastIndexOf(Isolate* isolate, Handle<Object> receiver,
                                     Handle<Object> search,
                                     Handle<Object> position);
@@ -518,6 +527,11 @@ class String : public TorqueGeneratedString<String, Name> {
   // Limit for truncation in short printing.
   static const int kMaxShortPrintLength = 1024;
 
+  // Cons strings of at least this length are searched by IndexOf segment by
+  // segment. Flattening them would copy all characters, and the string would
+  // take twice its memory until the segments are collected.
+  static const int kMinLengthForSegmentedSearch = 256 * KB;
+
   // Helper function for flattening strings.
   template <typename sinkchar>
   EXPORT_TEMPLATE_DECLARE(V8_EXPORT_PRIVATE)
@@ -38,7 +38,7 @@ class CanBeHandledVisitor final : private RegExpVisitor {
     // future.
     static constexpr RegExpFlags kAllowedFlags =
         RegExpFlag::kGlobal | RegExpFlag::kSticky | RegExpFlag::kMultiline |
-        RegExpFlag::kDotAll | RegExpFlag::kLinear;
+        RegExpFlag::kDotAll | RegExpFlag::kLinear | RegExpFlag::kIgnoreCase;
     // We support Unicode iff kUnicode is among the supported flags.
     static_assert(ExperimentalRegExp::kSupportsUnicode ==
                   IsUnicode(kAllowedFlags));
@@ -186,6 +186,96 @@ class CanBeHandledVisitor final : private RegExpVisitor {
   bool result_ = true;
 };
 
+class NestedQuantifierVisitor final : private RegExpVisitor {
+  // Visitor to implement
+  // `ExperimentalRegExpCompiler::MayBacktrackExponentially`.
+ public:
+  static bool Check(RegExpTree* tree) {
+    NestedQuantifierVisitor visitor;
+    tree->Accept(&visitor, nullptr);
+    return visitor.result_;
+  }
+
+ private:
+  NestedQuantifierVisitor() = default;
+
+  void* VisitDisjunction(RegExpDisjunction* node, void*) override {
+    for (RegExpTree* alt : *node->alternatives()) {
+      if (result_) return nullptr;
+      alt->Accept(this, nullptr);
+    }
+    return nullptr;
+  }
+
+  void* VisitAlternative(RegExpAlternative* node, void*) override {
+    for (RegExpTree* child : *node->nodes()) {
+      if (result_) return nullptr;
+      child->Accept(this, nullptr);
+    }
+    return nullptr;
+  }
+
+  void* VisitQuantifier(RegExpQuantifier* node, void*) override {
+    // Quantifiers whose body only matches the empty string don't cause
+    // backtracking, since empty iterations are rejected.
+    if (node->max() != RegExpTree::kInfinity ||
+        node->body()->max_match() == 0) {
+      node->body()->Accept(this, nullptr);
+      return nullptr;
+    }
+    if (in_unbounded_quantifier_) {
+      result_ = true;
+      return nullptr;
+    }
+    in_unbounded_quantifier_ = true;
+    node->body()->Accept(this, nullptr);
+    in_unbounded_quantifier_ = false;
+    return nullptr;
+  }
+
+  void* VisitCapture(RegExpCapture* node, void*) override {
+    return node->body()->Accept(this, nullptr);
+  }
+
+  void* VisitGroup(RegExpGroup* node, void*) override {
+    return node->body()->Accept(this, nullptr);
+  }
+
+  void* VisitLookaround(RegExpLookaround* node, void*) override {
+    return node->body()->Accept(this, nullptr);
+  }
+
+  void* VisitClassRanges(RegExpClassRanges* node, void*) override {
+    return nullptr;
+  }
+
+  void* VisitClassSetOperand(RegExpClassSetOperand* node, void*) override {
+    return nullptr;
+  }
+
+  void* VisitClassSetExpression(RegExpClassSetExpression* node,
+                                void*) override {
+    return nullptr;
+  }
+
+  void* VisitAssertion(RegExpAssertion* node, void*) override {
+    return nullptr;
+  }
+
+  void* VisitAtom(RegExpAtom* node, void*) override { return nullptr; }
+
+  void* VisitText(RegExpText* node, void*) override { return nullptr; }
+
+  void* VisitBackReference(RegExpBackReference* node, void*) override {
+    return nullptr;
+  }
+
+  void* VisitEmpty(RegExpEmpty* node, void*) override { return nullptr; }
+
+  bool in_unbounded_quantifier_ = false;
+  bool result_ = false;
+};
+
 }  // namespace
 
 bool ExperimentalRegExpCompiler::CanBeHandled(RegExpTree* tree,
@@ -194,6 +284,10 @@ bool ExperimentalRegExpCompiler::CanBeHandled(RegExpTree* tree,
   return CanBeHandledVisitor::Check(tree, flags, capture_count);
 }
 
+bool ExperimentalRegExpCompiler::MayBacktrackExponentially(RegExpTree* tree) {
+  return NestedQuantifierVisitor::Check(tree);
+}
+
 namespace {
 
 // A label in bytecode which starts with no known address. The address *must*
@@ -313,9 +407,10 @@ class BytecodeAssembler {
 
 class CompileVisitor : private RegExpVisitor {
  public:
-  static ZoneList<RegExpInstruction> Compile(RegExpTree* tree,
+  static ZoneList<RegExpInstruction> Compile(Isolate* isolate,
+                                             RegExpTree* tree,
                                              RegExpFlags flags, Zone* zone) {
-    CompileVisitor compiler(zone);
+    CompileVisitor compiler(isolate, flags, zone);
 
     if (!IsSticky(flags) && !tree->IsAnchoredAtStart()) {
       // The match is not anchored, i.e. may start at any input position, so we
@@ -334,7 +429,11 @@ class CompileVisitor : private RegExpVisitor {
   }
 
  private:
-  explicit CompileVisitor(Zone* zone) : zone_(zone), assembler_(zone) {}
+  CompileVisitor(Isolate* isolate, RegExpFlags flags, Zone* zone)
+      : isolate_(isolate),
+        ignore_case_(IsIgnoreCase(flags)),
+        zone_(zone),
+        assembler_(zone) {}
 
   // Generate a disjunction of code fragments compiled by a function `alt_gen`.
   // `alt_gen` is called repeatedly with argument `int i = 0, 1, ..., alt_num -
@@ -405,6 +504,12 @@ class CompileVisitor : private RegExpVisitor {
 
   void CompileCharacterRanges(ZoneList<CharacterRange>* ranges, bool negated) {
     // A character class is compiled as Disjunction over its `CharacterRange`s.
+    // Without the unicode flag, case-insensitive matching is the same as
+    // matching the case equivalents of the class as well.
+    static_assert(!ExperimentalRegExp::kSupportsUnicode);
+    if (ignore_case_) {
+      CharacterRange::AddCaseEquivalents(isolate_, zone_, ranges, false);
+    }
     CharacterRange::Canonicalize(ranges);
     if (negated) {
       // The complement of a disjoint, non-adjacent (i.e. `Canonicalize`d)
@@ -455,7 +560,14 @@ class CompileVisitor : private RegExpVisitor {
 
   void* VisitAtom(RegExpAtom* node, void*) override {
     for (base::uc16 c : node->data()) {
-      assembler_.ConsumeRange(c, c);
+      if (ignore_case_) {
+        ZoneList<CharacterRange>* ranges =
+            zone_->New<ZoneList<CharacterRange>>(1, zone_);
+        ranges->Add(CharacterRange::Singleton(c), zone_);
+        CompileCharacterRanges(ranges, false);
+      } else {
+        assembler_.ConsumeRange(c, c);
+      }
     }
     return nullptr;
   }
@@ -782,6 +894,8 @@ class CompileVisitor : private RegExpVisitor {
   }
 
  private:
+  Isolate* isolate_;
+  const bool ignore_case_;
   Zone* zone_;
   BytecodeAssembler assembler_;
 };
@@ -789,8 +903,8 @@ class CompileVisitor : private RegExpVisitor {
 }  // namespace
 
 ZoneList<RegExpInstruction> ExperimentalRegExpCompiler::Compile(
-    RegExpTree* tree, RegExpFlags flags, Zone* zone) {
-  return CompileVisitor::Compile(tree, flags, zone);
+    Isolate* isolate, RegExpTree* tree, RegExpFlags flags, Zone* zone) {
+  return CompileVisitor::Compile(isolate, tree, flags, zone);
 }
 
 }  // namespace internal
@@ -25,8 +25,13 @@ class ExperimentalRegExpCompiler final : public AllStatic {
   // Compile regexp into a bytecode program.  The regexp must be handlable by
   // the experimental engine; see`CanBeHandled`.  The program is returned as a
   // ZoneList backed by the same Zone that is used in the RegExpTree argument.
-  static ZoneList<RegExpInstruction> Compile(RegExpTree* tree,
+  static ZoneList<RegExpInstruction> Compile(Isolate* isolate,
+                                             RegExpTree* tree,
                                              RegExpFlags flags, Zone* zone);
+  // Whether a backtracking engine may take exponential time on the regexp,
+  // which is approximated by an unbounded quantifier nested in another one,
+  // as in /(a+)+b/.
+  static bool MayBacktrackExponentially(RegExpTree* tree);
 };
 
 }  // namespace internal
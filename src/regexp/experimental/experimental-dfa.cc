@@ -0,0 +1,265 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/regexp/experimental/experimental-dfa.h"
+
+#include "src/base/functional.h"
+
+namespace v8 {
+namespace internal {
+
+LazyDfa::LazyDfa(base::Vector<const RegExpInstruction> bytecode, Zone* zone)
+    : zone_(zone),
+      boundaries_(zone),
+      states_(zone),
+      state_indices_(zone),
+      transitions_(zone),
+      restarts_(zone),
+      preamble_consume_pc_(FindPreambleConsumePc(bytecode)),
+      visited_(bytecode.length(), -1, zone),
+      worklist_(zone) {
+  for (const RegExpInstruction& inst : bytecode) {
+    if (inst.opcode != RegExpInstruction::CONSUME_RANGE) continue;
+    RegExpInstruction::Uc16Range range = inst.payload.consume_range;
+    // Empty ranges, used for FAIL, don't distinguish any characters.
+    if (range.min > range.max) continue;
+    boundaries_.push_back(range.min);
+    boundaries_.push_back(range.max + 1);
+  }
+  std::sort(boundaries_.begin(), boundaries_.end());
+  boundaries_.erase(std::unique(boundaries_.begin(), boundaries_.end()),
+                    boundaries_.end());
+  class_count_ = static_cast<int>(boundaries_.size()) + 1;
+
+  int char_class = 0;
+  for (int c = 0; c < kLatin1ClassesSize; ++c) {
+    while (char_class < static_cast<int>(boundaries_.size()) &&
+           boundaries_[char_class] <= c) {
+      ++char_class;
+    }
+    latin1_classes_[c] = static_cast<uint16_t>(char_class);
+  }
+
+  int dead_state = FindOrAddState(ZoneVector<int>(zone_), bytecode);
+  ZoneVector<int> start_pcs(zone_);
+  ++pass_;
+  AddClosure(bytecode, 0, &start_pcs);
+  start_state_ = FindOrAddState(std::move(start_pcs), bytecode);
+  if (dead_state == kUnknownState || start_state_ == kUnknownState) {
+    gave_up_ = true;
+  }
+  DCHECK_IMPLIES(!gave_up_, dead_state == kDeadState);
+}
+
+// static
+int LazyDfa::FindPreambleConsumePc(
+    base::Vector<const RegExpInstruction> bytecode) {
+  // See CompileVisitor::Compile and CompileNonGreedyStar:
+  //
+  //   0: FORK 2
+  //   1: JMP 6
+  //   2: BEGIN_LOOP
+  //   3: CONSUME_RANGE [0x0000-0xFFFF]
+  //   4: END_LOOP
+  //   5: FORK 2
+  //   6: SET_REGISTER_TO_CP 0
+  static constexpr int kConsumePc = 3;
+  static constexpr int kBodyPc = 2;
+  static constexpr int kEndPc = 6;
+  if (bytecode.length() <= kEndPc) return -1;
+  const RegExpInstruction& consume = bytecode[kConsumePc];
+  bool is_preamble =
+      bytecode[0].opcode == RegExpInstruction::FORK &&
+      bytecode[0].payload.pc == kBodyPc &&
+      bytecode[1].opcode == RegExpInstruction::JMP &&
+      bytecode[1].payload.pc == kEndPc &&
+      bytecode[kBodyPc].opcode == RegExpInstruction::BEGIN_LOOP &&
+      consume.opcode == RegExpInstruction::CONSUME_RANGE &&
+      consume.payload.consume_range.min == 0x0000 &&
+      consume.payload.consume_range.max == 0xFFFF &&
+      bytecode[4].opcode == RegExpInstruction::END_LOOP &&
+      bytecode[5].opcode == RegExpInstruction::FORK &&
+      bytecode[5].payload.pc == kBodyPc &&
+      bytecode[kEndPc].opcode == RegExpInstruction::SET_REGISTER_TO_CP &&
+      bytecode[kEndPc].payload.register_index == 0;
+  return is_preamble ? kConsumePc : -1;
+}
+
+void LazyDfa::AddClosure(base::Vector<const RegExpInstruction> bytecode,
+                         int pc, ZoneVector<int>* pcs) {
+  DCHECK(worklist_.empty());
+  worklist_.push_back(pc);
+  while (!worklist_.empty()) {
+    pc = worklist_.back();
+    worklist_.pop_back();
+    if (visited_[pc] == pass_) continue;
+    visited_[pc] = pass_;
+
+    RegExpInstruction inst = bytecode[pc];
+    switch (inst.opcode) {
+      case RegExpInstruction::CONSUME_RANGE:
+        if (inst.payload.consume_range.min <= inst.payload.consume_range.max) {
+          pcs->push_back(pc);
+        }
+        break;
+      case RegExpInstruction::ACCEPT:
+        pcs->push_back(pc);
+        break;
+      case RegExpInstruction::FORK:
+        worklist_.push_back(inst.payload.pc);
+        worklist_.push_back(pc + 1);
+        break;
+      case RegExpInstruction::JMP:
+        worklist_.push_back(inst.payload.pc);
+        break;
+      case RegExpInstruction::ASSERTION:
+      case RegExpInstruction::CLEAR_REGISTER:
+      case RegExpInstruction::SET_REGISTER_TO_CP:
+      case RegExpInstruction::BEGIN_LOOP:
+      case RegExpInstruction::END_LOOP:
+        // Assumed to be satisfied, or irrelevant for whether there is a match.
+        worklist_.push_back(pc + 1);
+        break;
+    }
+  }
+}
+
+int LazyDfa::FindOrAddState(ZoneVector<int> pcs,
+                            base::Vector<const RegExpInstruction> bytecode) {
+  std::sort(pcs.begin(), pcs.end());
+  auto it = state_indices_.find(pcs);
+  if (it != state_indices_.end()) return it->second;
+
+  if (static_cast<int>(transitions_.size()) + class_count_ > kMaxTransitions) {
+    return kUnknownState;
+  }
+  bool accepting = false;
+  for (int pc : pcs) {
+    if (bytecode[pc].opcode == RegExpInstruction::ACCEPT) accepting = true;
+  }
+  int index = static_cast<int>(states_.size());
+  it = state_indices_.emplace(std::move(pcs), index).first;
+  states_.push_back(State{&it->first, accepting});
+  transitions_.resize(transitions_.size() + class_count_, kUnknownState);
+  restarts_.resize(restarts_.size() + class_count_, false);
+  return index;
+}
+
+int LazyDfa::ComputeTransition(base::Vector<const RegExpInstruction> bytecode,
+                               int state, int char_class) {
+  // Any character of the class behaves the same, so take the first one.
+  int c = char_class == 0 ? 0 : boundaries_[char_class - 1];
+  ZoneVector<int> next_pcs(zone_);
+  bool restart = true;
+  ++pass_;
+  for (int pc : *states_[state].pcs) {
+    RegExpInstruction inst = bytecode[pc];
+    if (inst.opcode == RegExpInstruction::CONSUME_RANGE &&
+        inst.payload.consume_range.min <= c &&
+        c <= inst.payload.consume_range.max) {
+      if (pc != preamble_consume_pc_) restart = false;
+      AddClosure(bytecode, pc + 1, &next_pcs);
+    }
+  }
+  int next_state = FindOrAddState(std::move(next_pcs), bytecode);
+  if (next_state != kUnknownState) {
+    transitions_[state * class_count_ + char_class] = next_state;
+    restarts_[state * class_count_ + char_class] = restart;
+  }
+  return next_state;
+}
+
+template <class Character>
+bool LazyDfa::MayMatch(base::Vector<const RegExpInstruction> bytecode,
+                       base::Vector<const Character> input,
+                       int* start_index) {
+  if (gave_up_) return true;
+  int state = start_state_;
+  for (int i = *start_index;; ++i) {
+    if (state == kDeadState) return false;
+    if (states_[state].accepting) return true;
+    if (i == input.length()) return false;
+
+    int transition = state * class_count_ + ClassOf(input[i]);
+    int next_state = transitions_[transition];
+    if (next_state == kUnknownState) {
+      next_state = ComputeTransition(bytecode, state, ClassOf(input[i]));
+      if (next_state == kUnknownState) {
+        gave_up_ = true;
+        return true;
+      }
+    }
+    // Only the preamble consumed the character, so every thread of the NFA
+    // simulation at the next position is one which starts a match there, as
+    // if the simulation had started there.
+    if (restarts_[transition]) *start_index = i + 1;
+    state = next_state;
+  }
+}
+
+template bool LazyDfa::MayMatch(
+    base::Vector<const RegExpInstruction> bytecode,
+    base::Vector<const uint8_t> input, int* start_index);
+template bool LazyDfa::MayMatch(
+    base::Vector<const RegExpInstruction> bytecode,
+    base::Vector<const base::uc16> input, int* start_index);
+
+LazyDfa* LazyDfaCache::Get(base::Vector<const RegExpInstruction> bytecode) {
+  uint32_t hash = static_cast<uint32_t>(base::hash_range(
+      reinterpret_cast<const uint8_t*>(bytecode.begin()),
+      reinterpret_cast<const uint8_t*>(bytecode.end())));
+  Entry* entry = nullptr;
+  for (Entry& candidate : entries_) {
+    if (candidate.hash == hash &&
+        candidate.bytecode.size() == bytecode.size() &&
+        memcmp(candidate.bytecode.begin(), bytecode.begin(),
+               bytecode.size() * sizeof(RegExpInstruction)) == 0) {
+      entry = &candidate;
+      break;
+    }
+  }
+  if (entry == nullptr) {
+    std::unique_ptr<Zone> zone =
+        std::make_unique<Zone>(allocator_, ZONE_NAME);
+    // The bytecode is owned by a heap object which may move, so the entry
+    // keeps a copy for the lookup.
+    base::Vector<RegExpInstruction> bytecode_copy =
+        zone->CloneVector(bytecode);
+    LazyDfa* dfa = zone->New<LazyDfa>(bytecode_copy, zone.get());
+    entries_.push_back(
+        Entry{hash, std::move(zone), bytecode_copy, dfa, use_counter_});
+    entry = &entries_.back();
+  }
+  entry->last_use = ++use_counter_;
+  // The DFA is owned by the zone of the entry, so it doesn't move when other
+  // entries are dropped.
+  LazyDfa* dfa = entry->dfa;
+  Trim();
+  return dfa;
+}
+
+void LazyDfaCache::Trim() {
+  // The DFAs grow while they are used, so the memory is checked on every
+  // lookup rather than only when entries are added.  The most recently used
+  // entry is never dropped.
+  while (entries_.size() > 1) {
+    size_t memory_size = 0;
+    for (const Entry& entry : entries_) {
+      memory_size += entry.dfa->memory_size();
+    }
+    if (entries_.size() <= kMaxEntries && memory_size <= kMaxMemorySize) {
+      return;
+    }
+    auto victim = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (victim == entries_.end() || it->last_use < victim->last_use) {
+        victim = it;
+      }
+    }
+    entries_.erase(victim);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
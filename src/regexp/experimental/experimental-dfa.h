@@ -0,0 +1,155 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_DFA_H_
+#define V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_DFA_H_
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "src/base/vector.h"
+#include "src/regexp/experimental/experimental-bytecode.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+
+// A deterministic finite automaton which is built lazily while scanning the
+// input, as in the hybrid DFA of re2.  It recognizes an over-approximation of
+// the language of an experimental bytecode program: assertions, capture
+// registers and the empty-iteration checks of quantifiers are ignored, so that
+// a DFA state is just the set of PCs of threads which wait for input.  If the
+// DFA can't reach an accepting state, the program can't match either, and the
+// NFA simulation with its per-thread registers can be skipped.
+//
+// Characters are mapped to equivalence classes which no CONSUME_RANGE of the
+// program distinguishes, and each state stores the successor for each class
+// once it has been computed.  If the transition table grows beyond a fixed
+// budget, the DFA gives up, and all queries report a possible match.
+class LazyDfa final : public ZoneObject {
+ public:
+  LazyDfa(base::Vector<const RegExpInstruction> bytecode, Zone* zone);
+
+  // Returns false if the program can't match a substring of {input} which
+  // starts at or after {*start_index}.  Reading stops at the first position
+  // where a match may end.
+  //
+  // Otherwise {*start_index} is advanced to the last position up to there at
+  // which only the unanchored /.*?/ preamble was still running.  Simulating
+  // the program from that position yields the same matches and captures, so
+  // the NFA simulation doesn't read the skipped prefix a second time.
+  template <class Character>
+  bool MayMatch(base::Vector<const RegExpInstruction> bytecode,
+                base::Vector<const Character> input, int* start_index);
+
+  // The memory held by this DFA, including its transition table.
+  size_t memory_size() const { return zone_->allocation_size(); }
+
+ private:
+  // Transitions which haven't been computed yet.  Also returned if the
+  // budget is exhausted.
+  static constexpr int kUnknownState = -1;
+  // The empty set of PCs, from which no match is possible.
+  static constexpr int kDeadState = 0;
+  // Maximal number of entries in `transitions_`.
+  static constexpr int kMaxTransitions = 1 << 16;
+  static constexpr int kLatin1ClassesSize = 256;
+
+  struct State {
+    const ZoneVector<int>* pcs;
+    bool accepting;
+  };
+
+  int ClassOf(base::uc16 c) const {
+    if (c < kLatin1ClassesSize) return latin1_classes_[c];
+    return static_cast<int>(
+        std::upper_bound(boundaries_.begin(), boundaries_.end(), c) -
+        boundaries_.begin());
+  }
+
+  // Returns the PC of the CONSUME_RANGE instruction of the /.*?/ preamble
+  // which the compiler emits for unanchored patterns, or -1 if there is none.
+  static int FindPreambleConsumePc(
+      base::Vector<const RegExpInstruction> bytecode);
+
+  // Adds the PCs of the CONSUME_RANGE and ACCEPT instructions which are
+  // reachable from {pc} without input to {pcs}.
+  void AddClosure(base::Vector<const RegExpInstruction> bytecode, int pc,
+                  ZoneVector<int>* pcs);
+  // Returns the index of the state for the set of {pcs}, or kUnknownState if
+  // there is no space left for a new state.
+  int FindOrAddState(ZoneVector<int> pcs,
+                     base::Vector<const RegExpInstruction> bytecode);
+  int ComputeTransition(base::Vector<const RegExpInstruction> bytecode,
+                        int state, int char_class);
+
+  Zone* zone_;
+  // Sorted characters at which a new equivalence class starts.  Class `k`
+  // consists of the characters from `boundaries_[k - 1]` (or 0) up to
+  // before `boundaries_[k]`.
+  ZoneVector<int> boundaries_;
+  int class_count_;
+  uint16_t latin1_classes_[kLatin1ClassesSize];
+
+  ZoneVector<State> states_;
+  ZoneMap<ZoneVector<int>, int> state_indices_;
+  // The successor of state `s` on class `k` is at `s * class_count_ + k`.
+  ZoneVector<int> transitions_;
+  // Whether a computed transition only advanced the preamble, i.e. whether
+  // all threads alive after it start at the next position.  Same layout as
+  // `transitions_`.
+  ZoneVector<bool> restarts_;
+  int start_state_;
+  int preamble_consume_pc_;
+
+  // Marks PCs which have been visited by the current `AddClosure` pass.
+  ZoneVector<int> visited_;
+  ZoneVector<int> worklist_;
+  int pass_ = 0;
+
+  bool gave_up_ = false;
+};
+
+// Keeps the lazy DFAs of recently executed experimental regexps alive across
+// executions, such that their transition tables are only computed once.  The
+// cache is owned by the isolate and keyed by the bytecode.  If the DFAs hold
+// more than a fixed amount of memory, the least recently used ones are
+// dropped.
+class LazyDfaCache final {
+ public:
+  explicit LazyDfaCache(AccountingAllocator* allocator)
+      : allocator_(allocator) {}
+  LazyDfaCache(const LazyDfaCache&) = delete;
+  LazyDfaCache& operator=(const LazyDfaCache&) = delete;
+
+  // Returns the DFA for {bytecode}, which stays valid until the next call.
+  // The DFA is created if there is none yet.
+  LazyDfa* Get(base::Vector<const RegExpInstruction> bytecode);
+
+ private:
+  static constexpr size_t kMaxMemorySize = 4 * MB;
+  static constexpr size_t kMaxEntries = 32;
+
+  struct Entry {
+    uint32_t hash;
+    std::unique_ptr<Zone> zone;
+    base::Vector<const RegExpInstruction> bytecode;
+    LazyDfa* dfa;
+    uint64_t last_use;
+  };
+
+  // Drops least recently used entries until the cache fits into its limits
+  // again.
+  void Trim();
+
+  AccountingAllocator* const allocator_;
+  std::vector<Entry> entries_;
+  uint64_t use_counter_ = 0;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_DFA_H_
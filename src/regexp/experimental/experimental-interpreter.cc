@@ -9,6 +9,7 @@
 #include "src/common/assert-scope.h"
 #include "src/objects/fixed-array-inl.h"
 #include "src/objects/string-inl.h"
+#include "src/regexp/experimental/experimental-dfa.h"
 #include "src/regexp/experimental/experimental.h"
 #include "src/strings/char-predicates-inl.h"
 #include "src/zone/zone-allocator.h"
@@ -154,6 +155,9 @@ class NfaInterpreter {
         blocked_threads_(0, zone),
         register_array_allocator_(zone),
         best_match_registers_(base::nullopt),
+        dfa_(v8_flags.experimental_regexp_engine_lazy_dfa
+                 ? isolate->lazy_dfa_cache()->Get(bytecode_)
+                 : nullptr),
         zone_(zone) {
     DCHECK(!bytecode_.empty());
     DCHECK_GE(input_index_, 0);
@@ -346,6 +350,19 @@ class NfaInterpreter {
       best_match_registers_ = base::nullopt;
     }
 
+    // Most subjects of most regexps don't match.  A scan of the input with the
+    // lazy DFA, which doesn't track registers, proves this much faster than
+    // the thread simulation below.  Otherwise the simulation starts where the
+    // scan found the last attempt at a match to begin, instead of reading the
+    // input up to there a second time.
+    if (dfa_ != nullptr) {
+      int start_index = input_index_;
+      if (!dfa_->MayMatch(bytecode_, input_, &start_index)) {
+        return RegExp::kInternalRegExpSuccess;
+      }
+      SetInputIndex(start_index);
+    }
+
     // All threads start at bytecode 0.
     // The initial value of consumed_since_last_quantifier is irrelevant before
     // entering the first quantifier.
@@ -630,6 +647,11 @@ class NfaInterpreter {
   // `register_array_allocator_`.
   base::Optional<base::Vector<int>> best_match_registers_;
 
+  // Rejects inputs without a match before threads are simulated, or nullptr
+  // if --experimental-regexp-engine-lazy-dfa is off.  Owned by the
+  // {LazyDfaCache} of the isolate, so that it is reused across executions.
+  LazyDfa* dfa_;
+
   Zone* zone_;
 };
 
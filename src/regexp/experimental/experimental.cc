@@ -21,6 +21,10 @@ bool ExperimentalRegExp::CanBeHandled(RegExpTree* tree, RegExpFlags flags,
   return ExperimentalRegExpCompiler::CanBeHandled(tree, flags, capture_count);
 }
 
+bool ExperimentalRegExp::IsBacktrackingUnsafe(RegExpTree* tree) {
+  return ExperimentalRegExpCompiler::MayBacktrackExponentially(tree);
+}
+
 void ExperimentalRegExp::Initialize(Isolate* isolate, Handle<JSRegExp> re,
                                     Handle<String> source, RegExpFlags flags,
                                     int capture_count) {
@@ -87,7 +91,8 @@ base::Optional<CompilationResult> CompileImpl(Isolate* isolate,
   }
 
   ZoneList<RegExpInstruction> bytecode = ExperimentalRegExpCompiler::Compile(
-      parse_result.tree, JSRegExp::AsRegExpFlags(regexp->flags()), &zone);
+      isolate, parse_result.tree, JSRegExp::AsRegExpFlags(regexp->flags()),
+      &zone);
 
   CompilationResult result;
   result.bytecode = VectorToByteArray(isolate, bytecode.ToVector());
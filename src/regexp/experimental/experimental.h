@@ -22,6 +22,9 @@ class ExperimentalRegExp final : public AllStatic {
   // AST again is more flexible and less error prone (but less performant).
   static bool CanBeHandled(RegExpTree* tree, RegExpFlags flags,
                            int capture_count);
+  // Whether a pattern should rather run on the EXPERIMENTAL engine because
+  // it may take exponential time with backtracking.
+  static bool IsBacktrackingUnsafe(RegExpTree* tree);
   static void Initialize(Isolate* isolate, Handle<JSRegExp> re,
                          Handle<String> pattern, RegExpFlags flags,
                          int capture_count);
@@ -4,6 +4,8 @@
 
 #include "src/regexp/regexp.h"
 
+#include <vector>
+
 #include "src/base/strings.h"
 #include "src/codegen/compilation-cache.h"
 #include "src/diagnostics/code-tracer.h"
@@ -189,6 +191,112 @@ bool HasFewDifferentCharacters(Handle<String> pattern) {
   return true;
 }
 
+// A term of the sequence which every match consists of, together with the
+// range of its length. {atom} is nullptr if the term is not a literal.
+struct SequenceTerm {
+  RegExpAtom* atom;
+  int min_length;
+  int max_length;
+};
+
+// Collects the terms of the top-level sequence of {tree}. Captures and groups
+// are flattened, while quantifiers, disjunctions and lookarounds are kept as
+// single terms since their literals don't necessarily occur in a match.
+void CollectSequenceTerms(RegExpTree* tree, std::vector<SequenceTerm>* terms) {
+  if (tree->IsAlternative()) {
+    for (RegExpTree* node : *tree->AsAlternative()->nodes()) {
+      CollectSequenceTerms(node, terms);
+    }
+  } else if (tree->IsCapture()) {
+    CollectSequenceTerms(tree->AsCapture()->body(), terms);
+  } else if (tree->IsGroup()) {
+    CollectSequenceTerms(tree->AsGroup()->body(), terms);
+  } else if (tree->IsText()) {
+    for (const TextElement& element : *tree->AsText()->elements()) {
+      RegExpAtom* atom =
+          element.text_type() == TextElement::ATOM ? element.atom() : nullptr;
+      terms->push_back({atom, element.length(), element.length()});
+    }
+  } else {
+    RegExpAtom* atom = tree->IsAtom() ? tree->AsAtom() : nullptr;
+    terms->push_back({atom, tree->min_match(), tree->max_match()});
+  }
+}
+
+// Stores the longest literal which occurs in every match of {tree}, and the
+// range of its distance from the start of the match. The matcher then only
+// runs once the literal has been found, starting no further than that
+// distance ahead of it.
+void SetIrregexpRequiredLiteral(Isolate* isolate, Handle<JSRegExp> re,
+                                RegExpTree* tree, RegExpFlags flags) {
+  // Sticky and anchored regexps are only attempted at a single position,
+  // which is cheaper than scanning the rest of the subject. Case-insensitive
+  // literals can't be searched for directly.
+  if (IsSticky(flags) || IsIgnoreCase(flags) || tree->IsAnchoredAtStart()) {
+    return;
+  }
+  std::vector<SequenceTerm> terms;
+  CollectSequenceTerms(tree, &terms);
+
+  // Offsets beyond the maximal string length are clamped, or considered
+  // unbounded.
+  constexpr int64_t kMaxOffset = String::kMaxLength;
+  int64_t min_offset = 0;
+  int64_t max_offset = 0;
+  RegExpAtom* literal = nullptr;
+  int literal_min_offset = 0;
+  int literal_max_offset = JSRegExp::kUninitializedValue;
+  for (const SequenceTerm& term : terms) {
+    if (term.atom != nullptr &&
+        (literal == nullptr || term.atom->length() > literal->length())) {
+      literal = term.atom;
+      literal_min_offset = static_cast<int>(min_offset);
+      literal_max_offset = max_offset <= kMaxOffset
+                               ? static_cast<int>(max_offset)
+                               : JSRegExp::kUninitializedValue;
+    }
+    min_offset = std::min(min_offset + term.min_length, kMaxOffset);
+    max_offset = std::min(max_offset + term.max_length, kMaxOffset + 1);
+  }
+  if (literal == nullptr) return;
+
+  Handle<String> literal_string =
+      isolate->factory()
+          ->NewStringFromTwoByte(literal->data(), AllocationType::kOld)
+          .ToHandleChecked();
+  Tagged<FixedArray> data = FixedArray::cast(re->data());
+  data->set(JSRegExp::kIrregexpRequiredLiteralIndex, *literal_string);
+  data->set(JSRegExp::kIrregexpRequiredLiteralMinOffsetIndex,
+            Smi::FromInt(literal_min_offset));
+  data->set(JSRegExp::kIrregexpRequiredLiteralMaxOffsetIndex,
+            Smi::FromInt(literal_max_offset));
+}
+
+// Returns how many characters at the start of {input} can be skipped because
+// no match starts there, or -1 if {input} doesn't contain the required literal
+// of {data} at all.
+template <typename Char>
+int RequiredLiteralSkip(Isolate* isolate, Tagged<FixedArray> data,
+                        base::Vector<const Char> input) {
+  DisallowGarbageCollection no_gc;
+  Tagged<Object> literal = data->get(JSRegExp::kIrregexpRequiredLiteralIndex);
+  if (IsSmi(literal)) return 0;
+  int min_offset =
+      Smi::ToInt(data->get(JSRegExp::kIrregexpRequiredLiteralMinOffsetIndex));
+  int max_offset =
+      Smi::ToInt(data->get(JSRegExp::kIrregexpRequiredLiteralMaxOffsetIndex));
+  String::FlatContent pattern =
+      String::cast(literal)->GetFlatContent(no_gc);
+  if (min_offset > input.length() - pattern.length()) return -1;
+  int index =
+      pattern.IsOneByte()
+          ? SearchString(isolate, input, pattern.ToOneByteVector(), min_offset)
+          : SearchString(isolate, input, pattern.ToUC16Vector(), min_offset);
+  if (index == -1) return -1;
+  if (max_offset == JSRegExp::kUninitializedValue) return 0;
+  return std::max(0, index - max_offset);
+}
+
 }  // namespace
 
 // Generic RegExp methods. Dispatches to implementation specific methods.
@@ -249,6 +357,14 @@ MaybeHandle<Object> RegExp::Compile(Isolate* isolate, Handle<JSRegExp> re,
     ExperimentalRegExp::Initialize(isolate, re, pattern, flags,
                                    parse_result.capture_count);
     has_been_compiled = true;
+  } else if (v8_flags.experimental_regexp_engine_for_unsafe_patterns &&
+             ExperimentalRegExp::IsBacktrackingUnsafe(parse_result.tree) &&
+             ExperimentalRegExp::CanBeHandled(parse_result.tree, flags,
+                                              parse_result.capture_count)) {
+    DCHECK(v8_flags.enable_experimental_regexp_engine);
+    ExperimentalRegExp::Initialize(isolate, re, pattern, flags,
+                                   parse_result.capture_count);
+    has_been_compiled = true;
   } else if (parse_result.simple && !IsIgnoreCase(flags) && !IsSticky(flags) &&
              !HasFewDifferentCharacters(pattern)) {
     // Parse-tree is a single atom that is equal to the pattern.
@@ -272,6 +388,9 @@ MaybeHandle<Object> RegExp::Compile(Isolate* isolate, Handle<JSRegExp> re,
   if (!has_been_compiled) {
     RegExpImpl::IrregexpInitialize(isolate, re, pattern, flags,
                                    parse_result.capture_count, backtrack_limit);
+    if (v8_flags.regexp_required_literal) {
+      SetIrregexpRequiredLiteral(isolate, re, parse_result.tree, flags);
+    }
   }
   DCHECK(IsFixedArray(re->data()));
   // Compilation succeeded so the data is set on the regexp
@@ -318,6 +437,26 @@ MaybeHandle<Object> RegExp::ExperimentalOneshotExec(
                                          last_match_info, exec_quirks);
 }
 
+// static
+intptr_t RegExp::SkipToRequiredLiteral(Address raw_data, Address input_start,
+                                       Address input_end, int is_one_byte,
+                                       Isolate* isolate) {
+  DisallowGarbageCollection no_gc;
+  Tagged<FixedArray> data = FixedArray::cast(Tagged<Object>(raw_data));
+  if (is_one_byte) {
+    const uint8_t* start = reinterpret_cast<const uint8_t*>(input_start);
+    const uint8_t* end = reinterpret_cast<const uint8_t*>(input_end);
+    return RequiredLiteralSkip(
+        isolate, data,
+        base::Vector<const uint8_t>(start, static_cast<size_t>(end - start)));
+  }
+  const base::uc16* start = reinterpret_cast<const base::uc16*>(input_start);
+  const base::uc16* end = reinterpret_cast<const base::uc16*>(input_end);
+  return RequiredLiteralSkip(
+      isolate, data,
+      base::Vector<const base::uc16>(start, static_cast<size_t>(end - start)));
+}
+
 // static
 MaybeHandle<Object> RegExp::Exec(Isolate* isolate, Handle<JSRegExp> regexp,
                                  Handle<String> subject, int index,
@@ -679,6 +818,23 @@ int RegExpImpl::IrregexpExecRaw(Isolate* isolate, Handle<JSRegExp> regexp,
 
   bool is_one_byte = String::IsOneByteRepresentationUnderneath(*subject);
 
+  // Start at the first position where a match is possible according to the
+  // required literal.
+  {
+    DisallowGarbageCollection no_gc;
+    Tagged<FixedArray> data = FixedArray::cast(regexp->data());
+    String::FlatContent content = subject->GetFlatContent(no_gc);
+    int skip = content.IsOneByte()
+                   ? RequiredLiteralSkip(
+                         isolate, data,
+                         content.ToOneByteVector().SubVectorFrom(index))
+                   : RequiredLiteralSkip(
+                         isolate, data,
+                         content.ToUC16Vector().SubVectorFrom(index));
+    if (skip == -1) return RegExp::RE_FAILURE;
+    index += skip;
+  }
+
   if (!regexp->ShouldProduceBytecode()) {
     do {
       EnsureCompiledIrregexp(isolate, regexp, subject, is_one_byte);
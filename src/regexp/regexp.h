@@ -140,6 +140,15 @@ class RegExp final : public AllStatic {
     RE_FALLBACK_TO_EXPERIMENTAL = kInternalRegExpFallbackToExperimental,
   };
 
+  // Scans the subject between {input_start}, where a match attempt is about
+  // to start, and {input_end} for the required literal of the irregexp
+  // {raw_data}. Returns how many characters can be skipped because no match
+  // starts there, or -1 if there is no match at all. Called from generated
+  // code, see RegExpBuiltinsAssembler::RegExpExecInternal.
+  static intptr_t SkipToRequiredLiteral(Address raw_data, Address input_start,
+                                        Address input_end, int is_one_byte,
+                                        Isolate* isolate);
+
   // Set last match info.  If match is nullptr, then setting captures is
   // omitted.
   static Handle<RegExpMatchInfo> SetLastMatchInfo(
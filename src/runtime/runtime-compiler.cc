@@ -373,6 +373,11 @@ RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
     return ReadOnlyRoots(isolate).undefined_value();
   }
 
+  if (V8_UNLIKELY(v8_flags.deopt_storm_backoff)) {
+    isolate->tiering_manager()->deopt_telemetry()->RecordDeopt(
+        *function, optimized_code->kind(), deopt_reason, deopt_exit_offset);
+  }
+
   // Non-OSR'd code is deoptimized unconditionally. If the deoptimization occurs
   // inside the outermost loop containning a loop that can trigger OSR
   // compilation, we remove the OSR code, it will avoid hit the out of date OSR
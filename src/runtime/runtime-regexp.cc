@@ -1630,6 +1630,60 @@ Handle<JSArray> NewJSArrayWithElements(Isolate* isolate,
 
 }  // namespace
 
+// Fast path for @@match with an unmodified, global JSRegExp.  RegExpGlobalCache
+// fetches as many matches per call into the regexp code as fit into its
+// off-heap register array, so that the only allocations per match are the
+// substrings themselves.
+RUNTIME_FUNCTION(Runtime_RegExpMatchGlobal) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(3, args.length());
+
+  Handle<JSRegExp> regexp = args.at<JSRegExp>(0);
+  Handle<String> subject = args.at<String>(1);
+  Handle<RegExpMatchInfo> last_match_info = args.at<RegExpMatchInfo>(2);
+
+  DCHECK(RegExpUtils::IsUnmodifiedRegExp(isolate, regexp));
+  CHECK(regexp->flags() & JSRegExp::kGlobal);
+
+  subject = String::Flatten(isolate, subject);
+
+  // All matches of an atom are equal to its pattern.
+  Handle<String> atom_pattern;
+  if (regexp->type_tag() == JSRegExp::ATOM) {
+    atom_pattern = handle(regexp->atom_pattern(), isolate);
+  }
+
+  RegExpGlobalCache global_cache(regexp, subject, isolate);
+  if (global_cache.HasException()) return ReadOnlyRoots(isolate).exception();
+
+  FixedArrayBuilder builder = FixedArrayBuilder::Lazy(isolate);
+  while (true) {
+    int32_t* current_match = global_cache.FetchNext();
+    if (current_match == nullptr) break;
+    builder.EnsureCapacity(isolate, 1);
+    if (!atom_pattern.is_null()) {
+      builder.Add(*atom_pattern);
+      continue;
+    }
+    // Avoid accumulating new handles inside loop.
+    HandleScope temp_scope(isolate);
+    builder.Add(*isolate->factory()->NewSubString(subject, current_match[0],
+                                                  current_match[1]));
+  }
+
+  if (global_cache.HasException()) return ReadOnlyRoots(isolate).exception();
+
+  // As after the failing exec call which ends the loop in the spec.
+  regexp->set_last_index(Smi::zero(), SKIP_WRITE_BARRIER);
+
+  if (builder.length() == 0) return ReadOnlyRoots(isolate).null_value();
+
+  RegExp::SetLastMatchInfo(isolate, last_match_info, subject,
+                           regexp->capture_count(),
+                           global_cache.LastSuccessfulMatch());
+  return *NewJSArrayWithElements(isolate, builder.array(), builder.length());
+}
+
 // Slow path for:
 // ES#sec-regexp.prototype-@@replace
 // RegExp.prototype [ @@split ] ( string, limit )
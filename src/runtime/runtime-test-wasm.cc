@@ -623,6 +623,12 @@ RUNTIME_FUNCTION(Runtime_FlushWasmCode) {
   return ReadOnlyRoots(isolate).undefined_value();
 }
 
+RUNTIME_FUNCTION(Runtime_WasmAgeCode) {
+  CHECK(v8_flags.wasm_code_flushing);
+  wasm::GetWasmEngine()->AgeCode(isolate);
+  return ReadOnlyRoots(isolate).undefined_value();
+}
+
 RUNTIME_FUNCTION(Runtime_WasmCompiledExportWrappersCount) {
   int count = isolate->counters()
                   ->wasm_compiled_export_wrapper()
@@ -422,6 +422,7 @@ namespace internal {
   F(RegExpExperimentalOneshotExecTreatMatchAtEndAsFailure, 4, 1) \
   F(RegExpExecMultiple, 3, 1)                                    \
   F(RegExpInitializeAndCompile, 3, 1)                            \
+  F(RegExpMatchGlobal, 3, 1)                                     \
   F(RegExpReplaceRT, 3, 1)                                       \
   F(RegExpSplit, 3, 1)                                           \
   F(RegExpStringFromFlags, 1, 1)                                 \
@@ -698,6 +699,7 @@ namespace internal {
   F(SetWasmCompileControls, 2, 1)           \
   F(SetWasmInstantiateControls, 0, 1)       \
   F(SetWasmGCEnabled, 1, 1)                 \
+  F(WasmAgeCode, 0, 1)                      \
   F(WasmCompiledExportWrappersCount, 0, 1)  \
   F(WasmGetNumberOfInstances, 1, 1)         \
   F(WasmNumCodeSpaces, 1, 1)                \
@@ -748,7 +750,8 @@ namespace internal {
   F(CloneObjectIC_Slow, 2, 1)                \
   F(CloneObjectIC_Miss, 4, 1)                \
   F(KeyedHasIC_Miss, 4, 1)                   \
-  F(HasElementWithInterceptor, 2, 1)
+  F(HasElementWithInterceptor, 2, 1)         \
+  F(UpdateCallTargetHistogram, 3, 1)
 
 #define FOR_EACH_INTRINSIC_RETURN_OBJECT_IMPL(F, I) \
   FOR_EACH_INTRINSIC_ARRAY(F, I)                    \
@@ -5,6 +5,9 @@
 #ifndef V8_STRINGS_STRING_BUILDER_INL_H_
 #define V8_STRINGS_STRING_BUILDER_INL_H_
 
+#include <memory>
+#include <vector>
+
 #include "src/common/assert-scope.h"
 #include "src/execution/isolate.h"
 #include "src/handles/handles-inl.h"
@@ -12,6 +15,7 @@
 #include "src/objects/fixed-array.h"
 #include "src/objects/objects.h"
 #include "src/objects/string-inl.h"
+#include "src/utils/memcopy.h"
 
 namespace v8 {
 namespace internal {
@@ -118,9 +122,17 @@ class ReplacementStringBuilder {
   bool is_one_byte_;
 };
 
+// Builds a string from characters and strings which are appended one after
+// the other. The characters are collected off-heap in parts whose length
+// grows exponentially, and each part is one-byte or two-byte depending on
+// the encoding at the time it was started. Long strings are referenced
+// instead of copied. Finish() copies everything into a single flat string,
+// so that no intermediate cons strings are created. The off-heap characters
+// are reported to the heap as external memory.
 class IncrementalStringBuilder {
  public:
   explicit IncrementalStringBuilder(Isolate* isolate);
+  ~IncrementalStringBuilder();
 
   V8_INLINE String::Encoding CurrentEncoding() { return encoding_; }
 
@@ -143,8 +155,7 @@ class IncrementalStringBuilder {
     if (length == 1) return AppendCharacter(literal[0]);
     if (encoding_ == String::ONE_BYTE_ENCODING && CurrentPartCanFit(N)) {
       const uint8_t* chars = reinterpret_cast<const uint8_t*>(literal);
-      SeqOneByteString::cast(*current_part_)
-          ->SeqOneByteStringSetChars(current_index_, chars, length);
+      CopyChars(current_part_.get() + current_index_, chars, length);
       current_index_ += length;
       if (current_index_ == part_length_) Extend();
       DCHECK(HasValidCurrentIndex());
@@ -194,48 +205,15 @@ class IncrementalStringBuilder {
 
   int Length() const;
 
-  // Change encoding to two-byte.
-  void ChangeEncoding() {
-    DCHECK_EQ(String::ONE_BYTE_ENCODING, encoding_);
-    ShrinkCurrentPart();
-    encoding_ = String::TWO_BYTE_ENCODING;
-    Extend();
-  }
+  // Change encoding to two-byte. The characters appended so far stay in
+  // one-byte parts and are only widened by Finish().
+  void ChangeEncoding();
 
   template <typename DestChar>
   class NoExtend {
    public:
-    NoExtend(Tagged<String> string, int offset,
-             const DisallowGarbageCollection& no_gc) {
-      DCHECK(IsSeqOneByteString(string) || IsSeqTwoByteString(string));
-      if (sizeof(DestChar) == 1) {
-        start_ = reinterpret_cast<DestChar*>(
-            SeqOneByteString::cast(string)->GetChars(no_gc) + offset);
-      } else {
-        start_ = reinterpret_cast<DestChar*>(
-            SeqTwoByteString::cast(string)->GetChars(no_gc) + offset);
-      }
-      cursor_ = start_;
-#ifdef DEBUG
-      string_ = string;
-#endif
-    }
-
-#ifdef DEBUG
-    ~NoExtend() {
-      DestChar* end;
-      if (sizeof(DestChar) == 1) {
-        auto one_byte_string = SeqOneByteString::cast(string_);
-        end = reinterpret_cast<DestChar*>(one_byte_string->GetChars(no_gc_) +
-                                          one_byte_string->length());
-      } else {
-        auto two_byte_string = SeqTwoByteString::cast(string_);
-        end = reinterpret_cast<DestChar*>(two_byte_string->GetChars(no_gc_) +
-                                          two_byte_string->length());
-      }
-      DCHECK_LE(cursor_, end + 1);
-    }
-#endif
+    NoExtend(DestChar* start, const DisallowGarbageCollection& no_gc)
+        : start_(start), cursor_(start) {}
 
     V8_INLINE void Append(DestChar c) { *(cursor_++) = c; }
     V8_INLINE void AppendCString(const char* s) {
@@ -248,9 +226,6 @@ class IncrementalStringBuilder {
    private:
     DestChar* start_;
     DestChar* cursor_;
-#ifdef DEBUG
-    Tagged<String> string_;
-#endif
     DISALLOW_GARBAGE_COLLECTION(no_gc_)
   };
 
@@ -259,8 +234,7 @@ class IncrementalStringBuilder {
    public:
     NoExtendBuilder(IncrementalStringBuilder* builder, int required_length,
                     const DisallowGarbageCollection& no_gc)
-        : NoExtend<DestChar>(*(builder->current_part()),
-                             builder->current_index_, no_gc),
+        : NoExtend<DestChar>(builder->current_chars<DestChar>(), no_gc),
           builder_(builder) {
       DCHECK(builder->CurrentPartCanFit(required_length));
     }
@@ -277,64 +251,77 @@ class IncrementalStringBuilder {
   Isolate* isolate() { return isolate_; }
 
  private:
-  Factory* factory() { return isolate_->factory(); }
+  // A finished part. Either the characters are owned by the part, or the part
+  // refers to the string at {large_string_index} in {large_strings_}.
+  struct Part {
+    std::unique_ptr<uint8_t[]> chars;
+    int length;
+    String::Encoding encoding;
+    int large_string_index;
+  };
 
-  V8_INLINE Handle<String> accumulator() { return accumulator_; }
+  Factory* factory() { return isolate_->factory(); }
 
-  V8_INLINE void set_accumulator(Handle<String> string) {
-    accumulator_.PatchValue(*string);
+  template <typename DestChar>
+  V8_INLINE DestChar* current_chars() {
+    DCHECK_EQ(encoding_ == String::ONE_BYTE_ENCODING, sizeof(DestChar) == 1);
+    return reinterpret_cast<DestChar*>(current_part_.get()) + current_index_;
   }
 
-  V8_INLINE Handle<String> current_part() { return current_part_; }
+  // Finish the current part and allocate a new part.
+  void Extend();
 
-  V8_INLINE void set_current_part(Handle<String> string) {
-    current_part_.PatchValue(*string);
-  }
+  // Move the characters of the current part, if any, to {parts_}. A full
+  // current part is handed over as is; otherwise only the characters in use
+  // are copied and the current part is reused.
+  void FinishCurrentPart();
 
-  // Add the current part to the accumulator.
-  void Accumulate(Handle<String> new_part);
+  // Allocate a new current part of {part_length_} characters.
+  void StartPart();
 
-  // Finish the current part and allocate a new part.
-  void Extend();
+  // Report a change in the size of the off-heap parts to the heap.
+  void AdjustExternalMemory(int64_t delta);
 
-  bool HasValidCurrentIndex() const;
+  // Add {length} characters to the accumulated length. Returns false and
+  // drops everything accumulated so far if the result would be too long.
+  bool AccumulateLength(int length);
 
-  // Shrink current part to the right size.
-  void ShrinkCurrentPart() {
-    DCHECK(current_index_ < part_length_);
-    set_current_part(SeqString::Truncate(
-        isolate_, Handle<SeqString>::cast(current_part()), current_index_));
-  }
+  bool HasValidCurrentIndex() const;
 
   void AppendStringByCopy(Handle<String> string);
-  bool CanAppendByCopy(Handle<String> string);
+  void AppendStringByReference(Handle<String> string);
+
+  template <typename sinkchar>
+  void WriteParts(sinkchar* sink, const DisallowGarbageCollection& no_gc);
 
   static const int kInitialPartLength = 32;
-  static const int kMaxPartLength = 16 * 1024;
+  static const int kMaxPartLength = 256 * 1024;
   static const int kPartLengthGrowthFactor = 2;
   static const int kIntToCStringBufferSize = 100;
+  // Strings at least this long are not copied by AppendString().
+  static const int kMinLengthForAppendByReference = 4 * 1024;
 
   Isolate* isolate_;
   String::Encoding encoding_;
   bool overflowed_;
   int part_length_;
   int current_index_;
-  Handle<String> accumulator_;
-  Handle<String> current_part_;
+  // Number of characters in {parts_}.
+  int accumulated_length_;
+  int number_of_large_strings_;
+  std::unique_ptr<uint8_t[]> current_part_;
+  size_t current_part_size_;
+  // Size in bytes of all off-heap parts, including the current part.
+  int64_t external_memory_;
+  std::vector<Part> parts_;
+  Handle<FixedArray> large_strings_;
 };
 
 template <typename SrcChar, typename DestChar>
 void IncrementalStringBuilder::Append(SrcChar c) {
   DCHECK_EQ(encoding_ == String::ONE_BYTE_ENCODING, sizeof(DestChar) == 1);
-  if (sizeof(DestChar) == 1) {
-    DCHECK_EQ(String::ONE_BYTE_ENCODING, encoding_);
-    SeqOneByteString::cast(*current_part_)
-        ->SeqOneByteStringSet(current_index_++, c);
-  } else {
-    DCHECK_EQ(String::TWO_BYTE_ENCODING, encoding_);
-    SeqTwoByteString::cast(*current_part_)
-        ->SeqTwoByteStringSet(current_index_++, c);
-  }
+  DestChar* chars = reinterpret_cast<DestChar*>(current_part_.get());
+  chars[current_index_++] = static_cast<DestChar>(c);
   if (current_index_ == part_length_) Extend();
   DCHECK(HasValidCurrentIndex());
 }
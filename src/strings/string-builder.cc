@@ -247,110 +247,232 @@ IncrementalStringBuilder::IncrementalStringBuilder(Isolate* isolate)
       encoding_(String::ONE_BYTE_ENCODING),
       overflowed_(false),
       part_length_(kInitialPartLength),
-      current_index_(0) {
-  // Create an accumulator handle starting with the empty string.
-  accumulator_ =
-      Handle<String>::New(ReadOnlyRoots(isolate).empty_string(), isolate);
-  current_part_ =
-      factory()->NewRawOneByteString(part_length_).ToHandleChecked();
+      current_index_(0),
+      accumulated_length_(0),
+      number_of_large_strings_(0),
+      current_part_size_(0),
+      external_memory_(0) {
+  // Create the handle for long strings here, so that it is not invalidated
+  // by handle scopes which are closed between appends.
+  large_strings_ = Handle<FixedArray>::New(
+      ReadOnlyRoots(isolate).empty_fixed_array(), isolate);
+  StartPart();
 }
 
+IncrementalStringBuilder::~IncrementalStringBuilder() {
+  AdjustExternalMemory(-external_memory_);
+}
+
+void IncrementalStringBuilder::AdjustExternalMemory(int64_t delta) {
+  if (delta == 0) return;
+  external_memory_ += delta;
+  DCHECK_LE(0, external_memory_);
+  reinterpret_cast<v8::Isolate*>(isolate_)
+      ->AdjustAmountOfExternalAllocatedMemory(delta);
+}
+
+namespace {
+
+size_t CharSize(String::Encoding encoding) {
+  return encoding == String::ONE_BYTE_ENCODING ? sizeof(uint8_t)
+                                               : sizeof(base::uc16);
+}
+
+}  // namespace
+
 int IncrementalStringBuilder::Length() const {
-  return accumulator_->length() + current_index_;
+  return accumulated_length_ + current_index_;
 }
 
 bool IncrementalStringBuilder::HasValidCurrentIndex() const {
   return current_index_ < part_length_;
 }
 
-void IncrementalStringBuilder::Accumulate(Handle<String> new_part) {
-  Handle<String> new_accumulator;
-  if (accumulator()->length() + new_part->length() > String::kMaxLength) {
+bool IncrementalStringBuilder::AccumulateLength(int length) {
+  if (overflowed_ || length > String::kMaxLength - accumulated_length_) {
     // Set the flag and carry on. Delay throwing the exception till the end.
-    new_accumulator = factory()->empty_string();
     overflowed_ = true;
-  } else {
-    new_accumulator =
-        factory()->NewConsString(accumulator(), new_part).ToHandleChecked();
+    int64_t freed = 0;
+    for (const Part& part : parts_) {
+      if (part.chars) freed += part.length * CharSize(part.encoding);
+    }
+    parts_.clear();
+    accumulated_length_ = 0;
+    AdjustExternalMemory(-freed);
+    return false;
   }
-  set_accumulator(new_accumulator);
+  accumulated_length_ += length;
+  return true;
+}
+
+void IncrementalStringBuilder::FinishCurrentPart() {
+  if (current_index_ == 0) return;
+  if (AccumulateLength(current_index_)) {
+    std::unique_ptr<uint8_t[]> chars;
+    if (current_index_ == part_length_) {
+      chars = std::move(current_part_);
+      current_part_size_ = 0;
+    } else {
+      // Don't keep the unused tail of the current part alive, it can be up
+      // to kMaxPartLength characters long.
+      size_t size = current_index_ * CharSize(encoding_);
+      chars.reset(new uint8_t[size]);
+      MemCopy(chars.get(), current_part_.get(), size);
+      AdjustExternalMemory(size);
+    }
+    parts_.push_back(Part{std::move(chars), current_index_, encoding_, -1});
+  }
+  current_index_ = 0;
+}
+
+void IncrementalStringBuilder::StartPart() {
+  DCHECK_EQ(0, current_index_);
+  size_t size = part_length_ * CharSize(encoding_);
+  current_part_.reset(new uint8_t[size]);
+  AdjustExternalMemory(static_cast<int64_t>(size) -
+                       static_cast<int64_t>(current_part_size_));
+  current_part_size_ = size;
 }
 
 void IncrementalStringBuilder::Extend() {
-  DCHECK_EQ(current_index_, current_part()->length());
-  Accumulate(current_part());
+  DCHECK_EQ(current_index_, part_length_);
+  FinishCurrentPart();
   if (part_length_ <= kMaxPartLength / kPartLengthGrowthFactor) {
     part_length_ *= kPartLengthGrowthFactor;
   }
-  Handle<String> new_part;
-  if (encoding_ == String::ONE_BYTE_ENCODING) {
-    new_part = factory()->NewRawOneByteString(part_length_).ToHandleChecked();
-  } else {
-    new_part = factory()->NewRawTwoByteString(part_length_).ToHandleChecked();
+  StartPart();
+}
+
+void IncrementalStringBuilder::ChangeEncoding() {
+  DCHECK_EQ(String::ONE_BYTE_ENCODING, encoding_);
+  FinishCurrentPart();
+  encoding_ = String::TWO_BYTE_ENCODING;
+  StartPart();
+}
+
+template <typename sinkchar>
+void IncrementalStringBuilder::WriteParts(
+    sinkchar* sink, const DisallowGarbageCollection& no_gc) {
+  for (const Part& part : parts_) {
+    if (part.large_string_index >= 0) {
+      String::WriteToFlat(
+          String::cast(large_strings_->get(part.large_string_index)), sink, 0,
+          part.length);
+    } else if (part.encoding == String::ONE_BYTE_ENCODING) {
+      CopyChars(sink, part.chars.get(), part.length);
+    } else {
+      DCHECK_EQ(sizeof(sinkchar), sizeof(base::uc16));
+      CopyChars(sink, reinterpret_cast<const base::uc16*>(part.chars.get()),
+                part.length);
+    }
+    sink += part.length;
   }
-  // Reuse the same handle to avoid being invalidated when exiting handle scope.
-  set_current_part(new_part);
-  current_index_ = 0;
 }
 
 MaybeHandle<String> IncrementalStringBuilder::Finish() {
-  ShrinkCurrentPart();
-  Accumulate(current_part());
+  FinishCurrentPart();
   if (overflowed_) {
     THROW_NEW_ERROR(isolate_, NewInvalidStringLengthError(), String);
   }
+  Handle<String> result;
+  if (parts_.empty()) {
+    result = factory()->empty_string();
+  } else if (parts_.size() == 1 && parts_[0].large_string_index == 0 &&
+             String::cast(large_strings_->get(0))->IsFlat()) {
+    result = handle(String::cast(large_strings_->get(0)), isolate_);
+  } else {
+    bool one_byte = true;
+    for (const Part& part : parts_) {
+      if (part.large_string_index >= 0) {
+        Tagged<String> string =
+            String::cast(large_strings_->get(part.large_string_index));
+        if (!string->IsOneByteRepresentation()) one_byte = false;
+      } else if (part.encoding == String::TWO_BYTE_ENCODING) {
+        one_byte = false;
+      }
+    }
+    if (one_byte) {
+      Handle<SeqOneByteString> flat;
+      ASSIGN_RETURN_ON_EXCEPTION(
+          isolate_, flat, factory()->NewRawOneByteString(accumulated_length_),
+          String);
+      DisallowGarbageCollection no_gc;
+      WriteParts(flat->GetChars(no_gc), no_gc);
+      result = flat;
+    } else {
+      Handle<SeqTwoByteString> flat;
+      ASSIGN_RETURN_ON_EXCEPTION(
+          isolate_, flat, factory()->NewRawTwoByteString(accumulated_length_),
+          String);
+      DisallowGarbageCollection no_gc;
+      WriteParts(flat->GetChars(no_gc), no_gc);
+      result = flat;
+    }
+  }
   if (isolate()->serializer_enabled()) {
-    return factory()->InternalizeString(accumulator());
+    return factory()->InternalizeString(result);
   }
-  return accumulator();
-}
-
-// Short strings can be copied directly to {current_part_}.
-// Requires the IncrementalStringBuilder to either have two byte encoding or
-// the incoming string to have one byte representation "underneath" (The
-// one byte check requires the string to be flat).
-bool IncrementalStringBuilder::CanAppendByCopy(Handle<String> string) {
-  const bool representation_ok =
-      encoding_ == String::TWO_BYTE_ENCODING ||
-      (string->IsFlat() && String::IsOneByteRepresentationUnderneath(*string));
-
-  return representation_ok && CurrentPartCanFit(string->length());
+  return result;
 }
 
 void IncrementalStringBuilder::AppendStringByCopy(Handle<String> string) {
-  DCHECK(CanAppendByCopy(string));
-
-  {
-    DisallowGarbageCollection no_gc;
-    if (encoding_ == String::ONE_BYTE_ENCODING) {
-      String::WriteToFlat(
-          *string,
-          Handle<SeqOneByteString>::cast(current_part())->GetChars(no_gc) +
-              current_index_,
-          0, string->length());
-    } else {
-      String::WriteToFlat(
-          *string,
-          Handle<SeqTwoByteString>::cast(current_part())->GetChars(no_gc) +
-              current_index_,
-          0, string->length());
+  DCHECK(encoding_ == String::TWO_BYTE_ENCODING ||
+         string->IsOneByteRepresentation());
+  const int length = string->length();
+  // Split the string across parts if it does not fit into the current one.
+  int start = 0;
+  while (start < length) {
+    int chunk_length = std::min(length - start, part_length_ - current_index_);
+    {
+      DisallowGarbageCollection no_gc;
+      if (encoding_ == String::ONE_BYTE_ENCODING) {
+        String::WriteToFlat(*string, current_chars<uint8_t>(), start,
+                            chunk_length);
+      } else {
+        String::WriteToFlat(*string, current_chars<base::uc16>(), start,
+                            chunk_length);
+      }
     }
+    current_index_ += chunk_length;
+    start += chunk_length;
+    // Extending reports external memory, which might trigger a GC.
+    if (current_index_ == part_length_) Extend();
+  }
+  DCHECK(HasValidCurrentIndex());
+}
+
+void IncrementalStringBuilder::AppendStringByReference(Handle<String> string) {
+  FinishCurrentPart();
+  const int length = string->length();
+  if (AccumulateLength(length)) {
+    Handle<FixedArray> large_strings = FixedArray::SetAndGrow(
+        isolate_, large_strings_, number_of_large_strings_, string);
+    // Reuse the same handle to avoid being invalidated when exiting handle
+    // scope.
+    large_strings_.PatchValue(*large_strings);
+    parts_.push_back(Part{nullptr, length,
+                          string->IsOneByteRepresentation()
+                              ? String::ONE_BYTE_ENCODING
+                              : String::TWO_BYTE_ENCODING,
+                          number_of_large_strings_++});
+  }
+  // Allocate conservatively.
+  if (!current_part_ || part_length_ != kInitialPartLength) {
+    part_length_ = kInitialPartLength;
+    StartPart();
   }
-  current_index_ += string->length();
-  DCHECK(current_index_ <= part_length_);
-  if (current_index_ == part_length_) Extend();
 }
 
 void IncrementalStringBuilder::AppendString(Handle<String> string) {
-  if (CanAppendByCopy(string)) {
-    AppendStringByCopy(string);
+  if (string->length() >= kMinLengthForAppendByReference) {
+    AppendStringByReference(string);
     return;
   }
-
-  ShrinkCurrentPart();
-  part_length_ = kInitialPartLength;  // Allocate conservatively.
-  Extend();  // Attach current part and allocate new part.
-  Accumulate(string);
+  if (encoding_ == String::ONE_BYTE_ENCODING &&
+      !string->IsOneByteRepresentation()) {
+    ChangeEncoding();
+  }
+  AppendStringByCopy(string);
 }
 }  // namespace internal
 }  // namespace v8
@@ -4,11 +4,33 @@
 
 #include "src/strings/string-case.h"
 
+#include "src/base/bits.h"
 #include "src/base/logging.h"
+#include "src/codegen/cpu-features.h"
 #include "src/common/assert-scope.h"
 #include "src/common/globals.h"
 #include "src/utils/utils.h"
 
+#ifdef _MSC_VER
+// MSVC doesn't define SSE3. However, it does define AVX, and AVX implies SSE3.
+#ifdef __AVX__
+#ifndef __SSE3__
+#define __SSE3__
+#endif
+#endif
+#endif
+
+#ifdef __SSE3__
+#include <immintrin.h>
+#endif
+
+#ifdef V8_HOST_ARCH_ARM64
+// As in src/objects/simd.cc, Neon is only used on 64-bit ARM, where it is
+// always available.
+#define NEON64
+#include <arm_neon.h>
+#endif
+
 namespace v8 {
 namespace internal {
 
@@ -132,5 +154,215 @@ template int FastAsciiConvert<false>(char* dst, const char* src, int length,
 template int FastAsciiConvert<true>(char* dst, const char* src, int length,
                                     bool* changed_out);
 
+namespace {
+
+// Cased Latin-1 letters are A-Z and U+00C0-U+00DE in upper case, and a-z
+// and U+00E0-U+00FE in lower case, except for the multiplication and
+// division signs U+00D7 and U+00F7 in the middle of these ranges.
+constexpr uint8_t kCaseBit = 1 << 5;
+constexpr uint8_t kAsciiLetters = 'Z' - 'A';
+constexpr uint8_t kLatin1Letters = 0xDE - 0xC0;
+constexpr uint8_t kMicroSign = 0xB5;
+constexpr uint8_t kSharpS = 0xDF;
+constexpr uint8_t kYWithDiaeresis = 0xFF;
+
+template <bool is_lower>
+struct Latin1CaseRanges {
+  // The first letters of the ranges of characters which are converted.
+  static constexpr uint8_t kAsciiFirst = is_lower ? 'A' : 'a';
+  static constexpr uint8_t kLatin1First = is_lower ? 0xC0 : 0xE0;
+  static constexpr uint8_t kLatin1Excluded = is_lower ? 0xD7 : 0xF7;
+};
+
+// Converts the characters from {index} on. When converting to upper case,
+// returns false as soon as a character with an upper case beyond Latin-1 is
+// found.
+template <bool is_lower>
+bool ScalarLatin1ConvertCase(uint8_t* dst, const uint8_t* src, int length,
+                             int index, int* sharp_s_count) {
+  using Ranges = Latin1CaseRanges<is_lower>;
+  for (; index < length; ++index) {
+    uint8_t c = src[index];
+    if (!is_lower) {
+      if (V8_UNLIKELY(c == kMicroSign || c == kYWithDiaeresis)) return false;
+      if (V8_UNLIKELY(c == kSharpS)) ++*sharp_s_count;
+    }
+    bool convert =
+        static_cast<uint8_t>(c - Ranges::kAsciiFirst) <= kAsciiLetters ||
+        (static_cast<uint8_t>(c - Ranges::kLatin1First) <= kLatin1Letters &&
+         c != Ranges::kLatin1Excluded);
+    dst[index] = convert ? static_cast<uint8_t>(c ^ kCaseBit) : c;
+  }
+  return true;
+}
+
+#ifdef __SSE3__
+// Returns a mask with all bits set in the bytes of {c} in [first, first +
+// count].
+inline __m128i InRangeSSE(__m128i c, uint8_t first, uint8_t count) {
+  __m128i offset = _mm_sub_epi8(c, _mm_set1_epi8(static_cast<char>(first)));
+  return _mm_cmpeq_epi8(
+      _mm_min_epu8(offset, _mm_set1_epi8(static_cast<char>(count))), offset);
+}
+
+inline __m128i Set1SSE(uint8_t c) {
+  return _mm_set1_epi8(static_cast<char>(c));
+}
+
+template <bool is_lower>
+bool Latin1ConvertCaseSSE(uint8_t* dst, const uint8_t* src, int length,
+                          int* sharp_s_count) {
+  using Ranges = Latin1CaseRanges<is_lower>;
+  const __m128i case_bit = Set1SSE(kCaseBit);
+  int index = 0;
+  for (; index + 16 <= length; index += 16) {
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + index));
+    if (!is_lower) {
+      __m128i special =
+          _mm_or_si128(_mm_cmpeq_epi8(c, Set1SSE(kMicroSign)),
+                       _mm_cmpeq_epi8(c, Set1SSE(kYWithDiaeresis)));
+      if (_mm_movemask_epi8(special) != 0) return false;
+      *sharp_s_count += base::bits::CountPopulation(static_cast<uint32_t>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(c, Set1SSE(kSharpS)))));
+    }
+    __m128i convert = _mm_or_si128(
+        InRangeSSE(c, Ranges::kAsciiFirst, kAsciiLetters),
+        _mm_andnot_si128(_mm_cmpeq_epi8(c, Set1SSE(Ranges::kLatin1Excluded)),
+                         InRangeSSE(c, Ranges::kLatin1First, kLatin1Letters)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + index),
+                     _mm_xor_si128(c, _mm_and_si128(convert, case_bit)));
+  }
+  return ScalarLatin1ConvertCase<is_lower>(dst, src, length, index,
+                                           sharp_s_count);
+}
+#endif  // __SSE3__
+
+#ifdef NEON64
+inline uint8x16_t InRangeNeon(uint8x16_t c, uint8_t first, uint8_t count) {
+  return vcleq_u8(vsubq_u8(c, vdupq_n_u8(first)), vdupq_n_u8(count));
+}
+
+template <bool is_lower>
+bool Latin1ConvertCaseNeon(uint8_t* dst, const uint8_t* src, int length,
+                           int* sharp_s_count) {
+  using Ranges = Latin1CaseRanges<is_lower>;
+  const uint8x16_t case_bit = vdupq_n_u8(kCaseBit);
+  int index = 0;
+  for (; index + 16 <= length; index += 16) {
+    uint8x16_t c = vld1q_u8(src + index);
+    if (!is_lower) {
+      uint8x16_t special = vorrq_u8(vceqq_u8(c, vdupq_n_u8(kMicroSign)),
+                                    vceqq_u8(c, vdupq_n_u8(kYWithDiaeresis)));
+      if (vmaxvq_u8(special) != 0) return false;
+      *sharp_s_count += vaddvq_u8(
+          vandq_u8(vceqq_u8(c, vdupq_n_u8(kSharpS)), vdupq_n_u8(1)));
+    }
+    uint8x16_t convert = vorrq_u8(
+        InRangeNeon(c, Ranges::kAsciiFirst, kAsciiLetters),
+        vbicq_u8(InRangeNeon(c, Ranges::kLatin1First, kLatin1Letters),
+                 vceqq_u8(c, vdupq_n_u8(Ranges::kLatin1Excluded))));
+    vst1q_u8(dst + index, veorq_u8(c, vandq_u8(convert, case_bit)));
+  }
+  return ScalarLatin1ConvertCase<is_lower>(dst, src, length, index,
+                                           sharp_s_count);
+}
+#endif  // NEON64
+
+#if defined(_MSC_VER) && defined(__clang__)
+// Generating AVX2 code with Clang on Windows without the /arch:AVX2 flag does
+// not seem possible at the moment.
+#define IS_CLANG_WIN 1
+#endif
+
+// As in src/objects/simd.cc, the AVX2 code is compiled with a target attribute
+// and only called if the CPU supports AVX2.
+#if defined(__SSE3__) && !defined(_M_IX86) && !defined(IS_CLANG_WIN) && \
+    (defined(V8_TARGET_ARCH_IA32) || defined(V8_TARGET_ARCH_X64))
+#define HAS_AVX2_CASE_CONVERSION 1
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+TARGET_AVX2 inline __m256i Set1AVX2(uint8_t c) {
+  return _mm256_set1_epi8(static_cast<char>(c));
+}
+
+TARGET_AVX2 inline __m256i InRangeAVX2(__m256i c, uint8_t first,
+                                       uint8_t count) {
+  __m256i offset = _mm256_sub_epi8(c, Set1AVX2(first));
+  return _mm256_cmpeq_epi8(_mm256_min_epu8(offset, Set1AVX2(count)), offset);
+}
+
+template <bool is_lower>
+TARGET_AVX2 bool Latin1ConvertCaseAVX2(uint8_t* dst, const uint8_t* src,
+                                       int length, int* sharp_s_count) {
+  using Ranges = Latin1CaseRanges<is_lower>;
+  const __m256i case_bit = Set1AVX2(kCaseBit);
+  int index = 0;
+  for (; index + 32 <= length; index += 32) {
+    __m256i c =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + index));
+    if (!is_lower) {
+      __m256i special =
+          _mm256_or_si256(_mm256_cmpeq_epi8(c, Set1AVX2(kMicroSign)),
+                          _mm256_cmpeq_epi8(c, Set1AVX2(kYWithDiaeresis)));
+      if (_mm256_movemask_epi8(special) != 0) return false;
+      *sharp_s_count += base::bits::CountPopulation(static_cast<uint32_t>(
+          _mm256_movemask_epi8(_mm256_cmpeq_epi8(c, Set1AVX2(kSharpS)))));
+    }
+    __m256i convert = _mm256_or_si256(
+        InRangeAVX2(c, Ranges::kAsciiFirst, kAsciiLetters),
+        _mm256_andnot_si256(
+            _mm256_cmpeq_epi8(c, Set1AVX2(Ranges::kLatin1Excluded)),
+            InRangeAVX2(c, Ranges::kLatin1First, kLatin1Letters)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(dst + index),
+        _mm256_xor_si256(c, _mm256_and_si256(convert, case_bit)));
+  }
+  return ScalarLatin1ConvertCase<is_lower>(dst, src, length, index,
+                                           sharp_s_count);
+}
+
+#undef TARGET_AVX2
+#endif
+
+#undef IS_CLANG_WIN
+
+template <bool is_lower>
+bool Latin1ConvertCase(uint8_t* dst, const uint8_t* src, int length,
+                       int* sharp_s_count) {
+  *sharp_s_count = 0;
+#ifdef HAS_AVX2_CASE_CONVERSION
+  if (CpuFeatures::IsSupported(AVX2)) {
+    return Latin1ConvertCaseAVX2<is_lower>(dst, src, length, sharp_s_count);
+  }
+#endif
+#ifdef __SSE3__
+  return Latin1ConvertCaseSSE<is_lower>(dst, src, length, sharp_s_count);
+#elif defined(NEON64)
+  return Latin1ConvertCaseNeon<is_lower>(dst, src, length, sharp_s_count);
+#else
+  return ScalarLatin1ConvertCase<is_lower>(dst, src, length, 0,
+                                           sharp_s_count);
+#endif
+}
+
+}  // namespace
+
+void Latin1ConvertToLower(uint8_t* dst, const uint8_t* src, int length) {
+  int sharp_s_count;
+  Latin1ConvertCase<true>(dst, src, length, &sharp_s_count);
+}
+
+bool Latin1ConvertToUpper(uint8_t* dst, const uint8_t* src, int length,
+                          int* sharp_s_count) {
+  return Latin1ConvertCase<false>(dst, src, length, sharp_s_count);
+}
+
+#undef HAS_AVX2_CASE_CONVERSION
+#undef NEON64
+
 }  // namespace internal
 }  // namespace v8
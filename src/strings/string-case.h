@@ -5,12 +5,32 @@
 #ifndef V8_STRINGS_STRING_CASE_H_
 #define V8_STRINGS_STRING_CASE_H_
 
+#include <stdint.h>
+
+#include "src/base/macros.h"
+
 namespace v8 {
 namespace internal {
 
 template <bool is_lower>
 int FastAsciiConvert(char* dst, const char* src, int length, bool* changed_out);
 
+// Case conversion of Latin-1 characters in the root locale, a vector at a
+// time with AVX2 (if the CPU supports it), SSE2 or Neon. Lower case Latin-1
+// letters differ from their upper case counterparts in bit 5 only.
+
+// Writes the lower case of the {length} characters of {src} to {dst}. The
+// lower case of a Latin-1 character is a Latin-1 character.
+V8_EXPORT_PRIVATE void Latin1ConvertToLower(uint8_t* dst, const uint8_t* src,
+                                            int length);
+
+// Writes the upper case of the {length} characters of {src} to {dst}, except
+// for sharp-s (U+00DF) which is copied and counted in {sharp_s_count}, as its
+// upper case is "SS". Returns false if {src} contains U+00B5 or U+00FF, whose
+// upper case is beyond Latin-1.
+V8_EXPORT_PRIVATE bool Latin1ConvertToUpper(uint8_t* dst, const uint8_t* src,
+                                            int length, int* sharp_s_count);
+
 }  // namespace internal
 }  // namespace v8
 
@@ -0,0 +1,188 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/strings/string-compare-simd.h"
+
+#include "src/base/bits.h"
+#include "src/base/logging.h"
+#include "src/codegen/cpu-features.h"
+
+#ifdef _MSC_VER
+// MSVC doesn't define SSE3. However, it does define AVX, and AVX implies SSE3.
+#ifdef __AVX__
+#ifndef __SSE3__
+#define __SSE3__
+#endif
+#endif
+#endif
+
+#ifdef __SSE3__
+#include <immintrin.h>
+#endif
+
+#ifdef V8_HOST_ARCH_ARM64
+// As in src/objects/simd.cc, Neon is only used on 64-bit ARM, where it is
+// always available.
+#define NEON64
+#include <arm_neon.h>
+#endif
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// All kernels compare {rhs}, which has two-byte characters, with {lhs}, whose
+// one-byte characters are zero-extended to 16 bits. Equality is checked as a
+// three-way comparison, which only needs more work at the first difference.
+template <typename Char>
+int ScalarCompareChars(const Char* lhs, const base::uc16* rhs, size_t chars,
+                       size_t index) {
+  for (; index < chars; ++index) {
+    int r = static_cast<int>(lhs[index]) - static_cast<int>(rhs[index]);
+    if (r != 0) return r;
+  }
+  return 0;
+}
+
+#ifdef __SSE3__
+// Loads 8 characters as 16-bit lanes.
+inline __m128i Load8SSE(const uint8_t* chars) {
+  return _mm_unpacklo_epi8(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chars)),
+      _mm_setzero_si128());
+}
+
+inline __m128i Load8SSE(const base::uc16* chars) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+}
+
+template <typename Char>
+int CompareCharsSSE(const Char* lhs, const base::uc16* rhs, size_t chars) {
+  size_t index = 0;
+  for (; index + 8 <= chars; index += 8) {
+    __m128i equal =
+        _mm_cmpeq_epi16(Load8SSE(lhs + index), Load8SSE(rhs + index));
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+    if (mask != 0xFFFF) {
+      // Each character sets two bits of the mask.
+      index += base::bits::CountTrailingZeros(~mask) / 2;
+      return static_cast<int>(lhs[index]) - static_cast<int>(rhs[index]);
+    }
+  }
+  return ScalarCompareChars(lhs, rhs, chars, index);
+}
+#endif  // __SSE3__
+
+#ifdef NEON64
+inline uint16x8_t Load8Neon(const uint8_t* chars) {
+  return vmovl_u8(vld1_u8(chars));
+}
+
+inline uint16x8_t Load8Neon(const base::uc16* chars) {
+  return vld1q_u16(chars);
+}
+
+template <typename Char>
+int CompareCharsNeon(const Char* lhs, const base::uc16* rhs, size_t chars) {
+  size_t index = 0;
+  for (; index + 8 <= chars; index += 8) {
+    uint16x8_t equal =
+        vceqq_u16(Load8Neon(lhs + index), Load8Neon(rhs + index));
+    if (vminvq_u16(equal) == 0) {
+      // Neon has no movemask; find the difference in these 8 characters.
+      return ScalarCompareChars(lhs, rhs, index + 8, index);
+    }
+  }
+  return ScalarCompareChars(lhs, rhs, chars, index);
+}
+#endif  // NEON64
+
+#if defined(_MSC_VER) && defined(__clang__)
+// Generating AVX2 code with Clang on Windows without the /arch:AVX2 flag does
+// not seem possible at the moment.
+#define IS_CLANG_WIN 1
+#endif
+
+// As in src/objects/simd.cc, the AVX2 code is compiled with a target attribute
+// and only called if the CPU supports AVX2.
+#if defined(__SSE3__) && !defined(_M_IX86) && !defined(IS_CLANG_WIN) && \
+    (defined(V8_TARGET_ARCH_IA32) || defined(V8_TARGET_ARCH_X64))
+#define HAS_AVX2_COMPARE 1
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// Loads 16 characters as 16-bit lanes.
+TARGET_AVX2 inline __m256i Load16AVX2(const uint8_t* chars) {
+  return _mm256_cvtepu8_epi16(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars)));
+}
+
+TARGET_AVX2 inline __m256i Load16AVX2(const base::uc16* chars) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars));
+}
+
+template <typename Char>
+TARGET_AVX2 int CompareCharsAVX2(const Char* lhs, const base::uc16* rhs,
+                                 size_t chars) {
+  size_t index = 0;
+  for (; index + 16 <= chars; index += 16) {
+    __m256i equal =
+        _mm256_cmpeq_epi16(Load16AVX2(lhs + index), Load16AVX2(rhs + index));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+    if (mask != 0xFFFFFFFF) {
+      // Each character sets two bits of the mask.
+      index += base::bits::CountTrailingZeros(~mask) / 2;
+      return static_cast<int>(lhs[index]) - static_cast<int>(rhs[index]);
+    }
+  }
+  return ScalarCompareChars(lhs, rhs, chars, index);
+}
+
+#undef TARGET_AVX2
+#endif
+
+#undef IS_CLANG_WIN
+
+template <typename Char>
+int CompareCharsImpl(const Char* lhs, const base::uc16* rhs, size_t chars) {
+#ifdef HAS_AVX2_COMPARE
+  if (CpuFeatures::IsSupported(AVX2)) {
+    return CompareCharsAVX2(lhs, rhs, chars);
+  }
+#endif
+#ifdef __SSE3__
+  return CompareCharsSSE(lhs, rhs, chars);
+#elif defined(NEON64)
+  return CompareCharsNeon(lhs, rhs, chars);
+#else
+  return ScalarCompareChars(lhs, rhs, chars, 0);
+#endif
+}
+
+}  // namespace
+
+bool CompareCharsEqualVectorized(const uint8_t* lhs, const base::uc16* rhs,
+                                 size_t chars) {
+  return CompareCharsImpl(lhs, rhs, chars) == 0;
+}
+
+int CompareCharsVectorized(const uint8_t* lhs, const base::uc16* rhs,
+                           size_t chars) {
+  return CompareCharsImpl(lhs, rhs, chars);
+}
+
+int CompareCharsVectorized(const base::uc16* lhs, const base::uc16* rhs,
+                           size_t chars) {
+  return CompareCharsImpl(lhs, rhs, chars);
+}
+
+#undef HAS_AVX2_COMPARE
+#undef NEON64
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,59 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_STRINGS_STRING_COMPARE_SIMD_H_
+#define V8_STRINGS_STRING_COMPARE_SIMD_H_
+
+#include "src/base/macros.h"
+#include "src/base/strings.h"
+#include "src/utils/utils.h"
+
+namespace v8 {
+namespace internal {
+
+// Vectorized versions of CompareCharsEqual and CompareChars for the cases
+// which memcmp does not cover: comparing one-byte with two-byte characters
+// for equality, and the three-way comparison of two-byte characters with
+// one-byte or two-byte characters. They use AVX2 if the CPU supports it,
+// SSE2 or Neon, and scalar loops on other platforms. Other cases use memcmp.
+
+// Returns whether the first {chars} characters of {lhs} and {rhs} are equal.
+V8_EXPORT_PRIVATE bool CompareCharsEqualVectorized(const uint8_t* lhs,
+                                                   const base::uc16* rhs,
+                                                   size_t chars);
+
+inline bool CompareCharsEqualVectorized(const base::uc16* lhs,
+                                        const uint8_t* rhs, size_t chars) {
+  return CompareCharsEqualVectorized(rhs, lhs, chars);
+}
+
+template <typename Char>
+inline bool CompareCharsEqualVectorized(const Char* lhs, const Char* rhs,
+                                        size_t chars) {
+  return CompareCharsEqual(lhs, rhs, chars);
+}
+
+// Returns the difference of the first pair of different characters in the
+// first {chars} characters of {lhs} and {rhs}, or 0 if there is none.
+V8_EXPORT_PRIVATE int CompareCharsVectorized(const uint8_t* lhs,
+                                             const base::uc16* rhs,
+                                             size_t chars);
+V8_EXPORT_PRIVATE int CompareCharsVectorized(const base::uc16* lhs,
+                                             const base::uc16* rhs,
+                                             size_t chars);
+
+inline int CompareCharsVectorized(const base::uc16* lhs, const uint8_t* rhs,
+                                  size_t chars) {
+  return -CompareCharsVectorized(rhs, lhs, chars);
+}
+
+inline int CompareCharsVectorized(const uint8_t* lhs, const uint8_t* rhs,
+                                  size_t chars) {
+  return CompareChars(lhs, rhs, chars);
+}
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_STRINGS_STRING_COMPARE_SIMD_H_
@@ -0,0 +1,252 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/strings/string-search-simd.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "src/base/bits.h"
+#include "src/base/logging.h"
+#include "src/codegen/cpu-features.h"
+
+#ifdef _MSC_VER
+// MSVC doesn't define SSE3. However, it does define AVX, and AVX implies SSE3.
+#ifdef __AVX__
+#ifndef __SSE3__
+#define __SSE3__
+#endif
+#endif
+#endif
+
+#ifdef __SSE3__
+#include <immintrin.h>
+#endif
+
+#ifdef V8_HOST_ARCH_ARM64
+// As in src/objects/simd.cc, Neon is only used on 64-bit ARM, where it is
+// always available.
+#define NEON64
+#include <arm_neon.h>
+#endif
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Compares the characters between the first and the last one, which are
+// known to match.
+template <typename Char>
+inline bool MatchesInner(const Char* subject, const Char* pattern,
+                         int pattern_length) {
+  return pattern_length <= 2 ||
+         memcmp(subject + 1, pattern + 1,
+                (pattern_length - 2) * sizeof(Char)) == 0;
+}
+
+// Checks the positions which are too close to the end of the subject for
+// a full vector, and is used if SIMD is not available.
+template <typename Char>
+int ScalarSearch(const Char* subject, int subject_length, const Char* pattern,
+                 int pattern_length, int index) {
+  const Char first = pattern[0];
+  const Char last = pattern[pattern_length - 1];
+  for (int n = subject_length - pattern_length; index <= n; ++index) {
+    if (subject[index] == first &&
+        subject[index + pattern_length - 1] == last &&
+        MatchesInner(subject + index, pattern, pattern_length)) {
+      return index;
+    }
+  }
+  return -1;
+}
+
+// {movemask} returns a mask with {bits_per_char} bits for each character, of
+// which only the lowest may be set.
+#define VECTORIZED_SEARCH_LOOP(vector_type, set1, load, cmpeq, and_op,     \
+                               movemask, bits_per_char)                    \
+  {                                                                        \
+    constexpr int kCharsPerVector = sizeof(vector_type) / sizeof(Char);    \
+    const vector_type first = set1(pattern[0]);                            \
+    const vector_type last = set1(pattern[pattern_length - 1]);            \
+    const Char* subject_last = subject + pattern_length - 1;               \
+    for (; index + kCharsPerVector + pattern_length - 1 <= subject_length; \
+         index += kCharsPerVector) {                                       \
+      vector_type eq_first = cmpeq(first, load(subject + index));          \
+      vector_type eq_last = cmpeq(last, load(subject_last + index));       \
+      auto mask = movemask(and_op(eq_first, eq_last));                     \
+      while (mask != 0) {                                                  \
+        int offset = base::bits::CountTrailingZeros(mask) / bits_per_char; \
+        if (MatchesInner(subject + index + offset, pattern,                \
+                         pattern_length)) {                                \
+          return index + offset;                                           \
+        }                                                                  \
+        mask &= mask - 1;                                                  \
+      }                                                                    \
+    }                                                                      \
+  }
+
+#ifdef __SSE3__
+template <typename Char>
+int SearchSSE(const Char* subject, int subject_length, const Char* pattern,
+              int pattern_length, int index) {
+#define LOAD(p) _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+  if constexpr (sizeof(Char) == 1) {
+#define SET1(c) _mm_set1_epi8(static_cast<char>(c))
+#define MOVEMASK(v) static_cast<uint32_t>(_mm_movemask_epi8(v))
+    VECTORIZED_SEARCH_LOOP(__m128i, SET1, LOAD, _mm_cmpeq_epi8, _mm_and_si128,
+                           MOVEMASK, 1)
+#undef SET1
+#undef MOVEMASK
+  } else {
+#define SET1(c) _mm_set1_epi16(static_cast<int16_t>(c))
+#define MOVEMASK(v) (static_cast<uint32_t>(_mm_movemask_epi8(v)) & 0x5555)
+    VECTORIZED_SEARCH_LOOP(__m128i, SET1, LOAD, _mm_cmpeq_epi16,
+                           _mm_and_si128, MOVEMASK, 2)
+#undef SET1
+#undef MOVEMASK
+  }
+#undef LOAD
+  return ScalarSearch(subject, subject_length, pattern, pattern_length, index);
+}
+#endif  // __SSE3__
+
+#if defined(_MSC_VER) && defined(__clang__)
+// Generating AVX2 code with Clang on Windows without the /arch:AVX2 flag does
+// not seem possible at the moment.
+#define IS_CLANG_WIN 1
+#endif
+
+// As in src/objects/simd.cc, the AVX2 code is compiled with a target attribute
+// and only called if the CPU supports AVX2.
+#if defined(__SSE3__) && !defined(_M_IX86) && !defined(IS_CLANG_WIN) && \
+    (defined(V8_TARGET_ARCH_IA32) || defined(V8_TARGET_ARCH_X64))
+#define HAS_AVX2_SEARCH 1
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+template <typename Char>
+TARGET_AVX2 int SearchAVX2(const Char* subject, int subject_length,
+                           const Char* pattern, int pattern_length,
+                           int index) {
+#define LOAD(p) _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+  if constexpr (sizeof(Char) == 1) {
+#define SET1(c) _mm256_set1_epi8(static_cast<char>(c))
+#define MOVEMASK(v) static_cast<uint32_t>(_mm256_movemask_epi8(v))
+    VECTORIZED_SEARCH_LOOP(__m256i, SET1, LOAD, _mm256_cmpeq_epi8,
+                           _mm256_and_si256, MOVEMASK, 1)
+#undef SET1
+#undef MOVEMASK
+  } else {
+#define SET1(c) _mm256_set1_epi16(static_cast<int16_t>(c))
+#define MOVEMASK(v) \
+  (static_cast<uint32_t>(_mm256_movemask_epi8(v)) & 0x55555555)
+    VECTORIZED_SEARCH_LOOP(__m256i, SET1, LOAD, _mm256_cmpeq_epi16,
+                           _mm256_and_si256, MOVEMASK, 2)
+#undef SET1
+#undef MOVEMASK
+  }
+#undef LOAD
+  return ScalarSearch(subject, subject_length, pattern, pattern_length, index);
+}
+#undef TARGET_AVX2
+#endif
+
+#undef IS_CLANG_WIN
+
+#ifdef NEON64
+// Neon has no movemask. Shifting each 16-bit lane right by 4 and narrowing it
+// to 8 bits yields 4 bits for each byte of the comparison result.
+inline uint64_t NeonNibbleMask(uint8x16_t v) {
+  uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+}
+
+template <typename Char>
+int SearchNeon(const Char* subject, int subject_length, const Char* pattern,
+               int pattern_length, int index) {
+  if constexpr (sizeof(Char) == 1) {
+#define LOAD(p) vld1q_u8(p)
+#define MOVEMASK(v) (NeonNibbleMask(v) & 0x1111111111111111)
+    VECTORIZED_SEARCH_LOOP(uint8x16_t, vdupq_n_u8, LOAD, vceqq_u8, vandq_u8,
+                           MOVEMASK, 4)
+#undef LOAD
+#undef MOVEMASK
+  } else {
+#define LOAD(p) vld1q_u16(p)
+#define MOVEMASK(v) \
+  (NeonNibbleMask(vreinterpretq_u8_u16(v)) & 0x0101010101010101)
+    VECTORIZED_SEARCH_LOOP(uint16x8_t, vdupq_n_u16, LOAD, vceqq_u16,
+                           vandq_u16, MOVEMASK, 8)
+#undef LOAD
+#undef MOVEMASK
+  }
+  return ScalarSearch(subject, subject_length, pattern, pattern_length, index);
+}
+#endif  // NEON64
+
+#undef VECTORIZED_SEARCH_LOOP
+
+template <typename Char>
+int Search(base::Vector<const Char> subject, base::Vector<const Char> pattern,
+           int index) {
+  DCHECK_LT(0, pattern.length());
+  DCHECK_GE(kSimdStringSearchMaxPatternLength, pattern.length());
+  DCHECK_LE(0, index);
+#ifdef HAS_AVX2_SEARCH
+  if (CpuFeatures::IsSupported(AVX2)) {
+    return SearchAVX2(subject.begin(), subject.length(), pattern.begin(),
+                      pattern.length(), index);
+  }
+#endif
+#ifdef __SSE3__
+  return SearchSSE(subject.begin(), subject.length(), pattern.begin(),
+                   pattern.length(), index);
+#elif defined(NEON64)
+  return SearchNeon(subject.begin(), subject.length(), pattern.begin(),
+                    pattern.length(), index);
+#else
+  return ScalarSearch(subject.begin(), subject.length(), pattern.begin(),
+                      pattern.length(), index);
+#endif
+}
+
+}  // namespace
+
+bool SimdStringSearchIsSupported() {
+#if defined(__SSE3__) || defined(NEON64)
+  return true;
+#else
+  return false;
+#endif
+}
+
+int SimdStringSearch(base::Vector<const uint8_t> subject,
+                     base::Vector<const uint8_t> pattern, int index) {
+  return Search(subject, pattern, index);
+}
+
+int SimdStringSearch(base::Vector<const base::uc16> subject,
+                     base::Vector<const base::uc16> pattern, int index) {
+  return Search(subject, pattern, index);
+}
+
+int SimdStringSearch(base::Vector<const base::uc16> subject,
+                     base::Vector<const uint8_t> pattern, int index) {
+  base::uc16 wide_pattern[kSimdStringSearchMaxPatternLength];
+  DCHECK_GE(kSimdStringSearchMaxPatternLength, pattern.length());
+  std::copy(pattern.begin(), pattern.end(), wide_pattern);
+  return Search(subject,
+                base::Vector<const base::uc16>(wide_pattern, pattern.length()),
+                index);
+}
+
+#undef HAS_AVX2_SEARCH
+#undef NEON64
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,42 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_STRINGS_STRING_SEARCH_SIMD_H_
+#define V8_STRINGS_STRING_SEARCH_SIMD_H_
+
+#include "src/base/strings.h"
+#include "src/base/vector.h"
+
+namespace v8 {
+namespace internal {
+
+// Vectorized substring search for short patterns ("generic SIMD" search):
+// for a whole vector of candidate positions at once, the first and the last
+// character of the pattern are compared with the subject, and only positions
+// where both match are compared in full. This inspects each subject character
+// about twice in vector registers, independent of the pattern, and has no
+// setup cost, which makes it faster than Boyer-Moore(-Horspool) for short
+// patterns. Uses AVX2 if the CPU supports it, SSE2 or Neon otherwise.
+
+// Longest pattern which is searched with SimdStringSearch. Longer patterns
+// skip sufficiently far with Boyer-Moore.
+constexpr int kSimdStringSearchMaxPatternLength = 32;
+
+// Whether SimdStringSearch is vectorized on this platform.
+bool SimdStringSearchIsSupported();
+
+// Returns the index of the first occurrence of {pattern} in {subject} at or
+// after {index}, or -1. The pattern must not be empty, and not be longer than
+// {kSimdStringSearchMaxPatternLength}.
+int SimdStringSearch(base::Vector<const uint8_t> subject,
+                     base::Vector<const uint8_t> pattern, int index);
+int SimdStringSearch(base::Vector<const base::uc16> subject,
+                     base::Vector<const base::uc16> pattern, int index);
+int SimdStringSearch(base::Vector<const base::uc16> subject,
+                     base::Vector<const uint8_t> pattern, int index);
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_STRINGS_STRING_SEARCH_SIMD_H_
@@ -9,6 +9,7 @@
 #include "src/base/vector.h"
 #include "src/execution/isolate.h"
 #include "src/objects/string.h"
+#include "src/strings/string-search-simd.h"
 
 namespace v8 {
 namespace internal {
@@ -67,6 +68,10 @@ class StringSearch : private StringSearchBase {
       }
     }
     int pattern_length = pattern_.length();
+    if (UseSimdSearch(pattern_length)) {
+      strategy_ = &SimdSearch;
+      return;
+    }
     if (pattern_length < kBMMinPatternLength) {
       if (pattern_length == 1) {
         strategy_ = &SingleCharSearch;
@@ -106,6 +111,10 @@ class StringSearch : private StringSearchBase {
                               base::Vector<const SubjectChar> subject,
                               int start_index);
 
+  static int SimdSearch(StringSearch<PatternChar, SubjectChar>* search,
+                        base::Vector<const SubjectChar> subject,
+                        int start_index);
+
   static int LinearSearch(StringSearch<PatternChar, SubjectChar>* search,
                           base::Vector<const SubjectChar> subject,
                           int start_index);
@@ -126,6 +135,15 @@ class StringSearch : private StringSearchBase {
 
   void PopulateBoyerMooreTable();
 
+  static inline bool UseSimdSearch(int pattern_length) {
+    if (sizeof(PatternChar) > sizeof(SubjectChar)) return false;
+    if (pattern_length > kSimdStringSearchMaxPatternLength) return false;
+    // Single characters are found with memchr in one-byte subjects, which is
+    // vectorized already.
+    if (pattern_length == 1 && sizeof(SubjectChar) == 1) return false;
+    return SimdStringSearchIsSupported();
+  }
+
   static inline bool exceedsOneByte(uint8_t c) { return false; }
 
   static inline bool exceedsOneByte(uint16_t c) {
@@ -246,6 +264,21 @@ int StringSearch<PatternChar, SubjectChar>::SingleCharSearch(
   return FindFirstCharacter(search->pattern_, subject, index);
 }
 
+//---------------------------------------------------------------------
+// Vectorized Search Strategy for short patterns
+//---------------------------------------------------------------------
+
+template <typename PatternChar, typename SubjectChar>
+int StringSearch<PatternChar, SubjectChar>::SimdSearch(
+    StringSearch<PatternChar, SubjectChar>* search,
+    base::Vector<const SubjectChar> subject, int index) {
+  if constexpr (sizeof(PatternChar) <= sizeof(SubjectChar)) {
+    return SimdStringSearch(subject, search->pattern_, index);
+  } else {
+    UNREACHABLE();
+  }
+}
+
 //---------------------------------------------------------------------
 // Linear Search Strategy
 //---------------------------------------------------------------------
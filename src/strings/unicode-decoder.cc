@@ -5,6 +5,7 @@
 #include "src/strings/unicode-decoder.h"
 
 #include "src/strings/unicode-inl.h"
+#include "src/strings/utf8-simd.h"
 #include "src/utils/memcopy.h"
 
 #if V8_ENABLE_WEBASSEMBLY
@@ -59,11 +60,22 @@ struct DecoderTraits<StrictUtf8Decoder> {
 template <class Decoder>
 Utf8DecoderBase<Decoder>::Utf8DecoderBase(base::Vector<const uint8_t> data)
     : encoding_(Encoding::kAscii),
-      non_ascii_start_(NonAsciiStart(data.begin(), data.length())),
+      non_ascii_start_(AsciiPrefixLength(data)),
       utf16_length_(non_ascii_start_) {
   using Traits = DecoderTraits<Decoder>;
   if (non_ascii_start_ == data.length()) return;
 
+  // Valid input, which is the common case, decodes to the same characters
+  // with all decoders, and its length can be computed a vector at a time.
+  int rest_utf16_length;
+  bool rest_is_one_byte;
+  if (ValidateUtf8(data.SubVectorFrom(non_ascii_start_), &rest_utf16_length,
+                   &rest_is_one_byte)) {
+    utf16_length_ += rest_utf16_length;
+    encoding_ = rest_is_one_byte ? Encoding::kLatin1 : Encoding::kUtf16;
+    return;
+  }
+
   bool is_one_byte = true;
   auto state = Traits::DfaDecoder::kAccept;
   uint32_t current = 0;
@@ -76,9 +88,11 @@ Utf8DecoderBase<Decoder>::Utf8DecoderBase(base::Vector<const uint8_t> data)
                   state == Traits::DfaDecoder::kAccept)) {
       DCHECK_EQ(0u, current);
       DCHECK(!Traits::IsInvalidSurrogatePair(previous, *cursor));
-      previous = *cursor;
-      utf16_length_++;
-      cursor++;
+      int ascii_length = AsciiPrefixLength(
+          base::Vector<const uint8_t>(cursor, end - cursor));
+      cursor += ascii_length;
+      previous = cursor[-1];
+      utf16_length_ += ascii_length;
       continue;
     }
 
@@ -144,8 +158,11 @@ void Utf8DecoderBase<Decoder>::Decode(Char* out,
     if (V8_LIKELY(*cursor <= unibrow::Utf8::kMaxOneByteChar &&
                   state == Traits::DfaDecoder::kAccept)) {
       DCHECK_EQ(0u, current);
-      *(out++) = static_cast<Char>(*cursor);
-      cursor++;
+      int ascii_length = AsciiPrefixLength(
+          base::Vector<const uint8_t>(cursor, end - cursor));
+      CopyChars(out, cursor, ascii_length);
+      out += ascii_length;
+      cursor += ascii_length;
       continue;
     }
 
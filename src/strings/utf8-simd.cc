@@ -0,0 +1,541 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/strings/utf8-simd.h"
+
+#include <algorithm>
+
+#include "src/base/bits.h"
+#include "src/base/logging.h"
+#include "src/codegen/cpu-features.h"
+#include "src/strings/unicode-inl.h"
+
+#ifdef _MSC_VER
+// MSVC doesn't define SSE3. However, it does define AVX, and AVX implies SSE3.
+#ifdef __AVX__
+#ifndef __SSE3__
+#define __SSE3__
+#endif
+#endif
+#endif
+
+#ifdef __SSE3__
+#include <immintrin.h>
+#endif
+
+#ifdef V8_HOST_ARCH_ARM64
+// As in src/objects/simd.cc, Neon is only used on 64-bit ARM, where it is
+// always available.
+#define NEON64
+#include <arm_neon.h>
+#endif
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+template <typename Char>
+int ScalarAsciiPrefixLength(const Char* chars, int length, int index) {
+  for (; index < length; ++index) {
+    if (chars[index] > unibrow::Utf8::kMaxOneByteChar) break;
+  }
+  return index;
+}
+
+int ScalarUtf8EncodedLength(const uint8_t* chars, int length, int index) {
+  int utf8_length = 0;
+  for (; index < length; ++index) utf8_length += 1 + (chars[index] >> 7);
+  return utf8_length;
+}
+
+int ScalarUtf8EncodedLength(const base::uc16* chars, int length, int index) {
+  int utf8_length = 0;
+  int previous = index == 0 ? unibrow::Utf16::kNoPreviousCharacter
+                            : chars[index - 1];
+  for (; index < length; ++index) {
+    utf8_length += unibrow::Utf8::Length(chars[index], previous);
+    previous = chars[index];
+  }
+  return utf8_length;
+}
+
+#ifdef __SSE3__
+#define LOAD(p) _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+
+int AsciiPrefixLengthSSE(const uint8_t* chars, int length) {
+  int index = 0;
+  for (; index + 16 <= length; index += 16) {
+    uint32_t mask =
+        static_cast<uint32_t>(_mm_movemask_epi8(LOAD(chars + index)));
+    if (mask != 0) return index + base::bits::CountTrailingZeros(mask);
+  }
+  return ScalarAsciiPrefixLength(chars, length, index);
+}
+
+int AsciiPrefixLengthSSE(const base::uc16* chars, int length) {
+  const __m128i non_ascii_bits = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+  const __m128i zero = _mm_setzero_si128();
+  int index = 0;
+  for (; index + 8 <= length; index += 8) {
+    __m128i ascii = _mm_cmpeq_epi16(
+        _mm_and_si128(LOAD(chars + index), non_ascii_bits), zero);
+    uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(ascii)) & 0xFFFF;
+    if (mask != 0) return index + base::bits::CountTrailingZeros(mask) / 2;
+  }
+  return ScalarAsciiPrefixLength(chars, length, index);
+}
+
+int Utf8EncodedLengthSSE(const uint8_t* chars, int length) {
+  int utf8_length = 0;
+  int index = 0;
+  for (; index + 16 <= length; index += 16) {
+    // Non-ASCII characters take two bytes.
+    uint32_t mask =
+        static_cast<uint32_t>(_mm_movemask_epi8(LOAD(chars + index)));
+    utf8_length += 16 + base::bits::CountPopulation(mask);
+  }
+  return utf8_length + ScalarUtf8EncodedLength(chars, length, index);
+}
+
+int Utf8EncodedLengthSSE(const base::uc16* chars, int length) {
+  const __m128i non_ascii_bits = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+  const __m128i three_byte_bits = _mm_set1_epi16(static_cast<int16_t>(0xF800));
+  const __m128i surrogate = _mm_set1_epi16(static_cast<int16_t>(0xD800));
+  const __m128i zero = _mm_setzero_si128();
+  int utf8_length = 0;
+  int index = 0;
+  for (; index + 8 <= length; index += 8) {
+    __m128i v = LOAD(chars + index);
+    __m128i high = _mm_and_si128(v, three_byte_bits);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, surrogate)) != 0) {
+      // Surrogate pairs may span vectors, count them one by one.
+      utf8_length += ScalarUtf8EncodedLength(chars, index + 8, index);
+      continue;
+    }
+    // Each character takes three bytes, one less if it needs at most two
+    // bytes, and another one less if it is ASCII. The masks have two bits
+    // per character.
+    uint32_t ascii = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi16(_mm_and_si128(v, non_ascii_bits), zero)));
+    uint32_t up_to_two_bytes =
+        static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)));
+    utf8_length += 3 * 8 - (base::bits::CountPopulation(ascii) +
+                            base::bits::CountPopulation(up_to_two_bytes)) /
+                               2;
+  }
+  return utf8_length + ScalarUtf8EncodedLength(chars, length, index);
+}
+
+#undef LOAD
+#endif  // __SSE3__
+
+#ifdef NEON64
+// Neon has no movemask. Shifting each 16-bit lane right by 4 and narrowing it
+// to 8 bits yields 4 bits for each byte of the comparison result.
+inline uint64_t NeonNibbleMask(uint8x16_t v) {
+  uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+}
+
+int AsciiPrefixLengthNeon(const uint8_t* chars, int length) {
+  const uint8x16_t first_non_ascii = vdupq_n_u8(0x80);
+  int index = 0;
+  for (; index + 16 <= length; index += 16) {
+    uint64_t mask =
+        NeonNibbleMask(vcgeq_u8(vld1q_u8(chars + index), first_non_ascii));
+    if (mask != 0) return index + base::bits::CountTrailingZeros(mask) / 4;
+  }
+  return ScalarAsciiPrefixLength(chars, length, index);
+}
+
+int AsciiPrefixLengthNeon(const base::uc16* chars, int length) {
+  const uint16x8_t first_non_ascii = vdupq_n_u16(0x80);
+  int index = 0;
+  for (; index + 8 <= length; index += 8) {
+    uint16x8_t non_ascii = vcgeq_u16(vld1q_u16(chars + index), first_non_ascii);
+    uint64_t mask = NeonNibbleMask(vreinterpretq_u8_u16(non_ascii));
+    if (mask != 0) return index + base::bits::CountTrailingZeros(mask) / 8;
+  }
+  return ScalarAsciiPrefixLength(chars, length, index);
+}
+
+int Utf8EncodedLengthNeon(const uint8_t* chars, int length) {
+  int utf8_length = 0;
+  int index = 0;
+  for (; index + 16 <= length; index += 16) {
+    // Non-ASCII characters take two bytes.
+    utf8_length += 16 + vaddvq_u8(vshrq_n_u8(vld1q_u8(chars + index), 7));
+  }
+  return utf8_length + ScalarUtf8EncodedLength(chars, length, index);
+}
+
+int Utf8EncodedLengthNeon(const base::uc16* chars, int length) {
+  const uint16x8_t three_byte_bits = vdupq_n_u16(0xF800);
+  const uint16x8_t surrogate = vdupq_n_u16(0xD800);
+  const uint16x8_t first_two_byte = vdupq_n_u16(0x80);
+  const uint16x8_t first_three_byte = vdupq_n_u16(0x800);
+  int utf8_length = 0;
+  int index = 0;
+  for (; index + 8 <= length; index += 8) {
+    uint16x8_t v = vld1q_u16(chars + index);
+    if (vmaxvq_u16(vceqq_u16(vandq_u16(v, three_byte_bits), surrogate)) != 0) {
+      // Surrogate pairs may span vectors, count them one by one.
+      utf8_length += ScalarUtf8EncodedLength(chars, index + 8, index);
+      continue;
+    }
+    // Each character takes one byte, one more if it isn't ASCII, and another
+    // one more if it doesn't fit into two bytes.
+    uint16x8_t extra_bytes =
+        vaddq_u16(vshrq_n_u16(vcgeq_u16(v, first_two_byte), 15),
+                  vshrq_n_u16(vcgeq_u16(v, first_three_byte), 15));
+    utf8_length += 8 + vaddvq_u16(extra_bytes);
+  }
+  return utf8_length + ScalarUtf8EncodedLength(chars, length, index);
+}
+#endif  // NEON64
+
+#if defined(_MSC_VER) && defined(__clang__)
+// Generating AVX2 code with Clang on Windows without the /arch:AVX2 flag does
+// not seem possible at the moment.
+#define IS_CLANG_WIN 1
+#endif
+
+// As in src/objects/simd.cc, the AVX2 code is compiled with a target attribute
+// and only called if the CPU supports AVX2.
+#if defined(__SSE3__) && !defined(_M_IX86) && !defined(IS_CLANG_WIN) && \
+    (defined(V8_TARGET_ARCH_IA32) || defined(V8_TARGET_ARCH_X64))
+#define HAS_AVX2_VALIDATION 1
+#endif
+
+#undef IS_CLANG_WIN
+
+#if defined(HAS_AVX2_VALIDATION) || defined(NEON64)
+// The error classes of Keiser and Lemire's UTF-8 validation. Each of them
+// is detected from a byte and the one before it: the first byte selects
+// the set of classes which apply to its high nibble and, separately, to its
+// low nibble, the second byte those which apply to its high nibble, and an
+// error is present iff the intersection of the three sets is not empty.
+constexpr uint8_t kTooShort = 1 << 0;   // 11______ 0_______
+                                        // 11______ 11______
+constexpr uint8_t kTooLong = 1 << 1;    // 0_______ 10______
+constexpr uint8_t kOverlong3 = 1 << 2;  // 11100000 100_____
+constexpr uint8_t kTooLarge = 1 << 3;   // 11110100 1001____
+                                        // 11110100 101_____
+                                        // 11110101 1001____
+                                        // 11110101 101_____
+                                        // 1111011_ 1001____
+                                        // 1111011_ 101_____
+                                        // 11111___ 1001____
+                                        // 11111___ 101_____
+constexpr uint8_t kSurrogate = 1 << 4;  // 11101101 101_____
+constexpr uint8_t kOverlong2 = 1 << 5;  // 1100000_ 10______
+constexpr uint8_t kTooLarge1000 = 1 << 6;  // 11110101 1000____
+                                           // 1111011_ 1000____
+                                           // 11111___ 1000____
+constexpr uint8_t kOverlong4 = 1 << 6;     // 11110000 1000____
+// A continuation byte following a continuation byte. This is only an error
+// if the second one isn't part of a three or four byte sequence, which is
+// checked separately.
+constexpr uint8_t kTwoContinuations = 1 << 7;  // 10______ 10______
+constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoContinuations;
+
+constexpr uint8_t kFirstByteHighNibble[16] = {
+    // 0_______ ________
+    kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+    kTooLong,
+    // 10______ ________
+    kTwoContinuations, kTwoContinuations, kTwoContinuations,
+    kTwoContinuations,
+    // 1100____ ________
+    kTooShort | kOverlong2,
+    // 1101____ ________
+    kTooShort,
+    // 1110____ ________
+    kTooShort | kOverlong3 | kSurrogate,
+    // 1111____ ________
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4};
+
+constexpr uint8_t kFirstByteLowNibble[16] = {
+    // ____0000 ________
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    // ____0001 ________
+    kCarry | kOverlong2,
+    // ____001_ ________
+    kCarry, kCarry,
+    // ____0100 ________
+    kCarry | kTooLarge,
+    // ____0101 ________
+    kCarry | kTooLarge | kTooLarge1000,
+    // ____011_ ________
+    kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+    // ____1___ ________
+    kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    // ____1101 ________
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000};
+
+constexpr uint8_t kSecondByteHighNibble[16] = {
+    // ________ 0_______
+    kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+    kTooShort, kTooShort,
+    // ________ 1000____
+    kTooLong | kOverlong2 | kTwoContinuations | kOverlong3 | kTooLarge1000 |
+        kOverlong4,
+    // ________ 1001____
+    kTooLong | kOverlong2 | kTwoContinuations | kOverlong3 | kTooLarge,
+    // ________ 101_____
+    kTooLong | kOverlong2 | kTwoContinuations | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoContinuations | kSurrogate | kTooLarge,
+    // ________ 11______
+    kTooShort, kTooShort, kTooShort, kTooShort};
+
+// Counts the UTF-16 code units of the valid UTF-8 between {index} and
+// {length}, and finds the largest byte. Used for the last, partial block,
+// which is validated after padding it with zeros; these are ASCII and end
+// any sequence which is cut off.
+void CountUtf8Tail(const uint8_t* data, int index, int length,
+                   int* utf16_length, uint8_t* max_byte) {
+  for (; index < length; ++index) {
+    uint8_t byte = data[index];
+    // Each code point has exactly one byte which is not a continuation byte,
+    // and the ones which need a surrogate pair start with 11110___.
+    if ((byte & 0xC0) != 0x80) ++*utf16_length;
+    if (byte >= 0xF0) ++*utf16_length;
+    *max_byte = std::max(*max_byte, byte);
+  }
+}
+
+// Latin-1 characters are encoded as ASCII or start with 1100001_, and
+// continuation bytes are at most 10111111.
+constexpr uint8_t kFirstNonLatin1LeadByte = 0xC4;
+
+#ifdef HAS_AVX2_VALIDATION
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+TARGET_AVX2 inline __m256i LoadTableAVX2(const uint8_t* table) {
+  return _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+}
+
+// Returns a vector which is non-zero iff {input} contains an error, given
+// the preceding block {prev_input}.
+TARGET_AVX2 inline __m256i CheckUtf8BlockAVX2(__m256i input,
+                                              __m256i prev_input) {
+  // The bytes which precede the ones of {input} by one, two and three
+  // positions. {alignr} shifts each 128-bit lane separately.
+  __m256i prev_halves = _mm256_permute2x128_si256(prev_input, input, 0x21);
+  __m256i prev1 = _mm256_alignr_epi8(input, prev_halves, 15);
+  __m256i prev2 = _mm256_alignr_epi8(input, prev_halves, 14);
+  __m256i prev3 = _mm256_alignr_epi8(input, prev_halves, 13);
+
+  const __m256i low_nibble_mask = _mm256_set1_epi8(0x0F);
+  __m256i first_high = _mm256_shuffle_epi8(
+      LoadTableAVX2(kFirstByteHighNibble),
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble_mask));
+  __m256i first_low =
+      _mm256_shuffle_epi8(LoadTableAVX2(kFirstByteLowNibble),
+                          _mm256_and_si256(prev1, low_nibble_mask));
+  __m256i second_high = _mm256_shuffle_epi8(
+      LoadTableAVX2(kSecondByteHighNibble),
+      _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble_mask));
+  __m256i special_cases =
+      _mm256_and_si256(_mm256_and_si256(first_high, first_low), second_high);
+
+  // The third and fourth byte of a sequence must be continuation bytes,
+  // which is exactly where kTwoContinuations has to be set.
+  __m256i is_third_byte =
+      _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+  __m256i is_fourth_byte =
+      _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+  __m256i must_be_continuation =
+      _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+                       _mm256_set1_epi8(static_cast<char>(0x80)));
+  return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+TARGET_AVX2 bool ValidateUtf8AVX2(const uint8_t* data, int length,
+                                  int* utf16_length, bool* is_one_byte) {
+  constexpr int kBlockSize = 32;
+  const __m256i last_continuation_byte =
+      _mm256_set1_epi8(static_cast<char>(0xBF));
+  const __m256i first_four_byte_lead =
+      _mm256_set1_epi8(static_cast<char>(0xF0));
+  __m256i prev_input = _mm256_setzero_si256();
+  __m256i max_bytes = _mm256_setzero_si256();
+  int count = 0;
+  int index = 0;
+  for (; index + kBlockSize <= length; index += kBlockSize) {
+    __m256i input =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+    __m256i error = CheckUtf8BlockAVX2(input, prev_input);
+    if (!_mm256_testz_si256(error, error)) return false;
+    // Signed comparison: continuation bytes are the smallest.
+    __m256i not_continuation = _mm256_cmpgt_epi8(input, last_continuation_byte);
+    __m256i four_byte_lead = _mm256_cmpeq_epi8(
+        _mm256_max_epu8(input, first_four_byte_lead), input);
+    uint32_t code_points =
+        static_cast<uint32_t>(_mm256_movemask_epi8(not_continuation));
+    uint32_t surrogate_pairs =
+        static_cast<uint32_t>(_mm256_movemask_epi8(four_byte_lead));
+    count += base::bits::CountPopulation(code_points) +
+             base::bits::CountPopulation(surrogate_pairs);
+    max_bytes = _mm256_max_epu8(max_bytes, input);
+    prev_input = input;
+  }
+
+  uint8_t last_block[kBlockSize] = {};
+  std::copy(data + index, data + length, last_block);
+  __m256i input =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last_block));
+  __m256i error = CheckUtf8BlockAVX2(input, prev_input);
+  if (!_mm256_testz_si256(error, error)) return false;
+
+  uint8_t max_byte = 0;
+  CountUtf8Tail(data, index, length, &count, &max_byte);
+  alignas(kBlockSize) uint8_t block_max[kBlockSize];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(block_max), max_bytes);
+  for (uint8_t byte : block_max) max_byte = std::max(max_byte, byte);
+
+  *utf16_length = count;
+  *is_one_byte = max_byte < kFirstNonLatin1LeadByte;
+  return true;
+}
+#undef TARGET_AVX2
+#endif  // HAS_AVX2_VALIDATION
+
+#ifdef NEON64
+// Returns a vector which is non-zero iff {input} contains an error, given
+// the preceding block {prev_input}.
+inline uint8x16_t CheckUtf8BlockNeon(uint8x16_t input, uint8x16_t prev_input) {
+  uint8x16_t prev1 = vextq_u8(prev_input, input, 15);
+  uint8x16_t prev2 = vextq_u8(prev_input, input, 14);
+  uint8x16_t prev3 = vextq_u8(prev_input, input, 13);
+
+  uint8x16_t first_high =
+      vqtbl1q_u8(vld1q_u8(kFirstByteHighNibble), vshrq_n_u8(prev1, 4));
+  uint8x16_t first_low = vqtbl1q_u8(vld1q_u8(kFirstByteLowNibble),
+                                    vandq_u8(prev1, vdupq_n_u8(0x0F)));
+  uint8x16_t second_high =
+      vqtbl1q_u8(vld1q_u8(kSecondByteHighNibble), vshrq_n_u8(input, 4));
+  uint8x16_t special_cases =
+      vandq_u8(vandq_u8(first_high, first_low), second_high);
+
+  // The third and fourth byte of a sequence must be continuation bytes,
+  // which is exactly where kTwoContinuations has to be set.
+  uint8x16_t is_third_byte = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+  uint8x16_t is_fourth_byte = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+  uint8x16_t must_be_continuation =
+      vandq_u8(vorrq_u8(is_third_byte, is_fourth_byte), vdupq_n_u8(0x80));
+  return veorq_u8(must_be_continuation, special_cases);
+}
+
+bool ValidateUtf8Neon(const uint8_t* data, int length, int* utf16_length,
+                      bool* is_one_byte) {
+  constexpr int kBlockSize = 16;
+  const int8x16_t last_continuation_byte =
+      vdupq_n_s8(static_cast<int8_t>(0xBF));
+  const uint8x16_t first_four_byte_lead = vdupq_n_u8(0xF0);
+  uint8x16_t prev_input = vdupq_n_u8(0);
+  uint8x16_t max_bytes = vdupq_n_u8(0);
+  int count = 0;
+  int index = 0;
+  for (; index + kBlockSize <= length; index += kBlockSize) {
+    uint8x16_t input = vld1q_u8(data + index);
+    if (vmaxvq_u8(CheckUtf8BlockNeon(input, prev_input)) != 0) return false;
+    // Signed comparison: continuation bytes are the smallest.
+    uint8x16_t not_continuation =
+        vcgtq_s8(vreinterpretq_s8_u8(input), last_continuation_byte);
+    uint8x16_t four_byte_lead = vcgeq_u8(input, first_four_byte_lead);
+    count += vaddvq_u8(vshrq_n_u8(not_continuation, 7)) +
+             vaddvq_u8(vshrq_n_u8(four_byte_lead, 7));
+    max_bytes = vmaxq_u8(max_bytes, input);
+    prev_input = input;
+  }
+
+  uint8_t last_block[kBlockSize] = {};
+  std::copy(data + index, data + length, last_block);
+  if (vmaxvq_u8(CheckUtf8BlockNeon(vld1q_u8(last_block), prev_input)) != 0) {
+    return false;
+  }
+
+  uint8_t max_byte = vmaxvq_u8(max_bytes);
+  CountUtf8Tail(data, index, length, &count, &max_byte);
+  *utf16_length = count;
+  *is_one_byte = max_byte < kFirstNonLatin1LeadByte;
+  return true;
+}
+#endif  // NEON64
+
+#endif  // defined(HAS_AVX2_VALIDATION) || defined(NEON64)
+
+}  // namespace
+
+int AsciiPrefixLength(base::Vector<const uint8_t> chars) {
+#ifdef __SSE3__
+  return AsciiPrefixLengthSSE(chars.begin(), chars.length());
+#elif defined(NEON64)
+  return AsciiPrefixLengthNeon(chars.begin(), chars.length());
+#else
+  return ScalarAsciiPrefixLength(chars.begin(), chars.length(), 0);
+#endif
+}
+
+int AsciiPrefixLength(base::Vector<const base::uc16> chars) {
+#ifdef __SSE3__
+  return AsciiPrefixLengthSSE(chars.begin(), chars.length());
+#elif defined(NEON64)
+  return AsciiPrefixLengthNeon(chars.begin(), chars.length());
+#else
+  return ScalarAsciiPrefixLength(chars.begin(), chars.length(), 0);
+#endif
+}
+
+int Utf8EncodedLength(base::Vector<const uint8_t> chars) {
+#ifdef __SSE3__
+  return Utf8EncodedLengthSSE(chars.begin(), chars.length());
+#elif defined(NEON64)
+  return Utf8EncodedLengthNeon(chars.begin(), chars.length());
+#else
+  return ScalarUtf8EncodedLength(chars.begin(), chars.length(), 0);
+#endif
+}
+
+int Utf8EncodedLength(base::Vector<const base::uc16> chars) {
+#ifdef __SSE3__
+  return Utf8EncodedLengthSSE(chars.begin(), chars.length());
+#elif defined(NEON64)
+  return Utf8EncodedLengthNeon(chars.begin(), chars.length());
+#else
+  return ScalarUtf8EncodedLength(chars.begin(), chars.length(), 0);
+#endif
+}
+
+bool ValidateUtf8(base::Vector<const uint8_t> data, int* utf16_length,
+                  bool* is_one_byte) {
+#ifdef HAS_AVX2_VALIDATION
+  if (CpuFeatures::IsSupported(AVX2)) {
+    return ValidateUtf8AVX2(data.begin(), data.length(), utf16_length,
+                            is_one_byte);
+  }
+#endif
+#ifdef NEON64
+  return ValidateUtf8Neon(data.begin(), data.length(), utf16_length,
+                          is_one_byte);
+#else
+  return false;
+#endif
+}
+
+#undef HAS_AVX2_VALIDATION
+#undef NEON64
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,44 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_STRINGS_UTF8_SIMD_H_
+#define V8_STRINGS_UTF8_SIMD_H_
+
+#include "src/base/macros.h"
+#include "src/base/strings.h"
+#include "src/base/vector.h"
+
+namespace v8 {
+namespace internal {
+
+// Vectorized building blocks for UTF-8 decoding and encoding, following the
+// algorithms of simdutf. ASCII runs and UTF-8 lengths are computed a vector
+// at a time with SSE2 or Neon. UTF-8 is validated with the lookup tables of
+// Keiser and Lemire ("Validating UTF-8 In Less Than One Instruction Per
+// Byte"), which find all errors from the high nibble of each byte and both
+// nibbles of the preceding byte; this needs byte shuffles and uses AVX2 if
+// the CPU supports it, or Neon. Other platforms use scalar fallbacks.
+
+// Returns the number of ASCII characters at the start of {chars}.
+V8_EXPORT_PRIVATE int AsciiPrefixLength(base::Vector<const uint8_t> chars);
+V8_EXPORT_PRIVATE int AsciiPrefixLength(base::Vector<const base::uc16> chars);
+
+// Returns the number of bytes of the UTF-8 encoding of {chars}. As in
+// unibrow::Utf8::Length, lone surrogates take 3 bytes each.
+V8_EXPORT_PRIVATE int Utf8EncodedLength(base::Vector<const uint8_t> chars);
+V8_EXPORT_PRIVATE int Utf8EncodedLength(
+    base::Vector<const base::uc16> chars);
+
+// Returns true if {data} is valid UTF-8 and could be validated with vector
+// instructions. In that case, {utf16_length} is set to the number of UTF-16
+// code units {data} decodes to, and {is_one_byte} to whether all of them are
+// Latin-1 characters. Encoded surrogates and a sequence which is cut off at
+// the end are invalid.
+V8_EXPORT_PRIVATE bool ValidateUtf8(base::Vector<const uint8_t> data,
+                                    int* utf16_length, bool* is_one_byte);
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_STRINGS_UTF8_SIMD_H_
@@ -4,6 +4,7 @@
 
 #include "src/wasm/baseline/liftoff-assembler.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "src/base/optional.h"
@@ -681,6 +682,44 @@ void LiftoffAssembler::SpillLocals() {
   }
 }
 
+void LiftoffAssembler::PrepareLoopLocals(
+    base::Vector<const uint32_t> register_locals) {
+  // Spill all other locals first, to free their registers.
+  for (uint32_t i = 0; i < num_locals_; ++i) {
+    if (std::find(register_locals.begin(), register_locals.end(), i) ==
+        register_locals.end()) {
+      Spill(&cache_state_.stack_state[i]);
+    }
+  }
+  // Later merges into the loop header state need a distinct register for each
+  // local, so registers shared with other values get copied.
+  LiftoffRegList pinned;
+  for (uint32_t index : register_locals) {
+    VarState& slot = cache_state_.stack_state[index];
+    if (slot.is_reg() && cache_state_.get_use_count(slot.reg()) == 1) {
+      pinned.set(slot.reg());
+      continue;
+    }
+    RegClass rc = reg_class_for(slot.kind());
+    if (!cache_state_.has_unused_register(rc, pinned)) {
+      Spill(&slot);
+      continue;
+    }
+    LiftoffRegister reg = cache_state_.unused_register(rc, pinned);
+    if (slot.is_reg()) {
+      Move(reg, slot.reg(), slot.kind());
+      cache_state_.dec_used(slot.reg());
+    } else if (slot.is_const()) {
+      LoadConstant(reg, slot.constant());
+    } else {
+      Fill(reg, slot.offset(), slot.kind());
+    }
+    slot.MakeRegister(reg);
+    cache_state_.inc_used(reg);
+    pinned.set(reg);
+  }
+}
+
 void LiftoffAssembler::SpillAllRegisters() {
   for (uint32_t i = 0, e = cache_state_.stack_height(); i < e; ++i) {
     auto& slot = cache_state_.stack_state[i];
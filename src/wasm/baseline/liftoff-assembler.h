@@ -625,6 +625,10 @@ class LiftoffAssembler : public MacroAssembler {
 
   void Spill(VarState* slot);
   void SpillLocals();
+  // Spill all locals except {register_locals}, which are instead moved to
+  // distinct registers (as long as registers are available). Used for loop
+  // headers, such that the given locals stay in registers across iterations.
+  void PrepareLoopLocals(base::Vector<const uint32_t> register_locals);
   void SpillAllRegisters();
   inline void LoadSpillAddress(Register dst, int offset, ValueKind kind);
 
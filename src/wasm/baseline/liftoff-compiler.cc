@@ -96,6 +96,12 @@ struct assert_field_size {
 constexpr ValueKind kIntPtrKind = LiftoffAssembler::kIntPtrKind;
 constexpr ValueKind kSmiKind = LiftoffAssembler::kSmiKind;
 
+// Limits for keeping locals in registers across loop iterations (see
+// {LiftoffCompiler::FindHotLoopLocals}).
+constexpr size_t kMaxLoopRegisterLocals = 4;
+constexpr size_t kMaxLoopScanLocals = 16;
+constexpr int kMaxLoopScanLength = 4096;
+
 // Used to construct fixed-size signatures: MakeSig::Returns(...).Params(...);
 using MakeSig = FixedSizeSignature<ValueKind>;
 
@@ -819,8 +825,28 @@ class LiftoffCompiler {
     return false;
   }
 
+  // Records an event of the binary trace of --wasm-trace-file. This is a
+  // plain C call, much cheaper than the builtin calls of the text trace.
+  void EmitTraceEvent(WasmTraceRecordKind kind, WasmCodePosition position,
+                      VarState offset = {kIntPtrKind, 0, 0},
+                      MachineRepresentation rep = MachineRepresentation::kNone,
+                      bool is_store = false) {
+    uint32_t event =
+        EncodeWasmTraceEvent(kind, ExecutionTier::kLiftoff, rep, is_store);
+    GenerateCCall(kVoid,
+                  {{kI32, static_cast<int32_t>(event), 0},
+                   {kI32, static_cast<int32_t>(func_index_), 0},
+                   {kI32, position, 0},
+                   offset},
+                  ExternalReference::wasm_trace_event());
+  }
+
   V8_NOINLINE V8_PRESERVE_MOST void TraceFunctionEntry(FullDecoder* decoder) {
     CODE_COMMENT("trace function entry");
+    if (v8_flags.wasm_trace_file.value() != nullptr) {
+      EmitTraceEvent(WasmTraceRecordKind::kFunctionEntry, decoder->position());
+      return;
+    }
     __ SpillAllRegisters();
     source_position_table_builder_.AddPosition(
         __ pc_offset(), SourcePosition(decoder->position()), false);
@@ -1237,13 +1263,89 @@ class LiftoffCompiler {
 
   void Block(FullDecoder* decoder, Control* block) { PushControl(block); }
 
+  // Scans (a bounded prefix of) the body of the loop starting at {pc}, and
+  // returns the numeric locals which are accessed most often in it, if they
+  // are accessed at least twice.
+  base::SmallVector<uint32_t, kMaxLoopRegisterLocals> FindHotLoopLocals(
+      FullDecoder* decoder, const uint8_t* pc) {
+    DCHECK_EQ(kExprLoop, *pc);
+    struct LocalUses {
+      uint32_t index;
+      uint32_t count;
+    };
+    base::SmallVector<LocalUses, kMaxLoopScanLocals> uses;
+    const uint8_t* end = std::min(decoder->end(), pc + kMaxLoopScanLength);
+    // Nesting depth relative to the loop, such that the scan stops at the end
+    // of the loop. This has to cover all opcodes which open or close a block:
+    // {delegate} closes a {try} without an {end}.
+    int depth = 0;
+    for (pc += decoder->OpcodeLength(decoder, pc); pc < end && depth >= 0;
+         pc += decoder->OpcodeLength(decoder, pc)) {
+      switch (*pc) {
+        case kExprLoop:
+        case kExprIf:
+        case kExprBlock:
+        case kExprTry:
+          depth++;
+          break;
+        case kExprEnd:
+        case kExprDelegate:
+          depth--;
+          break;
+        case kExprLocalGet:
+        case kExprLocalSet:
+        case kExprLocalTee: {
+          IndexImmediate imm(decoder, pc + 1, "local index", ValidationTag{});
+          if (!is_numeric(__ local_kind(imm.index))) break;
+          auto it = std::find_if(
+              uses.begin(), uses.end(),
+              [&](const LocalUses& entry) { return entry.index == imm.index; });
+          if (it != uses.end()) {
+            ++it->count;
+          } else if (uses.size() < kMaxLoopScanLocals) {
+            uses.push_back({imm.index, 1});
+          }
+          break;
+        }
+        default:
+          break;
+      }
+    }
+    std::stable_sort(uses.begin(), uses.end(),
+                     [](const LocalUses& a, const LocalUses& b) {
+                       return a.count > b.count;
+                     });
+    base::SmallVector<uint32_t, kMaxLoopRegisterLocals> result;
+    for (const LocalUses& entry : uses) {
+      if (entry.count < 2 || result.size() == kMaxLoopRegisterLocals) break;
+      result.push_back(entry.index);
+    }
+    return result;
+  }
+
+  bool trace_loops() const {
+    return V8_UNLIKELY(v8_flags.wasm_trace_loops) &&
+           v8_flags.wasm_trace_file.value() != nullptr &&
+           for_debugging_ == kNotForDebugging;
+  }
+
   void Loop(FullDecoder* decoder, Control* loop) {
+    if (trace_loops()) {
+      EmitTraceEvent(WasmTraceRecordKind::kLoopEntry, decoder->position());
+    }
+
     // Before entering a loop, spill all locals to the stack, in order to free
     // the cache registers, and to avoid unnecessarily reloading stack values
-    // into registers at branches.
-    // TODO(clemensb): Come up with a better strategy here, involving
-    // pre-analysis of the function.
-    __ SpillLocals();
+    // into registers at branches. With --liftoff-loop-register-locals, the
+    // locals which are used most in the loop stay in registers instead.
+    if (v8_flags.liftoff_loop_register_locals &&
+        for_debugging_ == kNotForDebugging) {
+      base::SmallVector<uint32_t, kMaxLoopRegisterLocals> register_locals =
+          FindHotLoopLocals(decoder, decoder->pc());
+      __ PrepareLoopLocals(base::VectorOf(register_locals));
+    } else {
+      __ SpillLocals();
+    }
 
     __ PrepareLoopArgs(loop->start_merge.arity);
 
@@ -1253,6 +1355,12 @@ class LiftoffCompiler {
     // Save the current cache state for the merge when jumping to this loop.
     loop->label_state.Split(*__ cache_state());
 
+    // Every branch back to the loop header is one more iteration. The call
+    // spills all registers, which only changes the state after the label.
+    if (trace_loops()) {
+      EmitTraceEvent(WasmTraceRecordKind::kLoopIteration, decoder->position());
+    }
+
     PushControl(loop);
 
     if (!dynamic_tiering()) {
@@ -2435,6 +2543,10 @@ class LiftoffCompiler {
 
   V8_NOINLINE V8_PRESERVE_MOST void TraceFunctionExit(FullDecoder* decoder) {
     CODE_COMMENT("trace function exit");
+    if (v8_flags.wasm_trace_file.value() != nullptr) {
+      EmitTraceEvent(WasmTraceRecordKind::kFunctionExit, decoder->position());
+      return;
+    }
     // Before making the runtime call, spill all cache registers.
     __ SpillAllRegisters();
 
@@ -3158,6 +3270,17 @@ class LiftoffCompiler {
       }
     }
 
+    if (v8_flags.wasm_trace_file.value() != nullptr) {
+      if (kSystemPointerSize == 8 && !memory->is_memory64) {
+        // Zero-extend the effective offset to u64.
+        CHECK(__ emit_type_conversion(kExprI64UConvertI32, effective_offset,
+                                      effective_offset, nullptr));
+      }
+      EmitTraceEvent(WasmTraceRecordKind::kMemoryAccess, position,
+                     {kIntPtrKind, effective_offset, 0}, rep, is_store);
+      return;
+    }
+
     // Get a register to hold the stack slot for MemoryTracingInfo.
     LiftoffRegister info = pinned.set(__ GetUnusedRegister(kGpReg, pinned));
     // Allocate stack slot for MemoryTracingInfo.
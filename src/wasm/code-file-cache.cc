@@ -0,0 +1,217 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/code-file-cache.h"
+
+#include <cstdio>
+#include <string>
+
+#include "src/base/functional.h"
+#include "src/base/platform/platform.h"
+#include "src/flags/flags.h"
+#include "src/handles/handles-inl.h"
+#include "src/snapshot/snapshot-utils.h"
+#include "src/wasm/compilation-environment.h"
+#include "src/wasm/wasm-code-manager.h"
+#include "src/wasm/wasm-module.h"
+#include "src/wasm/wasm-serialization.h"
+
+namespace v8::internal::wasm {
+
+namespace {
+
+constexpr uint32_t kCodeFileCacheMagic = 0x7761636d;  // "wacm"
+
+// The file header consists of the magic number, the flag hash, a checksum of
+// the serialized module, the enabled features, and the size of the wire
+// bytes.
+constexpr size_t kMagicOffset = 0;
+constexpr size_t kFlagHashOffset = kMagicOffset + sizeof(uint32_t);
+constexpr size_t kChecksumOffset = kFlagHashOffset + sizeof(uint32_t);
+constexpr size_t kFeaturesOffset = kChecksumOffset + sizeof(uint32_t);
+constexpr size_t kWireBytesSizeOffset = kFeaturesOffset + sizeof(uint64_t);
+constexpr size_t kFileHeaderSize = kWireBytesSizeOffset + sizeof(uint64_t);
+
+// The serialized module starts at a page-aligned offset, such that its code
+// section is page-aligned in the mapped file as well.
+size_t SerializedDataOffset(size_t wire_bytes_size) {
+  return RoundUp(kFileHeaderSize + wire_bytes_size, kMinimumOSPageSize);
+}
+
+uint64_t FeaturesKey(WasmFeatures features) {
+  return static_cast<uint64_t>(features.ToIntegral());
+}
+
+std::string CacheFileName(base::Vector<const uint8_t> wire_bytes,
+                          WasmFeatures features) {
+  DCHECK_NOT_NULL(v8_flags.wasm_code_cache_dir.value());
+  // Code compiled with different flags or features is not compatible, so it
+  // gets its own file rather than replacing the existing one.
+  size_t key = base::hash_combine(GetWireBytesHash(wire_bytes),
+                                  FlagList::Hash(), FeaturesKey(features));
+  base::EmbeddedVector<char, 64> name;
+  SNPrintF(name, "wasm-code-%016zx-%zu", key, wire_bytes.size());
+  return std::string(v8_flags.wasm_code_cache_dir.value()) + "/" +
+         name.begin();
+}
+
+bool FileExists(const std::string& filename) {
+  FILE* file = base::OS::FOpen(filename.c_str(), "rb");
+  if (!file) return false;
+  base::Fclose(file);
+  return true;
+}
+
+class StoreToCodeFileCacheCallback : public CompilationEventCallback {
+ public:
+  explicit StoreToCodeFileCacheCallback(
+      std::weak_ptr<NativeModule> native_module)
+      : native_module_(std::move(native_module)) {}
+
+  void call(CompilationEvent event) override {
+    if (stored_) return;
+    // Without dynamic tiering, all code is TurboFan code once baseline
+    // compilation finished. With dynamic tiering, there is no point at which
+    // all functions reached the top tier; store the module once the first
+    // chunk of TurboFan code is available, and never rewrite it.
+    bool store = event == CompilationEvent::kFinishedCompilationChunk ||
+                 (event == CompilationEvent::kFinishedBaselineCompilation &&
+                  !v8_flags.wasm_dynamic_tiering);
+    if (!store) return;
+    if (std::shared_ptr<NativeModule> native_module = native_module_.lock()) {
+      stored_ = StoreModuleToCodeFileCache(native_module.get());
+    }
+  }
+
+  ReleaseAfterFinalEvent release_after_final_event() override {
+    return kKeepAfterFinalEvent;
+  }
+
+ private:
+  const std::weak_ptr<NativeModule> native_module_;
+  // Compilation events are delivered under the callbacks mutex of the
+  // compilation state, so no further synchronization is needed.
+  bool stored_ = false;
+};
+
+}  // namespace
+
+MaybeHandle<WasmModuleObject> LoadModuleFromCodeFileCache(
+    Isolate* isolate, WasmFeatures enabled_features,
+    base::Vector<const uint8_t> wire_bytes) {
+  std::string filename = CacheFileName(wire_bytes, enabled_features);
+  std::unique_ptr<base::OS::MemoryMappedFile> file(
+      base::OS::MemoryMappedFile::open(
+          filename.c_str(), base::OS::MemoryMappedFile::FileMode::kReadOnly));
+  if (!file) return {};
+
+  base::Vector<const uint8_t> data{
+      static_cast<const uint8_t*>(file->memory()), file->size()};
+  size_t data_offset = SerializedDataOffset(wire_bytes.size());
+  auto reject = [&](const char* reason) {
+    if (v8_flags.trace_wasm_serialization) {
+      PrintF("Rejected Wasm code cache file '%s': %s\n", filename.c_str(),
+             reason);
+    }
+    return MaybeHandle<WasmModuleObject>{};
+  };
+  if (data.size() <= data_offset) return reject("truncated");
+  Address header = reinterpret_cast<Address>(data.begin());
+  if (ReadUnalignedValue<uint32_t>(header + kMagicOffset) !=
+      kCodeFileCacheMagic) {
+    return reject("bad magic number");
+  }
+  if (ReadUnalignedValue<uint32_t>(header + kFlagHashOffset) !=
+          FlagList::Hash() ||
+      ReadUnalignedValue<uint64_t>(header + kFeaturesOffset) !=
+          FeaturesKey(enabled_features)) {
+    return reject("flag or feature mismatch");
+  }
+  if (ReadUnalignedValue<uint64_t>(header + kWireBytesSizeOffset) !=
+          wire_bytes.size() ||
+      memcmp(data.begin() + kFileHeaderSize, wire_bytes.begin(),
+             wire_bytes.size()) != 0) {
+    return reject("wire bytes mismatch");
+  }
+  // The serialized module is not validated by the deserializer beyond its
+  // header, so reject files that were corrupted after they were written.
+  base::Vector<const uint8_t> serialized_module = data + data_offset;
+  if (ReadUnalignedValue<uint32_t>(header + kChecksumOffset) !=
+      Checksum(serialized_module)) {
+    return reject("checksum mismatch");
+  }
+
+  // The serialized module is read directly from the read-only file mapping.
+  // {DeserializeNativeModule} copies the code into the code space of the new
+  // {NativeModule}, where it gets relocated, so the file can be unmapped
+  // afterwards.
+  MaybeHandle<WasmModuleObject> result =
+      DeserializeNativeModule(isolate, serialized_module, wire_bytes, {});
+  if (result.is_null()) return reject("deserialization failed");
+  if (v8_flags.trace_wasm_serialization) {
+    PrintF("Loaded Wasm module from code cache file '%s'\n", filename.c_str());
+  }
+  return result;
+}
+
+bool StoreModuleToCodeFileCache(NativeModule* native_module) {
+  base::Vector<const uint8_t> wire_bytes = native_module->wire_bytes();
+  WasmFeatures enabled_features = native_module->enabled_features();
+  std::string filename = CacheFileName(wire_bytes, enabled_features);
+  // Another process (or another module with the same wire bytes) already
+  // stored the module.
+  if (FileExists(filename)) return true;
+
+  WasmSerializer serializer(native_module);
+  size_t data_offset = SerializedDataOffset(wire_bytes.size());
+  base::OwnedVector<uint8_t> buffer = base::OwnedVector<uint8_t>::New(
+      data_offset + serializer.GetSerializedNativeModuleSize());
+
+  // Serialization fails if no TurboFan code is available yet.
+  base::Vector<uint8_t> serialized_module = buffer.as_vector() + data_offset;
+  if (!serializer.SerializeNativeModule(serialized_module)) return false;
+  Address header = reinterpret_cast<Address>(buffer.begin());
+  WriteUnalignedValue<uint32_t>(header + kMagicOffset, kCodeFileCacheMagic);
+  WriteUnalignedValue<uint32_t>(header + kFlagHashOffset, FlagList::Hash());
+  WriteUnalignedValue<uint32_t>(header + kChecksumOffset,
+                                Checksum(serialized_module));
+  WriteUnalignedValue<uint64_t>(header + kFeaturesOffset,
+                                FeaturesKey(enabled_features));
+  WriteUnalignedValue<uint64_t>(header + kWireBytesSizeOffset,
+                                wire_bytes.size());
+  memcpy(buffer.begin() + kFileHeaderSize, wire_bytes.begin(),
+         wire_bytes.size());
+
+  // Write to a process-specific temporary file first, and atomically move it
+  // into place afterwards.
+  std::string tmp_filename =
+      filename + ".tmp" + std::to_string(base::OS::GetCurrentProcessId());
+  FILE* file = base::OS::FOpen(tmp_filename.c_str(), "wb");
+  if (!file) return false;
+  size_t written = fwrite(buffer.begin(), 1, buffer.size(), file);
+  base::Fclose(file);
+  if (written != buffer.size() ||
+      std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+    base::OS::Remove(tmp_filename.c_str());
+    return false;
+  }
+  if (v8_flags.trace_wasm_serialization) {
+    PrintF("Stored Wasm module to code cache file '%s' (%zu bytes)\n",
+           filename.c_str(), buffer.size());
+  }
+  return true;
+}
+
+void StoreModuleToCodeFileCacheOnTierUp(
+    const std::shared_ptr<NativeModule>& native_module) {
+  native_module->compilation_state()->AddCallback(
+      std::make_unique<StoreToCodeFileCacheCallback>(native_module));
+}
+
+std::string GetCodeFileCacheFileNameForTesting(
+    base::Vector<const uint8_t> wire_bytes, WasmFeatures enabled_features) {
+  return CacheFileName(wire_bytes, enabled_features);
+}
+
+}  // namespace v8::internal::wasm
@@ -0,0 +1,68 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !V8_ENABLE_WEBASSEMBLY
+#error This header should only be included if WebAssembly is enabled.
+#endif  // !V8_ENABLE_WEBASSEMBLY
+
+#ifndef V8_WASM_CODE_FILE_CACHE_H_
+#define V8_WASM_CODE_FILE_CACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "src/base/vector.h"
+#include "src/handles/maybe-handles.h"
+#include "src/wasm/wasm-features.h"
+
+namespace v8::internal {
+
+class Isolate;
+class WasmModuleObject;
+
+namespace wasm {
+
+class NativeModule;
+
+// A cache of serialized Wasm modules in the directory given by
+// --wasm-code-cache-dir. A process which compiled a module writes it to the
+// cache once, when TurboFan code is available; other processes (e.g. the
+// workers of a pre-fork server) then deserialize the module instead of
+// compiling it. Synchronous, asynchronous and streaming compilation all
+// consult the cache.
+//
+// Cache files are named `wasm-code-<key>-<size>`, where the key combines the
+// hash of the wire bytes with the flag hash and the enabled features. A file
+// contains the flag hash, the enabled features, a checksum of the serialized
+// module and a copy of the wire bytes (to rule out hash collisions), followed
+// by the serialized module at a page-aligned offset. Files are written to a
+// temporary name first and then renamed, so readers never see partially
+// written files.
+//
+// Cache files are mapped read-only and shared between processes, but the code
+// itself is not: it is copied into the private code space of each
+// {NativeModule} and relocated there.
+
+// Returns the module object for {wire_bytes} if the cache contains a matching
+// and intact entry for the given features and the current flags.
+V8_EXPORT_PRIVATE MaybeHandle<WasmModuleObject> LoadModuleFromCodeFileCache(
+    Isolate* isolate, WasmFeatures enabled_features,
+    base::Vector<const uint8_t> wire_bytes);
+
+// Writes {native_module} to the cache, unless it is stored already. Returns
+// false if the module could not be stored, e.g. because it has no TurboFan
+// code yet.
+V8_EXPORT_PRIVATE bool StoreModuleToCodeFileCache(NativeModule* native_module);
+
+// Writes {native_module} to the cache once TurboFan code was generated for it.
+void StoreModuleToCodeFileCacheOnTierUp(
+    const std::shared_ptr<NativeModule>& native_module);
+
+V8_EXPORT_PRIVATE std::string GetCodeFileCacheFileNameForTesting(
+    base::Vector<const uint8_t> wire_bytes, WasmFeatures enabled_features);
+
+}  // namespace wasm
+}  // namespace v8::internal
+
+#endif  // V8_WASM_CODE_FILE_CACHE_H_
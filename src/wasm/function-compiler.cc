@@ -16,6 +16,8 @@
 #include "src/wasm/turboshaft-graph-interface.h"
 #include "src/wasm/wasm-code-manager.h"
 #include "src/wasm/wasm-debug.h"
+#include "src/wasm/wasm-engine.h"
+#include "src/wasm/wasm-import-wrapper-cache.h"
 
 namespace v8::internal::wasm {
 
@@ -24,7 +26,7 @@ WasmCompilationResult WasmCompilationUnit::ExecuteCompilation(
     Counters* counters, WasmFeatures* detected) {
   WasmCompilationResult result;
   if (func_index_ < static_cast<int>(env->module->num_imported_functions)) {
-    result = ExecuteImportWrapperCompilation(env);
+    result = ExecuteImportWrapperCompilation(env, counters);
   } else {
     result =
         ExecuteFunctionCompilation(env, wire_bytes_storage, counters, detected);
@@ -43,15 +45,37 @@ WasmCompilationResult WasmCompilationUnit::ExecuteCompilation(
 }
 
 WasmCompilationResult WasmCompilationUnit::ExecuteImportWrapperCompilation(
-    CompilationEnv* env) {
-  const FunctionSig* sig = env->module->functions[func_index_].sig;
+    CompilationEnv* env, Counters* counters) {
+  const WasmFunction& function = env->module->functions[func_index_];
+  const FunctionSig* sig = function.sig;
   // Assume the wrapper is going to be a JS function with matching arity at
   // instantiation time.
   auto kind = kDefaultImportCallKind;
   bool source_positions = is_asmjs_module(env->module);
+  int expected_arity = static_cast<int>(sig->parameter_count());
+
+  // Another module might have compiled the same wrapper already.
+  SharedImportWrapperCache* shared_cache =
+      GetWasmEngine()->shared_import_wrapper_cache();
+  SharedImportWrapperCache::Key shared_key{
+      {kind, env->module->isorecursive_canonical_type_ids[function.sig_index],
+       expected_arity, wasm::kNoSuspend},
+      env->enabled_features,
+      source_positions};
+  if (v8_flags.wasm_shared_import_wrappers) {
+    std::shared_ptr<const WasmCompilationResult> shared_result =
+        shared_cache->MaybeGet(shared_key);
+    if (shared_result) {
+      if (counters) counters->wasm_reused_import_wrapper()->Increment();
+      return SharedImportWrapperCache::Copy(*shared_result);
+    }
+  }
+
   WasmCompilationResult result = compiler::CompileWasmImportCallWrapper(
-      env, kind, sig, source_positions,
-      static_cast<int>(sig->parameter_count()), wasm::kNoSuspend);
+      env, kind, sig, source_positions, expected_arity, wasm::kNoSuspend);
+  if (v8_flags.wasm_shared_import_wrappers) {
+    shared_cache->Insert(shared_key, result);
+  }
   return result;
 }
 
@@ -112,7 +112,8 @@ class V8_EXPORT_PRIVATE WasmCompilationUnit final {
                                                    Counters*,
                                                    WasmFeatures* detected);
 
-  WasmCompilationResult ExecuteImportWrapperCompilation(CompilationEnv*);
+  WasmCompilationResult ExecuteImportWrapperCompilation(CompilationEnv*,
+                                                        Counters*);
 
   int func_index_;
   ExecutionTier tier_;
@@ -260,9 +260,15 @@ class WasmGraphBuildingInterface {
     }
     LoadInstanceCacheIntoSsa(ssa_env);
 
+    builder_->set_func_index(func_index_);
     if (v8_flags.trace_wasm && inlined_status_ == kRegularFunction) {
       builder_->TraceFunctionEntry(decoder->position());
     }
+    if (v8_flags.wasm_code_flushing && inlined_status_ == kRegularFunction &&
+        decoder->module_ != nullptr) {
+      builder_->MarkExecutedForCodeFlushing(
+          declared_function_index(decoder->module_, func_index_));
+    }
   }
 
   // Load the instance cache entries into the Ssa Environment.
@@ -5,15 +5,150 @@
 #include "src/wasm/memory-tracing.h"
 
 #include <cinttypes>
+#include <memory>
+#include <vector>
 
+#include "src/base/lazy-instance.h"
 #include "src/base/memory.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
 #include "src/base/strings.h"
 #include "src/base/vector.h"
+#include "src/flags/flags.h"
 
 namespace v8 {
 namespace internal {
 namespace wasm {
 
+namespace {
+
+class TraceBuffer;
+
+// The trace file and the buffers of all threads which recorded anything.
+struct TraceFile {
+  base::Mutex mutex;
+  FILE* file = nullptr;
+  bool closed = false;
+  std::vector<std::unique_ptr<TraceBuffer>> buffers;
+};
+
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(TraceFile, GetTraceFile)
+
+class TraceBuffer {
+ public:
+  static constexpr uint32_t kCapacity = 4096;
+
+  void Add(const WasmTraceRecord& record) {
+    // Only contended while another thread flushes all buffers.
+    base::MutexGuard guard(&mutex_);
+    records_[count_++] = record;
+    if (count_ == kCapacity) {
+      TraceFile* trace_file = GetTraceFile();
+      base::MutexGuard file_guard(&trace_file->mutex);
+      FlushLocked(trace_file);
+    }
+  }
+
+  // Returns whether the next memory access should be recorded. Only called
+  // by the thread which owns the buffer.
+  bool SampleMemoryAccess() {
+    if (++memory_accesses_ < v8_flags.wasm_trace_memory_sample_rate) {
+      return false;
+    }
+    memory_accesses_ = 0;
+    return true;
+  }
+
+  void Flush(TraceFile* trace_file) {
+    base::MutexGuard guard(&mutex_);
+    base::MutexGuard file_guard(&trace_file->mutex);
+    FlushLocked(trace_file);
+  }
+
+ private:
+  // Requires both {mutex_} and the mutex of {trace_file}.
+  void FlushLocked(TraceFile* trace_file) {
+    if (count_ == 0) return;
+    // Records of threads which still run after the file was closed are
+    // dropped.
+    if (trace_file->closed) {
+      count_ = 0;
+      return;
+    }
+    if (trace_file->file == nullptr) {
+      trace_file->file =
+          base::OS::FOpen(v8_flags.wasm_trace_file.value(), "wb");
+      if (trace_file->file == nullptr) {
+        FATAL("Cannot open Wasm trace file '%s'",
+              v8_flags.wasm_trace_file.value());
+      }
+    }
+    WasmTraceChunkHeader header{kWasmTraceMagic, kWasmTraceVersion,
+                                thread_id_, count_, 0};
+    fwrite(&header, sizeof(header), 1, trace_file->file);
+    fwrite(records_, sizeof(WasmTraceRecord), count_, trace_file->file);
+    count_ = 0;
+  }
+
+  const uint64_t thread_id_ =
+      static_cast<uint64_t>(base::OS::GetCurrentThreadId());
+  base::Mutex mutex_;
+  uint32_t count_ = 0;
+  uint32_t memory_accesses_ = 0;
+  WasmTraceRecord records_[kCapacity];
+};
+
+thread_local TraceBuffer* current_trace_buffer = nullptr;
+
+TraceBuffer* GetTraceBuffer() {
+  DCHECK_NOT_NULL(v8_flags.wasm_trace_file.value());
+  if (V8_LIKELY(current_trace_buffer != nullptr)) return current_trace_buffer;
+  TraceFile* trace_file = GetTraceFile();
+  base::MutexGuard guard(&trace_file->mutex);
+  trace_file->buffers.push_back(std::make_unique<TraceBuffer>());
+  current_trace_buffer = trace_file->buffers.back().get();
+  return current_trace_buffer;
+}
+
+}  // namespace
+
+void RecordTraceEvent(uint32_t event, int32_t func_index, int32_t position,
+                      uintptr_t offset) {
+  TraceBuffer* buffer = GetTraceBuffer();
+  WasmTraceRecordKind kind = static_cast<WasmTraceRecordKind>(event & 0xff);
+  bool is_memory_access = kind == WasmTraceRecordKind::kMemoryAccess;
+  if (is_memory_access && !buffer->SampleMemoryAccess()) return;
+  buffer->Add({kind, static_cast<uint8_t>(event >> 8),
+               static_cast<uint8_t>(event >> 16),
+               static_cast<uint8_t>(event >> 24), func_index, position, 0,
+               is_memory_access ? offset : 0});
+}
+
+bool FlushWasmTraceBuffers() {
+  if (v8_flags.wasm_trace_file.value() == nullptr) return false;
+  TraceFile* trace_file = GetTraceFile();
+  std::vector<TraceBuffer*> buffers;
+  {
+    base::MutexGuard guard(&trace_file->mutex);
+    for (auto& buffer : trace_file->buffers) buffers.push_back(buffer.get());
+  }
+  // Buffers are never freed, so they can be flushed one by one. The buffer
+  // is locked before the file, like in {TraceBuffer::Add}.
+  for (TraceBuffer* buffer : buffers) buffer->Flush(trace_file);
+  base::MutexGuard guard(&trace_file->mutex);
+  if (trace_file->file != nullptr) fflush(trace_file->file);
+  return true;
+}
+
+void CloseWasmTraceFile() {
+  if (!FlushWasmTraceBuffers()) return;
+  TraceFile* trace_file = GetTraceFile();
+  base::MutexGuard guard(&trace_file->mutex);
+  if (trace_file->file != nullptr) base::Fclose(trace_file->file);
+  trace_file->file = nullptr;
+  trace_file->closed = true;
+}
+
 void TraceMemoryOperation(base::Optional<ExecutionTier> tier,
                           const MemoryTracingInfo* info, int func_index,
                           int position, uint8_t* mem_start) {
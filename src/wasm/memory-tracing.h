@@ -42,6 +42,72 @@ V8_EXPORT_PRIVATE void TraceMemoryOperation(base::Optional<ExecutionTier>,
                                             int func_index, int position,
                                             uint8_t* mem_start);
 
+// Binary execution trace, written instead of the text output of
+// --trace-wasm-memory and --trace-wasm if --wasm-trace-file is given.
+// Generated code records events with a plain C call to {RecordTraceEvent}
+// rather than a runtime call. Records are buffered per thread, and each full
+// buffer is appended to the file as one chunk: a {WasmTraceChunkHeader}
+// followed by {record_count} {WasmTraceRecord}s in host byte order.
+// tools/wasm/memory-trace-analyzer.py reads this format.
+constexpr uint32_t kWasmTraceMagic = 0x74727377;  // "wstr"
+constexpr uint32_t kWasmTraceVersion = 2;
+
+struct WasmTraceChunkHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t thread_id;
+  uint32_t record_count;
+  uint32_t reserved;
+};
+static_assert(sizeof(WasmTraceChunkHeader) == 24);
+
+enum class WasmTraceRecordKind : uint8_t {
+  kFunctionEntry,
+  kFunctionExit,
+  kMemoryAccess,
+  // Loops are only traced in Liftoff code, see --wasm-trace-loops. The
+  // position is the one of the loop instruction.
+  kLoopEntry,
+  kLoopIteration
+};
+
+struct WasmTraceRecord {
+  WasmTraceRecordKind kind;
+  uint8_t tier;      // {ExecutionTier} of the executing code.
+  uint8_t mem_rep;   // {MachineRepresentation}, for memory accesses.
+  uint8_t is_store;  // 0 or 1, for memory accesses.
+  int32_t func_index;
+  int32_t position;  // Wire byte offset, except for function events.
+  uint32_t reserved;
+  uint64_t offset;  // Offset into the memory, for memory accesses.
+};
+static_assert(sizeof(WasmTraceRecord) == 24);
+
+// Packs the fields of a {WasmTraceRecord} which are known at compile time,
+// such that generated code can pass them as a single constant.
+constexpr uint32_t EncodeWasmTraceEvent(
+    WasmTraceRecordKind kind, ExecutionTier tier,
+    MachineRepresentation mem_rep = MachineRepresentation::kNone,
+    bool is_store = false) {
+  return static_cast<uint32_t>(kind) | static_cast<uint32_t>(tier) << 8 |
+         static_cast<uint32_t>(mem_rep) << 16 |
+         static_cast<uint32_t>(is_store) << 24;
+}
+
+// Adds a record to the current thread's buffer. {event} is the result of
+// {EncodeWasmTraceEvent}. Of the memory accesses, only every
+// --wasm-trace-memory-sample-rate-th is recorded.
+V8_EXPORT_PRIVATE void RecordTraceEvent(uint32_t event, int32_t func_index,
+                                        int32_t position, uintptr_t offset);
+
+// Writes the records of all threads to the trace file and flushes it.
+// Returns false if --wasm-trace-file is not given.
+V8_EXPORT_PRIVATE bool FlushWasmTraceBuffers();
+
+// Flushes and closes the trace file. Must only be called when no thread
+// executes Wasm code anymore.
+void CloseWasmTraceFile();
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
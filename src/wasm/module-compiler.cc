@@ -12,6 +12,7 @@
 #include "src/api/api-inl.h"
 #include "src/base/enum-set.h"
 #include "src/base/optional.h"
+#include "src/base/platform/elapsed-timer.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/semaphore.h"
 #include "src/base/platform/time.h"
@@ -22,6 +23,7 @@
 #include "src/logging/counters-scopes.h"
 #include "src/logging/metrics.h"
 #include "src/tracing/trace-event.h"
+#include "src/wasm/code-file-cache.h"
 #include "src/wasm/code-space-access.h"
 #include "src/wasm/module-decoder.h"
 #include "src/wasm/pgo.h"
@@ -2224,6 +2226,8 @@ struct ValidateFunctionsStreamingJobData {
   std::atomic<Unit*> next_available_unit;
   std::atomic<Unit*> end_of_available_units;
   std::atomic<bool> found_error{false};
+  // Accumulated time spent in validation by all background threads.
+  std::atomic<int64_t> validation_time_us{0};
 };
 
 class ValidateFunctionsStreamingJob final : public JobTask {
@@ -2236,6 +2240,8 @@ class ValidateFunctionsStreamingJob final : public JobTask {
   void Run(JobDelegate* delegate) override {
     TRACE_EVENT0("v8.wasm", "wasm.ValidateFunctionsStreaming");
     using Unit = ValidateFunctionsStreamingJobData::Unit;
+    base::ElapsedTimer timer;
+    timer.Start();
     while (Unit unit = data_->GetUnit()) {
       DecodeResult result = ValidateSingleFunction(
           module_, unit.func_index, unit.code, enabled_features_);
@@ -2247,6 +2253,8 @@ class ValidateFunctionsStreamingJob final : public JobTask {
       // After validating one function, check if we should yield.
       if (delegate->ShouldYield()) break;
     }
+    data_->validation_time_us.fetch_add(timer.Elapsed().InMicroseconds(),
+                                        std::memory_order_relaxed);
   }
 
   size_t GetMaxConcurrency(size_t worker_count) const override {
@@ -2290,6 +2298,7 @@ class AsyncStreamingProcessor final : public StreamingProcessor {
 
  private:
   void CommitCompilationUnits();
+  void RecordStageTimes();
 
   ModuleDecoder decoder_;
   AsyncCompileJob* job_;
@@ -2300,6 +2309,13 @@ class AsyncStreamingProcessor final : public StreamingProcessor {
   ValidateFunctionsStreamingJobData validate_functions_job_data_;
   std::unique_ptr<JobHandle> validate_functions_job_handle_;
 
+  // Time spent decoding on the streaming thread, and waiting for background
+  // validation after the end of the stream. Together with the background
+  // validation time, this shows whether streaming compilation is limited by
+  // the download or by the CPU.
+  base::TimeDelta decode_time_;
+  base::TimeDelta validate_wait_time_;
+
   // Running hash of the wire bytes up to code section size, but excluding the
   // code section itself. Used by the {NativeModuleCache} to detect potential
   // duplicate modules.
@@ -2401,6 +2417,12 @@ void AsyncCompileJob::FinishCompile(bool is_after_cache_hit) {
   if (!is_after_deserialization) {
     PrepareRuntimeObjects();
   }
+  // Modules taken from the native module cache were already registered for
+  // the code file cache by the compilation which created them.
+  if (V8_UNLIKELY(v8_flags.wasm_code_cache_dir) && !is_after_deserialization &&
+      !is_after_cache_hit) {
+    StoreModuleToCodeFileCacheOnTierUp(native_module_);
+  }
 
   // Measure duration of baseline compilation or deserialization from cache.
   if (base::TimeTicks::IsHighResolution()) {
@@ -2856,6 +2878,7 @@ AsyncStreamingProcessor::AsyncStreamingProcessor(AsyncCompileJob* job)
 bool AsyncStreamingProcessor::ProcessModuleHeader(
     base::Vector<const uint8_t> bytes) {
   TRACE_STREAMING("Process module header...\n");
+  base::ScopedTimer decode_timer(&decode_time_);
   decoder_.DecodeModuleHeader(bytes);
   if (!decoder_.ok()) return false;
   prefix_hash_ = GetWireBytesHash(bytes);
@@ -2867,6 +2890,7 @@ bool AsyncStreamingProcessor::ProcessSection(SectionCode section_code,
                                              base::Vector<const uint8_t> bytes,
                                              uint32_t offset) {
   TRACE_STREAMING("Process section %d ...\n", section_code);
+  base::ScopedTimer decode_timer(&decode_time_);
   if (compilation_unit_builder_) {
     // We reached a section after the code section, we do not need the
     // compilation_unit_builder_ anymore.
@@ -2902,6 +2926,7 @@ bool AsyncStreamingProcessor::ProcessCodeSectionHeader(
   before_code_section_ = false;
   TRACE_STREAMING("Start the code section with %d functions...\n",
                   num_functions);
+  base::ScopedTimer decode_timer(&decode_time_);
   prefix_hash_ = base::hash_combine(prefix_hash_,
                                     static_cast<uint32_t>(code_section_length));
   if (!decoder_.CheckFunctionsCount(static_cast<uint32_t>(num_functions),
@@ -2949,6 +2974,7 @@ bool AsyncStreamingProcessor::ProcessCodeSectionHeader(
 bool AsyncStreamingProcessor::ProcessFunctionBody(
     base::Vector<const uint8_t> bytes, uint32_t offset) {
   TRACE_STREAMING("Process function body %d ...\n", num_functions_);
+  base::ScopedTimer decode_timer(&decode_time_);
   uint32_t func_index =
       decoder_.module()->num_imported_functions + num_functions_;
   ++num_functions_;
@@ -2998,6 +3024,25 @@ void AsyncStreamingProcessor::CommitCompilationUnits() {
   compilation_unit_builder_->Commit();
 }
 
+void AsyncStreamingProcessor::RecordStageTimes() {
+  base::TimeDelta validate_time = base::TimeDelta::FromMicroseconds(
+      validate_functions_job_data_.validation_time_us.load(
+          std::memory_order_relaxed));
+  Counters* counters = job_->isolate_->counters();
+  counters->wasm_streaming_decode_time()->AddTimedSample(decode_time_);
+  if (!validate_functions_job_data_.units.empty()) {
+    counters->wasm_streaming_validate_time()->AddTimedSample(validate_time);
+    counters->wasm_streaming_validate_wait_time()->AddTimedSample(
+        validate_wait_time_);
+  }
+  TRACE_STREAMING(
+      "Streaming stage times: decode %.3f ms, validate %.3f ms (background), "
+      "wait for validation %.3f ms, total %.3f ms\n",
+      decode_time_.InMillisecondsF(), validate_time.InMillisecondsF(),
+      validate_wait_time_.InMillisecondsF(),
+      (base::TimeTicks::Now() - job_->start_time_).InMillisecondsF());
+}
+
 void AsyncStreamingProcessor::OnFinishedChunk() {
   TRACE_STREAMING("FinishChunk...\n");
   if (compilation_unit_builder_) CommitCompilationUnits();
@@ -3015,10 +3060,14 @@ void AsyncStreamingProcessor::OnFinishedStream(
     // error was found.
     // TODO(13447): Do not block here; register validation as another finisher
     // instead.
-    validate_functions_job_handle_->Join();
+    {
+      base::ScopedTimer wait_timer(&validate_wait_time_);
+      validate_functions_job_handle_->Join();
+    }
     validate_functions_job_handle_.reset();
     if (validate_functions_job_data_.found_error) after_error = true;
   }
+  RecordStageTimes();
 
   job_->wire_bytes_ = ModuleWireBytes(bytes.as_vector());
   job_->bytes_copy_ = std::move(bytes);
@@ -3075,6 +3124,29 @@ void AsyncStreamingProcessor::OnFinishedStream(
   HandleScope scope(job_->isolate_);
   SaveAndSwitchContext saved_context(job_->isolate_, *job_->native_context_);
 
+  if (V8_UNLIKELY(v8_flags.wasm_code_cache_dir)) {
+    MaybeHandle<WasmModuleObject> cached_module = LoadModuleFromCodeFileCache(
+        job_->isolate_, job_->enabled_features_,
+        job_->wire_bytes_.module_bytes());
+    if (!cached_module.is_null()) {
+      if (job_->native_module_) {
+        // Stop the compilation started for the code section, and clean up the
+        // temporary native module cache entry.
+        job_->native_module_->compilation_state()->CancelInitialCompilation();
+        if (job_->native_module_->wire_bytes().empty()) {
+          GetWasmEngine()->StreamingCompilationFailed(prefix_hash_);
+        }
+      }
+      job_->module_object_ = job_->isolate_->global_handles()->Create(
+          *cached_module.ToHandleChecked());
+      job_->native_module_ = job_->module_object_->shared_native_module();
+      job_->wire_bytes_ = ModuleWireBytes(job_->native_module_->wire_bytes());
+      // Calling {FinishCompile} deletes the {AsyncCompileJob} and {this}.
+      job_->FinishCompile(false);
+      return;
+    }
+  }
+
   // Record the size of the wire bytes and the number of functions. In
   // synchronous and asynchronous (non-streaming) compilation, this happens in
   // {DecodeWasmModule}.
@@ -4066,8 +4138,29 @@ WasmCode* CompileImportWrapper(
   // Keep the {WasmCode} alive until we explicitly call {IncRef}.
   WasmCodeRefScope code_ref_scope;
   CompilationEnv env = native_module->CreateCompilationEnv();
-  WasmCompilationResult result = compiler::CompileWasmImportCallWrapper(
-      &env, kind, sig, source_positions, expected_arity, suspend);
+
+  // Wrappers compiled for another module can be copied into this module's
+  // code space; the runtime stub calls are relocated in {AddCode}.
+  SharedImportWrapperCache* shared_cache =
+      GetWasmEngine()->shared_import_wrapper_cache();
+  SharedImportWrapperCache::Key shared_key{key, env.enabled_features,
+                                           source_positions};
+  std::shared_ptr<const WasmCompilationResult> shared_result;
+  WasmCompilationResult compiled_result;
+  if (v8_flags.wasm_shared_import_wrappers) {
+    shared_result = shared_cache->MaybeGet(shared_key);
+  }
+  if (shared_result) {
+    counters->wasm_reused_import_wrapper()->Increment();
+  } else {
+    compiled_result = compiler::CompileWasmImportCallWrapper(
+        &env, kind, sig, source_positions, expected_arity, suspend);
+    if (v8_flags.wasm_shared_import_wrappers) {
+      shared_cache->Insert(shared_key, compiled_result);
+    }
+  }
+  const WasmCompilationResult& result =
+      shared_result ? *shared_result : compiled_result;
 
   std::unique_ptr<WasmCode> wasm_code = native_module->AddCode(
       result.func_index, result.code_desc, result.frame_slot_count,
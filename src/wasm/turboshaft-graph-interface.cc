@@ -267,10 +267,28 @@ class TurboshaftGraphBuildingInterface {
       StackCheck(StackCheckOp::CheckKind::kFunctionHeaderCheck);
     }
 
+    if (v8_flags.wasm_code_flushing && mode_ == kRegular) {
+      // Mark the function as executed for code aging; see
+      // {NativeModule::AgeTurbofanCode}.
+      V<WordPtr> budget_array = LOAD_IMMUTABLE_INSTANCE_FIELD(
+          instance_node_, TieringBudgetArray,
+          MemoryRepresentation::PointerSized());
+      __ Store(budget_array, __ Word32Constant(1),
+               StoreOp::Kind::RawAligned(), MemoryRepresentation::Uint32(),
+               compiler::kNoWriteBarrier,
+               declared_function_index(decoder->module_, func_index_) *
+                   kInt32Size);
+    }
+
     if (v8_flags.trace_wasm) {
       __ SetCurrentOrigin(
           WasmPositionToOpIndex(decoder->position(), inlining_id_));
-      CallRuntime(Runtime::kWasmTraceEnter, {});
+      if (v8_flags.wasm_trace_file.value() != nullptr) {
+        TraceEvent(WasmTraceRecordKind::kFunctionEntry, decoder->position(),
+                   __ UintPtrConstant(0));
+      } else {
+        CallRuntime(Runtime::kWasmTraceEnter, {});
+      }
     }
 
     auto branch_hints_it = decoder->module_->branch_hints.find(func_index_);
@@ -541,7 +559,10 @@ class TurboshaftGraphBuildingInterface {
     for (size_t i = 0; i < return_count; i++) {
       return_values[i] = stack_base[i].op;
     }
-    if (v8_flags.trace_wasm) {
+    if (v8_flags.trace_wasm && v8_flags.wasm_trace_file.value() != nullptr) {
+      TraceEvent(WasmTraceRecordKind::kFunctionExit, decoder->position(),
+                 __ UintPtrConstant(0));
+    } else if (v8_flags.trace_wasm) {
       V<WordPtr> info = __ IntPtrConstant(0);
       if (return_count == 1) {
         wasm::ValueType return_type = decoder->sig_->GetReturn(0);
@@ -733,7 +754,8 @@ class TurboshaftGraphBuildingInterface {
     if (v8_flags.trace_wasm_memory) {
       // TODO(14259): Implement memory tracing for multiple memories.
       CHECK_EQ(0, imm.memory->index);
-      TraceMemoryOperation(false, repr, final_index, imm.offset);
+      TraceMemoryOperation(false, repr, final_index, imm.offset,
+                           decoder->position());
     }
 
     result->op = extended_load;
@@ -807,7 +829,8 @@ class TurboshaftGraphBuildingInterface {
         load_kind, transform_kind, 0);
 
     if (v8_flags.trace_wasm_memory) {
-      TraceMemoryOperation(false, repr, final_index, imm.offset);
+      TraceMemoryOperation(false, repr, final_index, imm.offset,
+                           decoder->position());
     }
 
     result->op = load;
@@ -857,7 +880,8 @@ class TurboshaftGraphBuildingInterface {
         0);
 
     if (v8_flags.trace_wasm_memory) {
-      TraceMemoryOperation(false, repr, final_index, imm.offset);
+      TraceMemoryOperation(false, repr, final_index, imm.offset,
+                           decoder->position());
     }
 
     result->op = load;
@@ -895,7 +919,8 @@ class TurboshaftGraphBuildingInterface {
     if (v8_flags.trace_wasm_memory) {
       // TODO(14259): Implement memory tracing for multiple memories.
       CHECK_EQ(0, imm.memory->index);
-      TraceMemoryOperation(true, repr, final_index, imm.offset);
+      TraceMemoryOperation(true, repr, final_index, imm.offset,
+                           decoder->position());
     }
   }
 
@@ -947,7 +972,8 @@ class TurboshaftGraphBuildingInterface {
                          laneidx, 0);
 
     if (v8_flags.trace_wasm_memory) {
-      TraceMemoryOperation(true, repr, final_index, imm.offset);
+      TraceMemoryOperation(true, repr, final_index, imm.offset,
+                           decoder->position());
     }
   }
 
@@ -4679,11 +4705,32 @@ class TurboshaftGraphBuildingInterface {
     return result.NotAlwaysCanonicallyAccessed();
   }
 
+  // Records an event of the binary trace of --wasm-trace-file.
+  void TraceEvent(WasmTraceRecordKind kind, WasmCodePosition position,
+                  V<WordPtr> offset,
+                  MachineRepresentation rep = MachineRepresentation::kNone,
+                  bool is_store = false) {
+    uint32_t event =
+        EncodeWasmTraceEvent(kind, ExecutionTier::kTurbofan, rep, is_store);
+    auto sig = FixedSizeSignature<MachineType>::Params(
+        MachineType::Uint32(), MachineType::Int32(), MachineType::Int32(),
+        MachineType::Pointer());
+    CallC(&sig, ExternalReference::wasm_trace_event(),
+          {__ Word32Constant(event), __ Word32Constant(func_index_),
+           __ Word32Constant(position), offset});
+  }
+
   void TraceMemoryOperation(bool is_store, MemoryRepresentation repr,
-                            V<WordPtr> index, uintptr_t offset) {
+                            V<WordPtr> index, uintptr_t offset,
+                            WasmCodePosition position) {
+    V<WordPtr> effective_offset = __ WordPtrAdd(index, offset);
+    if (v8_flags.wasm_trace_file.value() != nullptr) {
+      TraceEvent(WasmTraceRecordKind::kMemoryAccess, position, effective_offset,
+                 repr.ToMachineType().representation(), is_store);
+      return;
+    }
     int kAlign = 4;  // Ensure that the LSB is 0, like a Smi.
     V<WordPtr> info = __ StackSlot(sizeof(MemoryTracingInfo), kAlign);
-    V<WordPtr> effective_offset = __ WordPtrAdd(index, offset);
     __ Store(info, effective_offset, StoreOp::Kind::RawAligned(),
              MemoryRepresentation::PointerSized(), compiler::kNoWriteBarrier,
              offsetof(MemoryTracingInfo, offset));
@@ -216,6 +216,17 @@ class BuiltinLookup {
 
   static constexpr int BuiltinCount() { return kBuiltinCount; }
 
+  // Returns whether {builtin} has a slot in the far jump table.
+  static constexpr bool IsWasmBuiltinId(Builtin builtin) {
+    int index = static_cast<int>(builtin);
+    if (index < 0 ||
+        index >= static_cast<int>(Builtin::kFirstBytecodeHandler)) {
+      return false;
+    }
+    return kFarJumpTableIndexToBuiltin[kBuiltinToFarJumpTableIndex[index]] ==
+           builtin;
+  }
+
  private:
 #define BUILTIN_COUNTER(NAME) +1
   static constexpr int kBuiltinCount =
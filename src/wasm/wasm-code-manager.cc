@@ -834,6 +834,10 @@ NativeModule::NativeModule(WasmFeatures enabled, DynamicTiering dynamic_tiering,
 
     std::fill_n(tiering_budgets_.get(), module_->num_declared_functions,
                 v8_flags.wasm_tiering_budget);
+    if (v8_flags.wasm_code_flushing) {
+      code_ages_ =
+          std::make_unique<uint8_t[]>(module_->num_declared_functions);
+    }
   }
   // Even though there cannot be another thread using this object (since we are
   // just constructing it), we need to hold the mutex to fulfill the
@@ -2382,6 +2386,65 @@ void NativeModule::FreeCode(base::Vector<WasmCode* const> codes) {
   if (debug_info) debug_info->RemoveDebugSideTables(codes);
 }
 
+int NativeModule::AgeTurbofanCode(int max_age) {
+  DCHECK(v8_flags.wasm_code_flushing);
+  DCHECK_LT(0, max_age);
+  const uint32_t num_imports = module_->num_imported_functions;
+  const uint32_t num_functions = module_->num_declared_functions;
+  std::vector<uint32_t> flushed_functions;
+  WasmCodeRefScope ref_scope;
+  {
+    base::RecursiveMutexGuard guard(&allocation_mutex_);
+    // Debug code is never flushed; it also does not mark functions as
+    // executed.
+    if (debug_state_ == kDebugging) return 0;
+    for (uint32_t i = 0; i < num_functions; i++) {
+      WasmCode* code = code_table_[i];
+      if (code == nullptr || !code->is_turbofan()) {
+        code_ages_[i] = 0;
+        continue;
+      }
+      // TurboFan code writes a non-zero value into the tiering budget on
+      // each call.
+      if (tiering_budgets_[i] != 0) {
+        tiering_budgets_[i] = 0;
+        code_ages_[i] = 0;
+        continue;
+      }
+      if (++code_ages_[i] < max_age) continue;
+      code_ages_[i] = 0;
+      code_table_[i] = nullptr;
+      // See {RemoveCompiledCode}: the code gets freed by the next wasm code GC
+      // once it is not on any stack any more.
+      WasmCodeRefScope::AddRef(code);
+      code->DecRefOnLiveCode();
+      uint32_t func_index = i + num_imports;
+      UseLazyStubLocked(func_index);
+      // The function is now executed in Liftoff again after lazy compilation,
+      // which needs a full budget to decide about tiering up again.
+      tiering_budgets_[i] = v8_flags.wasm_tiering_budget;
+      compilation_state_->AllowAnotherTopTierJob(func_index);
+      flushed_functions.push_back(func_index);
+    }
+  }
+  if (flushed_functions.empty()) return 0;
+  // Reset the tier-up priorities, such that the next tier-up request for a
+  // function immediately schedules a TurboFan job again.
+  {
+    TypeFeedbackStorage& type_feedback = module_->type_feedback;
+    base::SharedMutexGuard<base::kExclusive> mutex_guard(&type_feedback.mutex);
+    for (uint32_t func_index : flushed_functions) {
+      auto it = type_feedback.feedback_for_function.find(func_index);
+      if (it != type_feedback.feedback_for_function.end()) {
+        it->second.tierup_priority = 0;
+      }
+    }
+  }
+  counters()->wasm_flushed_functions()->Increment(
+      static_cast<int>(flushed_functions.size()));
+  return static_cast<int>(flushed_functions.size());
+}
+
 size_t NativeModule::GetNumberOfCodeSpacesForTesting() const {
   base::RecursiveMutexGuard guard{&allocation_mutex_};
   return code_allocator_.GetNumCodeSpaces();
@@ -2409,7 +2472,7 @@ NamesProvider* NativeModule::GetNamesProvider() {
 }
 
 size_t NativeModule::EstimateCurrentMemoryConsumption() const {
-  UPDATE_WHEN_CLASS_CHANGES(NativeModule, 440);
+  UPDATE_WHEN_CLASS_CHANGES(NativeModule, 448);
   size_t result = sizeof(NativeModule);
   result += module_->EstimateCurrentMemoryConsumption();
 
@@ -2423,6 +2486,7 @@ size_t NativeModule::EstimateCurrentMemoryConsumption() const {
   result += import_wrapper_cache_->EstimateCurrentMemoryConsumption();
   // For {tiering_budgets_}.
   result += module_->num_declared_functions * sizeof(uint32_t);
+  if (code_ages_) result += module_->num_declared_functions;
 
   {
     base::RecursiveMutexGuard lock(&allocation_mutex_);
@@ -717,6 +717,14 @@ class V8_EXPORT_PRIVATE NativeModule final {
   // {CompileLazy} builtins.
   void RemoveCompiledCode(RemoveFilter filter);
 
+  // Increase the age of all TurboFan code which did not execute since the
+  // last call, and replace code which reached {max_age} by {CompileLazy}
+  // builtins. Functions become eligible for tier-up again afterwards.
+  // Requires --wasm-code-flushing, with which TurboFan code marks its
+  // function as executed in the {tiering_budgets_} array. Returns the number
+  // of flushed functions.
+  int AgeTurbofanCode(int max_age);
+
   // Free a set of functions of this module. Uncommits whole pages if possible.
   // The given vector must be ordered by the instruction start address, and all
   // {WasmCode} objects must not be used any more.
@@ -872,6 +880,11 @@ class V8_EXPORT_PRIVATE NativeModule final {
   // Array to handle number of function calls.
   std::unique_ptr<uint32_t[]> tiering_budgets_;
 
+  // With --wasm-code-flushing, the number of aging cycles for which the
+  // TurboFan code of each declared function did not execute. Protected by
+  // {allocation_mutex_}.
+  std::unique_ptr<uint8_t[]> code_ages_;
+
   // This mutex protects concurrent calls to {AddCode} and friends.
   // TODO(dlehmann): Revert this to a regular {Mutex} again.
   // This needs to be a {RecursiveMutex} only because of {CodeSpaceWriteScope}
@@ -23,7 +23,9 @@
 #include "src/objects/objects.h"
 #include "src/objects/primitive-heap-object.h"
 #include "src/utils/ostreams.h"
+#include "src/wasm/code-file-cache.h"
 #include "src/wasm/function-compiler.h"
+#include "src/wasm/memory-tracing.h"
 #include "src/wasm/module-compiler.h"
 #include "src/wasm/module-decoder.h"
 #include "src/wasm/module-instantiate.h"
@@ -537,6 +539,13 @@ MaybeHandle<WasmModuleObject> WasmEngine::SyncCompile(Isolate* isolate,
                                                       ModuleWireBytes bytes) {
   int compilation_id = next_compilation_id_.fetch_add(1);
   TRACE_EVENT1("v8.wasm", "wasm.SyncCompile", "id", compilation_id);
+  if (V8_UNLIKELY(v8_flags.wasm_code_cache_dir)) {
+    Handle<WasmModuleObject> cached_module;
+    if (LoadModuleFromCodeFileCache(isolate, enabled, bytes.module_bytes())
+            .ToHandle(&cached_module)) {
+      return cached_module;
+    }
+  }
   v8::metrics::Recorder::ContextId context_id =
       isolate->GetOrRegisterRecorderContextId(isolate->native_context());
   std::shared_ptr<WasmModule> module;
@@ -563,6 +572,9 @@ MaybeHandle<WasmModuleObject> WasmEngine::SyncCompile(Isolate* isolate,
       CompileToNativeModule(isolate, enabled, thrower, std::move(module), bytes,
                             compilation_id, context_id, pgo_info.get());
   if (!native_module) return {};
+  if (V8_UNLIKELY(v8_flags.wasm_code_cache_dir)) {
+    StoreModuleToCodeFileCacheOnTierUp(native_module);
+  }
 
 #ifdef DEBUG
   // Ensure that code GC will check this isolate for live code.
@@ -700,6 +712,15 @@ void WasmEngine::AsyncCompile(
   base::OwnedVector<const uint8_t> copy =
       base::OwnedVector<const uint8_t>::Of(bytes.module_bytes());
 
+  if (V8_UNLIKELY(v8_flags.wasm_code_cache_dir)) {
+    Handle<WasmModuleObject> cached_module;
+    if (LoadModuleFromCodeFileCache(isolate, enabled, copy.as_vector())
+            .ToHandle(&cached_module)) {
+      resolver->OnCompilationSucceeded(cached_module);
+      return;
+    }
+  }
+
   AsyncCompileJob* job = CreateAsyncCompileJob(
       isolate, enabled, std::move(copy), isolate->native_context(),
       api_method_name_for_errors, std::move(resolver), compilation_id);
@@ -931,6 +952,34 @@ void WasmEngine::FlushCode() {
   }
 }
 
+void WasmEngine::AgeCode(Isolate* isolate) {
+  DCHECK(v8_flags.wasm_code_flushing);
+  // Flushing code can add potentially dead code, which takes {mutex_}, so
+  // {AgeTurbofanCode} has to be called outside the lock.
+  std::vector<std::shared_ptr<NativeModule>> native_modules;
+  {
+    base::MutexGuard lock(&mutex_);
+    DCHECK_EQ(1, isolates_.count(isolate));
+    for (auto* native_module : isolates_[isolate]->native_modules) {
+      DCHECK_EQ(1, native_modules_.count(native_module));
+      NativeModuleInfo* info = native_modules_[native_module].get();
+      // Modules shared between isolates are aged by the GCs of one of them.
+      if (*info->isolates.begin() != isolate) continue;
+      if (auto shared_ptr = info->weak_ptr.lock()) {
+        native_modules.emplace_back(std::move(shared_ptr));
+      }
+    }
+  }
+  for (auto& native_module : native_modules) {
+    int flushed =
+        native_module->AgeTurbofanCode(v8_flags.wasm_code_flushing_age);
+    if (flushed > 0) {
+      TRACE_CODE_GC("Flushed TurboFan code of %d function%s of module %p.\n",
+                    flushed, flushed == 1 ? "" : "s", native_module.get());
+    }
+  }
+}
+
 std::shared_ptr<CompilationStatistics>
 WasmEngine::GetOrCreateTurboStatistics() {
   base::MutexGuard guard(&mutex_);
@@ -1097,6 +1146,15 @@ void WasmEngine::AddIsolate(Isolate* isolate) {
   };
   isolate->heap()->AddGCEpilogueCallback(callback, v8::kGCTypeMarkSweepCompact,
                                          nullptr);
+  if (v8_flags.wasm_code_flushing) {
+    // Like bytecode flushing, age wasm code on each major GC.
+    auto aging_callback = [](v8::Isolate* v8_isolate, v8::GCType type,
+                             v8::GCCallbackFlags flags, void* data) {
+      GetWasmEngine()->AgeCode(reinterpret_cast<Isolate*>(v8_isolate));
+    };
+    isolate->heap()->AddGCEpilogueCallback(
+        aging_callback, v8::kGCTypeMarkSweepCompact, nullptr);
+  }
 #ifdef V8_ENABLE_WASM_GDB_REMOTE_DEBUGGING
   if (gdb_server_) {
     gdb_server_->AddIsolate(isolate);
@@ -1111,6 +1169,10 @@ void WasmEngine::RemoveIsolate(Isolate* isolate) {
   }
 #endif  // V8_ENABLE_WASM_GDB_REMOTE_DEBUGGING
 
+  // Write out what this isolate's threads traced, such that an embedder which
+  // disposes isolates but never tears down V8 still gets a complete trace.
+  FlushWasmTraceBuffers();
+
   // Keep a WasmCodeRefScope which dies after the {mutex_} is released, to avoid
   // deadlock when code actually dies, as that requires taking the {mutex_}.
   WasmCodeRefScope code_ref_scope_for_dead_code;
@@ -1753,12 +1815,14 @@ void WasmEngine::PotentiallyFinishCurrentGC() {
 }
 
 size_t WasmEngine::EstimateCurrentMemoryConsumption() const {
-  UPDATE_WHEN_CLASS_CHANGES(WasmEngine, 680);
+  UPDATE_WHEN_CLASS_CHANGES(WasmEngine, 768);
   UPDATE_WHEN_CLASS_CHANGES(IsolateInfo, 256);
   UPDATE_WHEN_CLASS_CHANGES(NativeModuleInfo, 144);
   UPDATE_WHEN_CLASS_CHANGES(CurrentGCInfo, 96);
   size_t result = sizeof(WasmEngine);
   result += type_canonicalizer_.EstimateCurrentMemoryConsumption();
+  result += shared_import_wrapper_cache_.EstimateCurrentMemoryConsumption() -
+            sizeof(SharedImportWrapperCache);
   {
     base::MutexGuard lock(&mutex_);
     result += ContentSize(async_compile_jobs_);
@@ -1821,6 +1885,7 @@ void WasmEngine::GlobalTearDown() {
   // Note: This can be called multiple times in a row (see
   // test-api/InitializeAndDisposeMultiple). This is fine, as
   // {global_wasm_engine} will be nullptr then.
+  CloseWasmTraceFile();
   delete global_wasm_state;
   global_wasm_state = nullptr;
 }
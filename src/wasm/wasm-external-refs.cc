@@ -6,12 +6,14 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <algorithm>
 #include <limits>
 
 #include "src/base/bits.h"
 #include "src/base/ieee754.h"
 #include "src/base/safe_conversions.h"
 #include "src/common/assert-scope.h"
+#include "src/flags/flags.h"
 #include "src/utils/memcopy.h"
 #include "src/wasm/wasm-objects-inl.h"
 
@@ -31,8 +33,13 @@
 #include "src/trap-handler/trap-handler.h"
 #endif
 
+#if V8_HOST_ARCH_X64
+#include <emmintrin.h>
+#endif
+
 #include "src/base/memory.h"
 #include "src/utils/utils.h"
+#include "src/wasm/memory-tracing.h"
 #include "src/wasm/wasm-external-refs.h"
 
 namespace v8::internal::wasm {
@@ -461,6 +468,72 @@ V ReadAndIncrementOffset(Address data, size_t* offset) {
 
 constexpr int32_t kSuccess = 1;
 constexpr int32_t kOutOfBounds = 0;
+
+#if V8_HOST_ARCH_X64
+// Large copies and fills (e.g. of frame buffers) use non-temporal stores,
+// which bypass the caches: this avoids evicting the whole working set, and
+// avoids reading the destination cache lines before overwriting them.
+bool UseNonTemporalStores(uintptr_t size) {
+  size_t threshold = v8_flags.wasm_bulk_memory_nontemporal_threshold;
+  return threshold != 0 && size >= threshold;
+}
+
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kPrefetchDistance = 8 * kCacheLineSize;
+
+// Returns the number of bytes before the first 16-byte aligned address in
+// {dst}.
+size_t NonTemporalHeadSize(uint8_t* dst, size_t size) {
+  size_t misalignment = reinterpret_cast<uintptr_t>(dst) & 15;
+  return std::min(size, misalignment == 0 ? 0 : 16 - misalignment);
+}
+
+void NonTemporalMemCopy(uint8_t* dst, const uint8_t* src, size_t size) {
+  size_t head = NonTemporalHeadSize(dst, size);
+  std::memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  size -= head;
+  size_t body = size & ~(kCacheLineSize - 1);
+  for (size_t i = 0; i < body; i += kCacheLineSize) {
+    // Prefetching never faults, so this can safely read past the end.
+    _mm_prefetch(reinterpret_cast<const char*>(src + i + kPrefetchDistance),
+                 _MM_HINT_NTA);
+    const __m128i* from = reinterpret_cast<const __m128i*>(src + i);
+    __m128i* to = reinterpret_cast<__m128i*>(dst + i);
+    __m128i a = _mm_loadu_si128(from);
+    __m128i b = _mm_loadu_si128(from + 1);
+    __m128i c = _mm_loadu_si128(from + 2);
+    __m128i d = _mm_loadu_si128(from + 3);
+    _mm_stream_si128(to, a);
+    _mm_stream_si128(to + 1, b);
+    _mm_stream_si128(to + 2, c);
+    _mm_stream_si128(to + 3, d);
+  }
+  // Non-temporal stores are weakly ordered; make them visible before
+  // returning to wasm.
+  _mm_sfence();
+  std::memcpy(dst + body, src + body, size - body);
+}
+
+void NonTemporalMemSet(uint8_t* dst, uint8_t value, size_t size) {
+  size_t head = NonTemporalHeadSize(dst, size);
+  std::memset(dst, value, head);
+  dst += head;
+  size -= head;
+  size_t body = size & ~(kCacheLineSize - 1);
+  __m128i pattern = _mm_set1_epi8(static_cast<char>(value));
+  for (size_t i = 0; i < body; i += kCacheLineSize) {
+    __m128i* to = reinterpret_cast<__m128i*>(dst + i);
+    _mm_stream_si128(to, pattern);
+    _mm_stream_si128(to + 1, pattern);
+    _mm_stream_si128(to + 2, pattern);
+    _mm_stream_si128(to + 3, pattern);
+  }
+  _mm_sfence();
+  std::memset(dst + body, value, size - body);
+}
+#endif  // V8_HOST_ARCH_X64
 }  // namespace
 
 int32_t memory_init_wrapper(Address data) {
@@ -505,9 +578,17 @@ int32_t memory_copy_wrapper(Address data) {
   if (!base::IsInBounds<uint64_t>(dst, size, dst_mem_size)) return kOutOfBounds;
   if (!base::IsInBounds<uint64_t>(src, size, src_mem_size)) return kOutOfBounds;
 
+  uint8_t* dst_addr = EffectiveAddress(instance, dst_mem_index, dst);
+  uint8_t* src_addr = EffectiveAddress(instance, src_mem_index, src);
+#if V8_HOST_ARCH_X64
+  if (UseNonTemporalStores(size) &&
+      (dst_addr + size <= src_addr || src_addr + size <= dst_addr)) {
+    NonTemporalMemCopy(dst_addr, src_addr, size);
+    return kSuccess;
+  }
+#endif
   // Use std::memmove, because the ranges can overlap.
-  std::memmove(EffectiveAddress(instance, dst_mem_index, dst),
-               EffectiveAddress(instance, src_mem_index, src), size);
+  std::memmove(dst_addr, src_addr, size);
   return kSuccess;
 }
 
@@ -527,10 +608,23 @@ int32_t memory_fill_wrapper(Address data) {
   uint64_t mem_size = instance->memory_size(mem_index);
   if (!base::IsInBounds<uint64_t>(dst, size, mem_size)) return kOutOfBounds;
 
-  std::memset(EffectiveAddress(instance, mem_index, dst), value, size);
+  uint8_t* dst_addr = EffectiveAddress(instance, mem_index, dst);
+#if V8_HOST_ARCH_X64
+  if (UseNonTemporalStores(size)) {
+    NonTemporalMemSet(dst_addr, value, size);
+    return kSuccess;
+  }
+#endif
+  std::memset(dst_addr, value, size);
   return kSuccess;
 }
 
+void trace_event_wrapper(uint32_t event, int32_t func_index, int32_t position,
+                         uintptr_t offset) {
+  ThreadNotInWasmScope thread_not_in_wasm_scope;
+  RecordTraceEvent(event, func_index, position, offset);
+}
+
 namespace {
 inline void* ArrayElementAddress(Address array, uint32_t index,
                                  int element_size_bytes) {
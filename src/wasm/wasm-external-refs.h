@@ -116,6 +116,11 @@ int32_t memory_copy_wrapper(Address data);
 // zero-extend the result in the return register.
 int32_t memory_fill_wrapper(Address data);
 
+// Records an event of the binary trace of --wasm-trace-file, see
+// {RecordTraceEvent}.
+void trace_event_wrapper(uint32_t event, int32_t func_index, int32_t position,
+                         uintptr_t offset);
+
 // Assumes copy ranges are in-bounds and length > 0.
 void array_copy_wrapper(Address raw_instance, Address raw_dst_array,
                         uint32_t dst_index, Address raw_src_array,
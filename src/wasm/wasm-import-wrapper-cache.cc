@@ -6,6 +6,9 @@
 
 #include <vector>
 
+#include "src/codegen/assembler-inl.h"
+#include "src/flags/flags.h"
+#include "src/wasm/function-compiler.h"
 #include "src/wasm/std-object-sizes.h"
 #include "src/wasm/wasm-code-manager.h"
 
@@ -63,6 +66,107 @@ size_t WasmImportWrapperCache::EstimateCurrentMemoryConsumption() const {
   return sizeof(WasmImportWrapperCache) + ContentSize(entry_map_);
 }
 
+SharedImportWrapperCache::SharedImportWrapperCache() = default;
+SharedImportWrapperCache::~SharedImportWrapperCache() = default;
+
+std::shared_ptr<const WasmCompilationResult>
+SharedImportWrapperCache::MaybeGet(const Key& key) {
+  base::MutexGuard lock(&mutex_);
+  auto it = entry_map_.find(key);
+  if (it == entry_map_.end()) return nullptr;
+  lru_list_.splice(lru_list_.begin(), lru_list_, it->second.lru_position);
+  return it->second.result;
+}
+
+// static
+size_t SharedImportWrapperCache::SizeOf(const WasmCompilationResult& result) {
+  return sizeof(WasmCompilationResult) + result.code_desc.buffer_size +
+         result.source_positions.size() +
+         result.protected_instructions_data.size();
+}
+
+// static
+WasmCompilationResult SharedImportWrapperCache::Copy(
+    const WasmCompilationResult& result) {
+  // Copy the code buffer, which also contains the reloc info at its end.
+  WasmCompilationResult copy;
+  const CodeDesc& desc = result.code_desc;
+  copy.instr_buffer = NewAssemblerBuffer(desc.buffer_size);
+  memcpy(copy.instr_buffer->start(), desc.buffer, desc.buffer_size);
+  copy.code_desc = desc;
+  copy.code_desc.buffer = copy.instr_buffer->start();
+  copy.code_desc.origin = nullptr;
+  // Make position-dependent references point into the copy; {AddCode} will
+  // later apply the delta relative to the copy. Wasm calls and stub calls
+  // still hold their call tags, which {AddCode} resolves, so they must not be
+  // relocated here.
+  intptr_t delta = copy.code_desc.buffer - desc.buffer;
+  Address copy_start = reinterpret_cast<Address>(copy.code_desc.buffer);
+  const int mode_mask =
+      RelocInfo::kApplyMask & ~(RelocInfo::ModeMask(RelocInfo::WASM_CALL) |
+                                RelocInfo::ModeMask(RelocInfo::WASM_STUB_CALL));
+  WritableJitAllocation jit_allocation =
+      WritableJitAllocation::ForNonExecutableMemory(
+          copy_start, desc.instr_size,
+          ThreadIsolation::JitAllocationType::kWasmCode);
+  for (WritableRelocIterator it(
+           jit_allocation,
+           {copy.code_desc.buffer, static_cast<size_t>(desc.instr_size)},
+           {copy.code_desc.buffer + desc.buffer_size - desc.reloc_size,
+            static_cast<size_t>(desc.reloc_size)},
+           copy_start + desc.constant_pool_offset, mode_mask);
+       !it.done(); it.next()) {
+    it.rinfo()->apply(delta);
+  }
+  copy.frame_slot_count = result.frame_slot_count;
+  copy.tagged_parameter_slots = result.tagged_parameter_slots;
+  copy.source_positions =
+      base::OwnedVector<uint8_t>::Of(result.source_positions);
+  copy.protected_instructions_data =
+      base::OwnedVector<uint8_t>::Of(result.protected_instructions_data);
+  copy.func_index = result.func_index;
+  copy.requested_tier = result.requested_tier;
+  copy.result_tier = result.result_tier;
+  copy.kind = result.kind;
+  return copy;
+}
+
+void SharedImportWrapperCache::Insert(const Key& key,
+                                      const WasmCompilationResult& result) {
+  DCHECK(result.succeeded());
+  {
+    base::MutexGuard lock(&mutex_);
+    if (entry_map_.count(key)) return;
+  }
+
+  auto copy = std::make_shared<WasmCompilationResult>(Copy(result));
+  const size_t size = SizeOf(*copy);
+  const size_t max_size =
+      size_t{v8_flags.wasm_shared_import_wrapper_cache_size} * KB;
+  base::MutexGuard lock(&mutex_);
+  if (size > max_size) return;
+  // Another thread might have added the same wrapper in the meantime.
+  if (entry_map_.count(key)) return;
+  while (total_size_ + size > max_size) {
+    DCHECK(!lru_list_.empty());
+    auto evicted = entry_map_.find(lru_list_.back());
+    DCHECK(evicted != entry_map_.end());
+    total_size_ -= evicted->second.size;
+    entry_map_.erase(evicted);
+    lru_list_.pop_back();
+  }
+  lru_list_.push_front(key);
+  entry_map_.emplace(key, Entry{std::move(copy), size, lru_list_.begin()});
+  total_size_ += size;
+}
+
+size_t SharedImportWrapperCache::EstimateCurrentMemoryConsumption() const {
+  UPDATE_WHEN_CLASS_CHANGES(SharedImportWrapperCache, 120);
+  base::MutexGuard lock(&mutex_);
+  return sizeof(SharedImportWrapperCache) + ContentSize(entry_map_) +
+         lru_list_.size() * (sizeof(Key) + 2 * sizeof(void*)) + total_size_;
+}
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
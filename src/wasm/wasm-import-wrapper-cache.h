@@ -9,8 +9,13 @@
 #ifndef V8_WASM_WASM_IMPORT_WRAPPER_CACHE_H_
 #define V8_WASM_WASM_IMPORT_WRAPPER_CACHE_H_
 
+#include <list>
+#include <memory>
+#include <unordered_map>
+
 #include "src/base/platform/mutex.h"
 #include "src/wasm/module-instantiate.h"
+#include "src/wasm/wasm-features.h"
 
 namespace v8 {
 namespace internal {
@@ -21,6 +26,7 @@ namespace wasm {
 
 class WasmCode;
 class WasmEngine;
+struct WasmCompilationResult;
 
 using FunctionSig = Signature<ValueType>;
 
@@ -89,6 +95,75 @@ class WasmImportWrapperCache {
   std::unordered_map<CacheKey, WasmCode*, CacheKeyHash> entry_map_;
 };
 
+// A process-wide cache of compiled import wrappers, owned by the {WasmEngine}
+// and shared by all modules and isolates. Import wrapper code has to live in
+// the code space of the calling module (it calls runtime stubs through the
+// module's jump table), so this caches the relocatable compilation result
+// instead of {WasmCode}. A cached result can be added to any {NativeModule}
+// without compiling it again.
+//
+// The cache holds at most --wasm-shared-import-wrapper-cache-size KB of code
+// and evicts the least recently used entries beyond that.
+class SharedImportWrapperCache {
+ public:
+  struct Key {
+    WasmImportWrapperCache::CacheKey wrapper_key;
+    // The code also depends on these properties of the calling module.
+    WasmFeatures enabled_features;
+    bool source_positions;
+
+    bool operator==(const Key& rhs) const {
+      return wrapper_key == rhs.wrapper_key &&
+             enabled_features == rhs.enabled_features &&
+             source_positions == rhs.source_positions;
+    }
+  };
+
+  class KeyHash {
+   public:
+    size_t operator()(const Key& key) const {
+      return base::hash_combine(
+          WasmImportWrapperCache::CacheKeyHash{}(key.wrapper_key),
+          key.enabled_features.ToIntegral(), key.source_positions);
+    }
+  };
+
+  SharedImportWrapperCache();
+  ~SharedImportWrapperCache();
+
+  // Thread-safe. Returns nullptr if the key doesn't exist in the cache. The
+  // returned result stays valid even if the entry is evicted in the meantime.
+  std::shared_ptr<const WasmCompilationResult> MaybeGet(const Key& key);
+
+  // Thread-safe. Stores a copy of {result}, unless another thread added an
+  // entry for {key} in the meantime, and evicts the least recently used
+  // entries if the cache gets too large.
+  void Insert(const Key& key, const WasmCompilationResult& result);
+
+  // Returns a copy of {result} which owns its code buffer. The copy stays
+  // relocatable: position-dependent references are adjusted to the new
+  // buffer, wasm calls and stub calls keep their call tags.
+  static WasmCompilationResult Copy(const WasmCompilationResult& result);
+
+  size_t EstimateCurrentMemoryConsumption() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const WasmCompilationResult> result;
+    size_t size;
+    // Position in {lru_list_}.
+    std::list<Key>::iterator lru_position;
+  };
+
+  static size_t SizeOf(const WasmCompilationResult& result);
+
+  mutable base::Mutex mutex_;
+  std::unordered_map<Key, Entry, KeyHash> entry_map_;
+  // The keys of all entries, most recently used first.
+  std::list<Key> lru_list_;
+  size_t total_size_ = 0;
+};
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
@@ -15,6 +15,7 @@
 #include "src/wasm/function-compiler.h"
 #include "src/wasm/module-compiler.h"
 #include "src/wasm/module-decoder.h"
+#include "src/wasm/wasm-builtin-list.h"
 #include "src/wasm/wasm-code-manager.h"
 #include "src/wasm/wasm-engine.h"
 #include "src/wasm/wasm-module.h"
@@ -134,9 +135,9 @@ void WriteHeader(Writer* writer) {
   DCHECK_EQ(WasmSerializer::kHeaderSize, writer->bytes_written());
 }
 
-// On Intel, call sites are encoded as a displacement. For linking and for
-// serialization/deserialization, we want to store/retrieve a tag (the function
-// index). On Intel, that means accessing the raw displacement.
+// On Intel, call sites are encoded as a displacement. For serialization, we
+// want to store a tag (the function index) instead of the target address. On
+// Intel, that means writing the raw displacement.
 // On ARM64, call sites are encoded as either a literal load or a direct branch.
 // Other platforms simply require accessing the target address.
 void SetWasmCalleeTag(WritableRelocInfo* rinfo, uint32_t tag) {
@@ -166,31 +167,6 @@ void SetWasmCalleeTag(WritableRelocInfo* rinfo, uint32_t tag) {
 #endif
 }
 
-uint32_t GetWasmCalleeTag(RelocInfo* rinfo) {
-#if V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_IA32
-  DCHECK(!RelocInfo::IsCompressedEmbeddedObject(rinfo->rmode()));
-  return ReadUnalignedValue<uint32_t>(rinfo->target_address_address());
-#elif V8_TARGET_ARCH_ARM64
-  Instruction* instr = reinterpret_cast<Instruction*>(rinfo->pc());
-  if (instr->IsLdrLiteralX()) {
-    return ReadUnalignedValue<uint32_t>(rinfo->constant_pool_entry_address());
-  } else {
-    DCHECK(instr->IsBranchAndLink() || instr->IsUnconditionalBranch());
-    return static_cast<uint32_t>(instr->ImmPCOffset() / kInstrSize);
-  }
-#else
-  Address addr;
-  if (rinfo->rmode() == RelocInfo::EXTERNAL_REFERENCE) {
-    addr = rinfo->target_external_reference();
-  } else if (rinfo->rmode() == RelocInfo::WASM_STUB_CALL) {
-    addr = rinfo->wasm_stub_call_address();
-  } else {
-    addr = rinfo->target_address();
-  }
-  return static_cast<uint32_t>(addr);
-#endif
-}
-
 constexpr size_t kHeaderSize = sizeof(size_t) +  // total code size
                                sizeof(bool);     // all functions validated
 
@@ -208,7 +184,83 @@ constexpr size_t kCodeHeaderSize = sizeof(uint8_t) +  // code kind
                                    sizeof(int) +  // inlining positions size
                                    sizeof(int) +  // protected instructions size
                                    sizeof(WasmCode::Kind) +  // code kind
-                                   sizeof(ExecutionTier);    // tier
+                                   sizeof(ExecutionTier) +   // tier
+                                   sizeof(uint32_t);  // number of patches
+
+// The machine code of all functions is stored in a single code section at the
+// end of the serialized data. Its start is aligned to the OS page size
+// (relative to the start of the data), such that an embedder which keeps the
+// serialized data in a page-aligned (e.g. memory-mapped) buffer can use the
+// code section without any further copying or realignment.
+constexpr size_t kCodeSectionAlignment = kMinimumOSPageSize;
+
+// Size of the padding before the code section, if all data before the code
+// section takes {offset} bytes.
+size_t CodeSectionPadding(size_t offset) {
+  return RoundUp(offset, kCodeSectionAlignment) - offset;
+}
+
+// A position in the code of a function which needs to be patched upon
+// deserialization. This replaces walking the reloc info of each function
+// during deserialization. The {tag} is the function index for
+// {WASM_CALL}, the builtin for {WASM_STUB_CALL}, the external reference tag
+// for {EXTERNAL_REFERENCE}, and the offset of the target in the function's
+// code for internal references.
+struct RelocationPatch {
+  uint32_t pc_offset;
+  uint32_t mode;
+  uint32_t tag;
+};
+static_assert(sizeof(RelocationPatch) == 3 * sizeof(uint32_t));
+
+constexpr int kRelocationPatchMask =
+    RelocInfo::ModeMask(RelocInfo::WASM_CALL) |
+    RelocInfo::ModeMask(RelocInfo::WASM_STUB_CALL) |
+    RelocInfo::ModeMask(RelocInfo::EXTERNAL_REFERENCE) |
+    RelocInfo::ModeMask(RelocInfo::INTERNAL_REFERENCE) |
+    RelocInfo::ModeMask(RelocInfo::INTERNAL_REFERENCE_ENCODED);
+
+// The number of bytes at the pc of a patch which relocation overwrites. Call
+// targets are a displacement of {kSpecialTargetSize} bytes on x64, ia32 and
+// arm, and are encoded in at least one 32-bit instruction elsewhere. External
+// and internal references are full addresses.
+size_t PatchSize(RelocInfo::Mode mode) {
+  if (RelocInfo::IsWasmCall(mode) || RelocInfo::IsWasmStubCall(mode)) {
+    return std::max<size_t>(Assembler::kSpecialTargetSize, sizeof(int32_t));
+  }
+  return sizeof(Address);
+}
+
+// Checks that relocating a patch of {mode} at {pc_offset} only touches bytes
+// within {code}, including the constant pool slot from which the instruction
+// at {pc_offset} might load its target.
+bool IsPatchWithinCode(base::Vector<const uint8_t> code, uint32_t pc_offset,
+                       RelocInfo::Mode mode) {
+  if (pc_offset > code.size() || code.size() - pc_offset < PatchSize(mode)) {
+    return false;
+  }
+  if (RelocInfo::IsInternalReference(mode) ||
+      RelocInfo::IsInternalReferenceEncoded(mode)) {
+    return true;
+  }
+  Address code_start = reinterpret_cast<Address>(code.begin());
+  Address pc = code_start + pc_offset;
+  USE(pc);
+  Address slot = kNullAddress;
+#if V8_TARGET_ARCH_ARM64
+  // Decode the instruction like {Assembler::set_target_address_at} does.
+  if (reinterpret_cast<Instruction*>(pc)->IsLdrLiteralX()) {
+    slot = Assembler::target_pointer_address_at(pc);
+  }
+#elif V8_TARGET_ARCH_ARM
+  if (Assembler::is_constant_pool_load(pc)) {
+    slot = Assembler::constant_pool_entry_address(pc, kNullAddress);
+  }
+#endif
+  if (slot == kNullAddress) return true;
+  return slot >= code_start && slot - code_start <= code.size() &&
+         code.size() - (slot - code_start) >= sizeof(Address);
+}
 
 // A List of all isolate-independent external references. This is used to create
 // a tag from the Address of an external reference and vice versa.
@@ -231,10 +283,14 @@ class ExternalReferenceList {
   }
 
   Address address_from_tag(uint32_t tag) const {
-    DCHECK_GT(kNumExternalReferences, tag);
+    DCHECK(is_valid_tag(tag));
     return external_reference_by_tag_[tag];
   }
 
+  static constexpr bool is_valid_tag(uint32_t tag) {
+    return tag < kNumExternalReferences;
+  }
+
   static const ExternalReferenceList& Get() {
     static ExternalReferenceList list;  // Lazily initialized.
     return list;
@@ -290,14 +346,22 @@ class V8_EXPORT_PRIVATE NativeModuleSerializer {
   bool Write(Writer* writer);
 
  private:
-  size_t MeasureCode(const WasmCode*) const;
+  size_t MeasureCode(const WasmCode*,
+                     base::Vector<const RelocationPatch> patches) const;
+  size_t TotalCodeSize() const;
+  std::vector<RelocationPatch> ComputePatches(const WasmCode*) const;
   void WriteHeader(Writer*, size_t total_code_size);
-  void WriteCode(const WasmCode*, Writer*);
+  void WriteCode(const WasmCode*, base::Vector<const RelocationPatch> patches,
+                 Writer*);
   void WriteTieringBudget(Writer* writer);
+  void WriteCodeSection(Writer* writer);
 
   const NativeModule* const native_module_;
   const base::Vector<WasmCode* const> code_table_;
   const base::Vector<WellKnownImport const> import_statuses_;
+  // The relocation patches of each TurboFan function, in the order of
+  // {code_table_}. Empty for all other functions.
+  std::vector<std::vector<RelocationPatch>> patches_;
   bool write_called_ = false;
   size_t total_written_code_ = 0;
   int num_turbofan_functions_ = 0;
@@ -312,33 +376,93 @@ NativeModuleSerializer::NativeModuleSerializer(
   DCHECK_NOT_NULL(native_module_);
   // TODO(mtrofin): persist the export wrappers. Ideally, we'd only persist
   // the unique ones, i.e. the cache.
+  // Walking the reloc info is expensive, so do it once, for both measuring
+  // and writing.
+  patches_.reserve(code_table_.size());
+  for (WasmCode* code : code_table_) {
+    patches_.push_back(code && code->tier() == ExecutionTier::kTurbofan
+                           ? ComputePatches(code)
+                           : std::vector<RelocationPatch>{});
+  }
 }
 
-size_t NativeModuleSerializer::MeasureCode(const WasmCode* code) const {
+size_t NativeModuleSerializer::MeasureCode(
+    const WasmCode* code, base::Vector<const RelocationPatch> patches) const {
   if (code == nullptr) return sizeof(uint8_t);
   DCHECK_EQ(WasmCode::kWasmFunction, code->kind());
   if (code->tier() != ExecutionTier::kTurbofan) {
     return sizeof(uint8_t);
   }
-  return kCodeHeaderSize + code->instructions().size() +
-         code->reloc_info().size() + code->source_positions().size() +
-         code->inlining_positions().size() +
-         code->protected_instructions_data().size();
+  // The instructions themselves are accounted for in the code section.
+  return kCodeHeaderSize + code->reloc_info().size() +
+         code->source_positions().size() + code->inlining_positions().size() +
+         code->protected_instructions_data().size() +
+         patches.size() * sizeof(RelocationPatch);
+}
+
+size_t NativeModuleSerializer::TotalCodeSize() const {
+  size_t total_code_size = 0;
+  for (WasmCode* code : code_table_) {
+    if (code && code->tier() == ExecutionTier::kTurbofan) {
+      DCHECK(IsAligned(code->instructions().size(), kCodeAlignment));
+      total_code_size += code->instructions().size();
+    }
+  }
+  return total_code_size;
 }
 
 size_t NativeModuleSerializer::Measure() const {
   size_t size = kHeaderSize;
-  for (WasmCode* code : code_table_) {
-    size += MeasureCode(code);
+  for (size_t i = 0; i < code_table_.size(); ++i) {
+    size += MeasureCode(code_table_[i], base::VectorOf(patches_[i]));
   }
   // Add the size of the well-known imports status.
   size += import_statuses_.size() * sizeof(WellKnownImport);
   // Add the size of the tiering budget.
   size += native_module_->module()->num_declared_functions * sizeof(uint32_t);
+  // Add the padding before the code section, and the code section itself.
+  size += CodeSectionPadding(WasmSerializer::kHeaderSize + size);
+  size += TotalCodeSize();
 
   return size;
 }
 
+std::vector<RelocationPatch> NativeModuleSerializer::ComputePatches(
+    const WasmCode* code) const {
+  std::vector<RelocationPatch> patches;
+  for (RelocIterator it(code->instructions(), code->reloc_info(),
+                        code->constant_pool(), kRelocationPatchMask);
+       !it.done(); it.next()) {
+    RelocInfo::Mode mode = it.rinfo()->rmode();
+    uint32_t tag;
+    switch (mode) {
+      case RelocInfo::WASM_CALL:
+        tag = native_module_->GetFunctionIndexFromJumpTableSlot(
+            it.rinfo()->wasm_call_address());
+        break;
+      case RelocInfo::WASM_STUB_CALL:
+        tag = static_cast<uint32_t>(native_module_->GetBuiltinInJumptableSlot(
+            it.rinfo()->wasm_stub_call_address()));
+        break;
+      case RelocInfo::EXTERNAL_REFERENCE:
+        tag = ExternalReferenceList::Get().tag_from_address(
+            it.rinfo()->target_external_reference());
+        break;
+      case RelocInfo::INTERNAL_REFERENCE:
+      case RelocInfo::INTERNAL_REFERENCE_ENCODED:
+        tag = static_cast<uint32_t>(it.rinfo()->target_internal_reference() -
+                                    code->instruction_start());
+        break;
+      default:
+        UNREACHABLE();
+    }
+    uint32_t pc_offset =
+        static_cast<uint32_t>(it.rinfo()->pc() - code->instruction_start());
+    patches.push_back({pc_offset, static_cast<uint32_t>(mode), tag});
+  }
+  return patches;
+}
+
 void NativeModuleSerializer::WriteHeader(Writer* writer,
                                          size_t total_code_size) {
   // TODO(eholk): We need to properly preserve the flag whether the trap
@@ -363,7 +487,9 @@ void NativeModuleSerializer::WriteHeader(Writer* writer,
   writer->WriteVector(base::VectorOf(import_statuses_));
 }
 
-void NativeModuleSerializer::WriteCode(const WasmCode* code, Writer* writer) {
+void NativeModuleSerializer::WriteCode(
+    const WasmCode* code, base::Vector<const RelocationPatch> patches,
+    Writer* writer) {
   if (code == nullptr) {
     writer->Write(kLazyFunction);
     return;
@@ -390,7 +516,8 @@ void NativeModuleSerializer::WriteCode(const WasmCode* code, Writer* writer) {
 
   ++num_turbofan_functions_;
   writer->Write(kTurboFanFunction);
-  // Write the size of the entire code section, followed by the code header.
+  // Write the code header. The instructions are written to the code section
+  // later (see {WriteCodeSection}).
   writer->Write(code->constant_pool_offset());
   writer->Write(code->safepoint_table_offset());
   writer->Write(code->handler_table_offset());
@@ -405,118 +532,94 @@ void NativeModuleSerializer::WriteCode(const WasmCode* code, Writer* writer) {
   writer->Write(code->protected_instructions_data().length());
   writer->Write(code->kind());
   writer->Write(code->tier());
+  writer->Write(static_cast<uint32_t>(patches.size()));
 
-  // Get a pointer to the destination buffer, to hold relocated code.
-  uint8_t* serialized_code_start = writer->current_buffer().begin();
-  uint8_t* code_start = serialized_code_start;
-  size_t code_size = code->instructions().size();
-  writer->Skip(code_size);
-  // Write the reloc info, source positions, inlining positions and protected
-  // code.
+  // Write the reloc info, source positions, inlining positions, protected
+  // code, and the relocation patches.
   writer->WriteVector(code->reloc_info());
   writer->WriteVector(code->source_positions());
   writer->WriteVector(code->inlining_positions());
   writer->WriteVector(code->protected_instructions_data());
+  writer->WriteVector(patches);
+}
+
+void NativeModuleSerializer::WriteTieringBudget(Writer* writer) {
+  writer->WriteVector(
+      base::VectorOf(native_module_->tiering_budget_array(),
+                     native_module_->module()->num_declared_functions));
+}
+
+void NativeModuleSerializer::WriteCodeSection(Writer* writer) {
+  size_t padding = CodeSectionPadding(writer->bytes_written());
+  memset(writer->current_location(), 0, padding);
+  writer->Skip(padding);
+  DCHECK(IsAligned(writer->bytes_written(), kCodeSectionAlignment));
+
+  for (size_t i = 0; i < code_table_.size(); ++i) {
+    WasmCode* code = code_table_[i];
+    if (!code || code->tier() != ExecutionTier::kTurbofan) continue;
+    // Get a pointer to the destination buffer, to hold relocated code.
+    uint8_t* serialized_code_start = writer->current_location();
+    uint8_t* code_start = serialized_code_start;
+    size_t code_size = code->instructions().size();
+    writer->Skip(code_size);
 #if V8_TARGET_ARCH_MIPS64 || V8_TARGET_ARCH_ARM || V8_TARGET_ARCH_PPC ||      \
     V8_TARGET_ARCH_PPC64 || V8_TARGET_ARCH_S390X || V8_TARGET_ARCH_RISCV32 || \
     V8_TARGET_ARCH_RISCV64
-  // On platforms that don't support misaligned word stores, copy to an aligned
-  // buffer if necessary so we can relocate the serialized code.
-  std::unique_ptr<uint8_t[]> aligned_buffer;
-  if (!IsAligned(reinterpret_cast<Address>(serialized_code_start),
-                 kSystemPointerSize)) {
-    // 'uint8_t' does not guarantee an alignment but seems to work well enough
-    // in practice.
-    aligned_buffer.reset(new uint8_t[code_size]);
-    code_start = aligned_buffer.get();
-  }
+    // On platforms that don't support misaligned word stores, copy to an
+    // aligned buffer if necessary so we can relocate the serialized code.
+    std::unique_ptr<uint8_t[]> aligned_buffer;
+    if (!IsAligned(reinterpret_cast<Address>(serialized_code_start),
+                   kSystemPointerSize)) {
+      // 'uint8_t' does not guarantee an alignment but seems to work well
+      // enough in practice.
+      aligned_buffer.reset(new uint8_t[code_size]);
+      code_start = aligned_buffer.get();
+    }
 #endif
-  memcpy(code_start, code->instructions().begin(), code_size);
-  // Relocate the code.
-  int mask = RelocInfo::ModeMask(RelocInfo::WASM_CALL) |
-             RelocInfo::ModeMask(RelocInfo::WASM_STUB_CALL) |
-             RelocInfo::ModeMask(RelocInfo::EXTERNAL_REFERENCE) |
-             RelocInfo::ModeMask(RelocInfo::INTERNAL_REFERENCE) |
-             RelocInfo::ModeMask(RelocInfo::INTERNAL_REFERENCE_ENCODED);
-  RelocIterator orig_iter(code->instructions(), code->reloc_info(),
-                          code->constant_pool(), mask);
-  WritableJitAllocation jit_allocation =
-      WritableJitAllocation::ForNonExecutableMemory(
-          reinterpret_cast<Address>(code_start), code->instructions().size(),
-          ThreadIsolation::JitAllocationType::kWasmCode);
-  for (WritableRelocIterator iter(
-           jit_allocation, {code_start, code->instructions().size()},
-           code->reloc_info(),
-           reinterpret_cast<Address>(code_start) + code->constant_pool_offset(),
-           mask);
-       !iter.done(); iter.next(), orig_iter.next()) {
-    RelocInfo::Mode mode = orig_iter.rinfo()->rmode();
-    switch (mode) {
-      case RelocInfo::WASM_CALL: {
-        Address orig_target = orig_iter.rinfo()->wasm_call_address();
-        uint32_t tag =
-            native_module_->GetFunctionIndexFromJumpTableSlot(orig_target);
-        SetWasmCalleeTag(iter.rinfo(), tag);
-      } break;
-      case RelocInfo::WASM_STUB_CALL: {
-        Address target = orig_iter.rinfo()->wasm_stub_call_address();
-        uint32_t tag = static_cast<uint32_t>(
-            native_module_->GetBuiltinInJumptableSlot(target));
-        SetWasmCalleeTag(iter.rinfo(), tag);
-      } break;
-      case RelocInfo::EXTERNAL_REFERENCE: {
-        Address orig_target = orig_iter.rinfo()->target_external_reference();
-        uint32_t ext_ref_tag =
-            ExternalReferenceList::Get().tag_from_address(orig_target);
-        SetWasmCalleeTag(iter.rinfo(), ext_ref_tag);
-      } break;
-      case RelocInfo::INTERNAL_REFERENCE:
-      case RelocInfo::INTERNAL_REFERENCE_ENCODED: {
-        Address orig_target = orig_iter.rinfo()->target_internal_reference();
-        Address offset = orig_target - code->instruction_start();
+    memcpy(code_start, code->instructions().begin(), code_size);
+    // Replace all process-specific addresses by their tags, such that the
+    // serialized code does not depend on the code space it was compiled to.
+    Address code_start_address = reinterpret_cast<Address>(code_start);
+    Address constant_pool = code_start_address + code->constant_pool_offset();
+    for (const RelocationPatch& patch : patches_[i]) {
+      RelocInfo::Mode mode = static_cast<RelocInfo::Mode>(patch.mode);
+      WritableRelocInfo rinfo(code_start_address + patch.pc_offset, mode, 0,
+                              constant_pool);
+      if (RelocInfo::IsInternalReference(mode) ||
+          RelocInfo::IsInternalReferenceEncoded(mode)) {
         Assembler::deserialization_set_target_internal_reference_at(
-            iter.rinfo()->pc(), offset, mode);
-      } break;
-      default:
-        UNREACHABLE();
+            rinfo.pc(), patch.tag, mode);
+      } else {
+        SetWasmCalleeTag(&rinfo, patch.tag);
+      }
     }
+    // If we copied to an aligned buffer, copy code into serialized buffer.
+    if (code_start != serialized_code_start) {
+      memcpy(serialized_code_start, code_start, code_size);
+    }
+    total_written_code_ += code_size;
   }
-  // If we copied to an aligned buffer, copy code into serialized buffer.
-  if (code_start != serialized_code_start) {
-    memcpy(serialized_code_start, code_start, code_size);
-  }
-  total_written_code_ += code_size;
-}
-
-void NativeModuleSerializer::WriteTieringBudget(Writer* writer) {
-  writer->WriteVector(
-      base::VectorOf(native_module_->tiering_budget_array(),
-                     native_module_->module()->num_declared_functions));
 }
 
 bool NativeModuleSerializer::Write(Writer* writer) {
   DCHECK(!write_called_);
   write_called_ = true;
 
-  size_t total_code_size = 0;
-  for (WasmCode* code : code_table_) {
-    if (code && code->tier() == ExecutionTier::kTurbofan) {
-      DCHECK(IsAligned(code->instructions().size(), kCodeAlignment));
-      total_code_size += code->instructions().size();
-    }
-  }
+  size_t total_code_size = TotalCodeSize();
   WriteHeader(writer, total_code_size);
 
-  for (WasmCode* code : code_table_) {
-    WriteCode(code, writer);
+  for (size_t i = 0; i < code_table_.size(); ++i) {
+    WriteCode(code_table_[i], base::VectorOf(patches_[i]), writer);
   }
   // If not a single function was written, serialization was not successful.
   if (num_turbofan_functions_ == 0) return false;
 
+  WriteTieringBudget(writer);
+  WriteCodeSection(writer);
+
   // Make sure that the serialized total code size was correct.
   CHECK_EQ(total_written_code_, total_code_size);
-
-  WriteTieringBudget(writer);
   return true;
 }
 
@@ -547,6 +650,8 @@ bool WasmSerializer::SerializeNativeModule(base::Vector<uint8_t> buffer) const {
 
 struct DeserializationUnit {
   base::Vector<const uint8_t> src_code_buffer;
+  // Serialized {RelocationPatch} entries; not necessarily aligned.
+  base::Vector<const uint8_t> patches;
   std::unique_ptr<WasmCode> code;
   NativeModule::JumpTablesRef jump_tables;
 };
@@ -610,7 +715,10 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   friend class DeserializeCodeTask;
 
   void ReadHeader(Reader* reader);
-  DeserializationUnit ReadCode(int fn_index, Reader* reader);
+  // Returns false if the serialized code is malformed. Sets {unit->code} only
+  // for functions which were serialized with code.
+  bool ReadCode(int fn_index, Reader* reader, DeserializationUnit* unit);
+  bool ValidatePatches(const DeserializationUnit& unit) const;
   void ReadTieringBudget(Reader* reader);
   void CopyAndRelocate(const DeserializationUnit& unit);
   void Publish(std::vector<DeserializationUnit> batch);
@@ -620,8 +728,12 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   bool read_called_ = false;
 #endif
 
+  // The code section at the end of the serialized data.
+  base::Vector<const uint8_t> code_section_;
+
   // Updated in {ReadCode}.
   size_t remaining_code_size_ = 0;
+  size_t code_section_offset_ = 0;
   bool all_functions_validated_ = false;
   base::Vector<uint8_t> current_code_space_;
   NativeModule::JumpTablesRef current_jump_tables_;
@@ -700,6 +812,16 @@ bool NativeModuleDeserializer::Read(Reader* reader) {
 #endif
 
   ReadHeader(reader);
+  // The code section is stored at the very end of the data, and starts at an
+  // aligned offset. Bail out early on truncated data.
+  size_t total_code_size = remaining_code_size_;
+  if (reader->current_size() < total_code_size) return false;
+  size_t code_section_start = WasmSerializer::kHeaderSize +
+                              reader->bytes_read() + reader->current_size() -
+                              total_code_size;
+  if (!IsAligned(code_section_start, kCodeSectionAlignment)) return false;
+  code_section_ = reader->current_buffer().SubVector(
+      reader->current_size() - total_code_size, reader->current_size());
   uint32_t total_fns = native_module_->num_functions();
   uint32_t first_wasm_fn = native_module_->num_imported_functions();
 
@@ -726,7 +848,12 @@ bool NativeModuleDeserializer::Read(Reader* reader) {
   std::vector<DeserializationUnit> batch;
   size_t batch_size = 0;
   for (uint32_t i = first_wasm_fn; i < total_fns; ++i) {
-    DeserializationUnit unit = ReadCode(i, reader);
+    DeserializationUnit unit;
+    if (!ReadCode(i, reader, &unit) || (unit.code && !ValidatePatches(unit))) {
+      // Drop the units which were not relocated yet; the module is discarded.
+      job_handle->Cancel();
+      return false;
+    }
     if (!unit.code) continue;
     batch_size += unit.code->instructions().size();
     batch.emplace_back(std::move(unit));
@@ -752,7 +879,10 @@ bool NativeModuleDeserializer::Read(Reader* reader) {
   job_handle->Join();
 
   ReadTieringBudget(reader);
-  return reader->current_size() == 0;
+  // Only the padding and the code section should be left.
+  size_t padding =
+      CodeSectionPadding(WasmSerializer::kHeaderSize + reader->bytes_read());
+  return reader->current_size() == padding + code_section_.size();
 }
 
 void NativeModuleDeserializer::ReadHeader(Reader* reader) {
@@ -768,16 +898,16 @@ void NativeModuleDeserializer::ReadHeader(Reader* reader) {
   }
 }
 
-DeserializationUnit NativeModuleDeserializer::ReadCode(int fn_index,
-                                                       Reader* reader) {
+bool NativeModuleDeserializer::ReadCode(int fn_index, Reader* reader,
+                                        DeserializationUnit* unit) {
   uint8_t code_kind = reader->Read<uint8_t>();
   if (code_kind == kLazyFunction) {
     lazy_functions_.push_back(fn_index);
-    return {};
+    return true;
   }
   if (code_kind == kEagerFunction) {
     eager_functions_.push_back(fn_index);
-    return {};
+    return true;
   }
 
   int constant_pool_offset = reader->Read<int>();
@@ -794,9 +924,27 @@ DeserializationUnit NativeModuleDeserializer::ReadCode(int fn_index,
   int protected_instructions_size = reader->Read<int>();
   WasmCode::Kind kind = reader->Read<WasmCode::Kind>();
   ExecutionTier tier = reader->Read<ExecutionTier>();
+  uint32_t num_patches = reader->Read<uint32_t>();
 
-  DCHECK(IsAligned(code_size, kCodeAlignment));
-  DCHECK_GE(remaining_code_size_, code_size);
+  // The code has to fit into the remaining code section, and the metadata into
+  // the remaining data; otherwise the data is malformed, and the module gets
+  // compiled instead.
+  if (reloc_size < 0 || source_position_size < 0 ||
+      inlining_position_size < 0 || protected_instructions_size < 0) {
+    return false;
+  }
+  if (reader->current_size() <
+      size_t{num_patches} * sizeof(RelocationPatch) + reloc_size +
+          source_position_size + inlining_position_size +
+          protected_instructions_size) {
+    return false;
+  }
+  if (code_size < 0 || !IsAligned(code_size, kCodeAlignment)) return false;
+  if (remaining_code_size_ < static_cast<size_t>(code_size)) return false;
+  if (code_section_.size() - code_section_offset_ <
+      static_cast<size_t>(code_size)) {
+    return false;
+  }
   if (current_code_space_.size() < static_cast<size_t>(code_size)) {
     // Allocate the next code space. Don't allocate more than 90% of
     // {kMaxCodeSpaceSize}, to leave some space for jump tables.
@@ -809,26 +957,74 @@ DeserializationUnit NativeModuleDeserializer::ReadCode(int fn_index,
     CHECK(current_jump_tables_.is_valid());
   }
 
-  DeserializationUnit unit;
-  unit.src_code_buffer = reader->ReadVector<uint8_t>(code_size);
+  unit->src_code_buffer =
+      code_section_.SubVector(code_section_offset_,
+                              code_section_offset_ + code_size);
+  code_section_offset_ += code_size;
   auto reloc_info = reader->ReadVector<uint8_t>(reloc_size);
   auto source_pos = reader->ReadVector<uint8_t>(source_position_size);
   auto inlining_pos = reader->ReadVector<uint8_t>(inlining_position_size);
   auto protected_instructions =
       reader->ReadVector<uint8_t>(protected_instructions_size);
+  unit->patches =
+      reader->ReadVector<uint8_t>(num_patches * sizeof(RelocationPatch));
 
   base::Vector<uint8_t> instructions =
       current_code_space_.SubVector(0, code_size);
   current_code_space_ += code_size;
   remaining_code_size_ -= code_size;
 
-  unit.code = native_module_->AddDeserializedCode(
+  unit->code = native_module_->AddDeserializedCode(
       fn_index, instructions, stack_slot_count, tagged_parameter_slots,
       safepoint_table_offset, handler_table_offset, constant_pool_offset,
       code_comment_offset, unpadded_binary_size, protected_instructions,
       reloc_info, source_pos, inlining_pos, kind, tier);
-  unit.jump_tables = current_jump_tables_;
-  return unit;
+  unit->jump_tables = current_jump_tables_;
+  return true;
+}
+
+// The patches come from the serialized data, so check that each has a known
+// mode and refers to a location and target which exist before applying them.
+bool NativeModuleDeserializer::ValidatePatches(
+    const DeserializationUnit& unit) const {
+  size_t code_size = unit.code->instructions().size();
+  DCHECK_EQ(code_size, unit.src_code_buffer.size());
+  for (size_t offset = 0; offset < unit.patches.size();
+       offset += sizeof(RelocationPatch)) {
+    RelocationPatch patch = ReadUnalignedValue<RelocationPatch>(
+        reinterpret_cast<Address>(unit.patches.begin() + offset));
+    if (patch.mode >= static_cast<uint32_t>(RelocInfo::NUMBER_OF_MODES)) {
+      return false;
+    }
+    RelocInfo::Mode mode = static_cast<RelocInfo::Mode>(patch.mode);
+    if ((RelocInfo::ModeMask(mode) & kRelocationPatchMask) == 0) return false;
+    if (!IsPatchWithinCode(unit.src_code_buffer, patch.pc_offset, mode)) {
+      return false;
+    }
+    switch (mode) {
+      case RelocInfo::WASM_CALL:
+        if (patch.tag < native_module_->num_imported_functions() ||
+            patch.tag >= native_module_->num_functions()) {
+          return false;
+        }
+        break;
+      case RelocInfo::WASM_STUB_CALL:
+        if (!BuiltinLookup::IsWasmBuiltinId(static_cast<Builtin>(patch.tag))) {
+          return false;
+        }
+        break;
+      case RelocInfo::EXTERNAL_REFERENCE:
+        if (!ExternalReferenceList::is_valid_tag(patch.tag)) return false;
+        break;
+      case RelocInfo::INTERNAL_REFERENCE:
+      case RelocInfo::INTERNAL_REFERENCE_ENCODED:
+        if (patch.tag >= code_size) return false;
+        break;
+      default:
+        UNREACHABLE();
+    }
+  }
+  return true;
 }
 
 void NativeModuleDeserializer::CopyAndRelocate(
@@ -841,44 +1037,44 @@ void NativeModuleDeserializer::CopyAndRelocate(
   jit_allocation.CopyCode(0, unit.src_code_buffer.begin(),
                           unit.src_code_buffer.size());
 
-  // Relocate the code.
-  int mask = RelocInfo::ModeMask(RelocInfo::WASM_CALL) |
-             RelocInfo::ModeMask(RelocInfo::WASM_STUB_CALL) |
-             RelocInfo::ModeMask(RelocInfo::EXTERNAL_REFERENCE) |
-             RelocInfo::ModeMask(RelocInfo::INTERNAL_REFERENCE) |
-             RelocInfo::ModeMask(RelocInfo::INTERNAL_REFERENCE_ENCODED);
-  for (WritableRelocIterator iter(jit_allocation, unit.code->instructions(),
-                                  unit.code->reloc_info(),
-                                  unit.code->constant_pool(), mask);
-       !iter.done(); iter.next()) {
-    RelocInfo::Mode mode = iter.rinfo()->rmode();
+  // Relocate the code. Instead of walking the reloc info, apply the patches
+  // which were recorded at serialization time, and validated in
+  // {ValidatePatches}.
+  Address code_start = unit.code->instruction_start();
+  size_t code_size = unit.code->instructions().size();
+  for (size_t offset = 0; offset < unit.patches.size();
+       offset += sizeof(RelocationPatch)) {
+    RelocationPatch patch = ReadUnalignedValue<RelocationPatch>(
+        reinterpret_cast<Address>(unit.patches.begin() + offset));
+    RelocInfo::Mode mode = static_cast<RelocInfo::Mode>(patch.mode);
+    DCHECK_LE(patch.pc_offset + PatchSize(mode), code_size);
+    WritableRelocInfo rinfo(code_start + patch.pc_offset, mode, 0,
+                            unit.code->constant_pool());
     switch (mode) {
       case RelocInfo::WASM_CALL: {
-        uint32_t tag = GetWasmCalleeTag(iter.rinfo());
-        Address target =
-            native_module_->GetNearCallTargetForFunction(tag, unit.jump_tables);
-        iter.rinfo()->set_wasm_call_address(target, SKIP_ICACHE_FLUSH);
+        Address target = native_module_->GetNearCallTargetForFunction(
+            patch.tag, unit.jump_tables);
+        rinfo.set_wasm_call_address(target, SKIP_ICACHE_FLUSH);
         break;
       }
       case RelocInfo::WASM_STUB_CALL: {
-        uint32_t tag = GetWasmCalleeTag(iter.rinfo());
         Address target = native_module_->GetJumpTableEntryForBuiltin(
-            static_cast<Builtin>(tag), unit.jump_tables);
-        iter.rinfo()->set_wasm_stub_call_address(target, SKIP_ICACHE_FLUSH);
+            static_cast<Builtin>(patch.tag), unit.jump_tables);
+        rinfo.set_wasm_stub_call_address(target, SKIP_ICACHE_FLUSH);
         break;
       }
       case RelocInfo::EXTERNAL_REFERENCE: {
-        uint32_t tag = GetWasmCalleeTag(iter.rinfo());
-        Address address = ExternalReferenceList::Get().address_from_tag(tag);
-        iter.rinfo()->set_target_external_reference(address, SKIP_ICACHE_FLUSH);
+        Address address =
+            ExternalReferenceList::Get().address_from_tag(patch.tag);
+        rinfo.set_target_external_reference(address, SKIP_ICACHE_FLUSH);
         break;
       }
       case RelocInfo::INTERNAL_REFERENCE:
       case RelocInfo::INTERNAL_REFERENCE_ENCODED: {
-        Address offset = iter.rinfo()->target_internal_reference();
-        Address target = unit.code->instruction_start() + offset;
+        DCHECK_LT(patch.tag, code_size);
+        Address target = code_start + patch.tag;
         Assembler::deserialization_set_target_internal_reference_at(
-            iter.rinfo()->pc(), target, mode);
+            rinfo.pc(), target, mode);
         break;
       }
       default:
@@ -0,0 +1,147 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "src/base/strings.h"
+#include "src/codegen/cpu-features.h"
+#include "src/strings/string-case.h"
+#include "src/strings/string-compare-simd.h"
+#include "src/utils/utils.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+using v8::base::uc16;
+using v8::internal::CpuFeatures;
+
+namespace {
+
+// Lengths of the strings of each benchmark.
+constexpr int kShortLength = 32;
+constexpr int kLongLength = 64 * 1024;
+
+// Latin-1 text of words in upper and lower case, with accented letters.
+std::vector<uint8_t> MakeLatin1(int length) {
+  std::vector<uint8_t> chars;
+  uint32_t seed = 17;
+  auto next_random = [&seed]() {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+  };
+  while (static_cast<int>(chars.size()) < length) {
+    uint8_t first = next_random() % 2 ? 'A' : 'a';
+    uint8_t first_accented = first == 'A' ? 0xC0 : 0xE0;
+    int word_length = 1 + next_random() % 8;
+    for (int i = 0; i < word_length; ++i) {
+      chars.push_back(next_random() % 4 ? first + next_random() % 26
+                                        : first_accented + next_random() % 23);
+    }
+    chars.push_back(' ');
+  }
+  chars.resize(length);
+  return chars;
+}
+
+// The scalar loops which the vectorized code replaces.
+void ScalarToLower(uint8_t* dst, const uint8_t* src, int length) {
+  for (int i = 0; i < length; ++i) {
+    uint8_t c = src[i];
+    bool convert =
+        ('A' <= c && c <= 'Z') || (0xC0 <= c && c <= 0xDE && c != 0xD7);
+    dst[i] = convert ? c | 0x20 : c;
+  }
+}
+
+void BM_Latin1ToLower(benchmark::State& state, bool vectorized) {
+  CpuFeatures::Probe(false);
+  const int length = static_cast<int>(state.range(0));
+  std::vector<uint8_t> src = MakeLatin1(length);
+  std::vector<uint8_t> dst(length);
+  for (auto _ : state) {
+    if (vectorized) {
+      v8::internal::Latin1ConvertToLower(dst.data(), src.data(), length);
+    } else {
+      ScalarToLower(dst.data(), src.data(), length);
+    }
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * length);
+}
+
+void BM_Latin1ToUpper(benchmark::State& state) {
+  CpuFeatures::Probe(false);
+  const int length = static_cast<int>(state.range(0));
+  std::vector<uint8_t> src = MakeLatin1(length);
+  std::vector<uint8_t> dst(length);
+  for (auto _ : state) {
+    int sharp_s_count;
+    bool result = v8::internal::Latin1ConvertToUpper(dst.data(), src.data(),
+                                                     length, &sharp_s_count);
+    benchmark::DoNotOptimize(result);
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * length);
+}
+
+// Compares equal strings, which is the worst case for all comparisons.
+template <typename lchar, typename rchar>
+void RunCompare(benchmark::State& state, bool vectorized) {
+  CpuFeatures::Probe(false);
+  const int length = static_cast<int>(state.range(0));
+  std::vector<uint8_t> latin1 = MakeLatin1(length);
+  std::vector<lchar> lhs(latin1.begin(), latin1.end());
+  std::vector<rchar> rhs(latin1.begin(), latin1.end());
+  for (auto _ : state) {
+    int result =
+        vectorized
+            ? v8::internal::CompareCharsVectorized(lhs.data(), rhs.data(),
+                                                   length)
+            : v8::internal::CompareChars(lhs.data(), rhs.data(), length);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * length);
+}
+
+template <typename lchar, typename rchar>
+void RunCompareEqual(benchmark::State& state, bool vectorized) {
+  CpuFeatures::Probe(false);
+  const int length = static_cast<int>(state.range(0));
+  std::vector<uint8_t> latin1 = MakeLatin1(length);
+  std::vector<lchar> lhs(latin1.begin(), latin1.end());
+  std::vector<rchar> rhs(latin1.begin(), latin1.end());
+  for (auto _ : state) {
+    bool result =
+        vectorized
+            ? v8::internal::CompareCharsEqualVectorized(lhs.data(), rhs.data(),
+                                                        length)
+            : v8::internal::CompareCharsEqual(lhs.data(), rhs.data(), length);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * length);
+}
+
+void BM_CompareOneByteTwoByte(benchmark::State& state, bool vectorized) {
+  RunCompare<uint8_t, uc16>(state, vectorized);
+}
+
+void BM_CompareTwoByte(benchmark::State& state, bool vectorized) {
+  RunCompare<uc16, uc16>(state, vectorized);
+}
+
+void BM_EqualOneByteTwoByte(benchmark::State& state, bool vectorized) {
+  RunCompareEqual<uint8_t, uc16>(state, vectorized);
+}
+
+}  // namespace
+
+#define SCALAR_AND_VECTORIZED(name)                                            \
+  BENCHMARK_CAPTURE(name, scalar, false)->Arg(kShortLength)->Arg(kLongLength); \
+  BENCHMARK_CAPTURE(name, vectorized, true)->Arg(kShortLength)->Arg(kLongLength)
+
+SCALAR_AND_VECTORIZED(BM_Latin1ToLower);
+BENCHMARK(BM_Latin1ToUpper)->Arg(kShortLength)->Arg(kLongLength);
+SCALAR_AND_VECTORIZED(BM_CompareOneByteTwoByte);
+SCALAR_AND_VECTORIZED(BM_CompareTwoByte);
+SCALAR_AND_VECTORIZED(BM_EqualOneByteTwoByte);
+
+#undef SCALAR_AND_VECTORIZED
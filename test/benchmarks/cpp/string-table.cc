@@ -0,0 +1,154 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "include/libplatform/libplatform.h"
+#include "include/v8-array-buffer.h"
+#include "include/v8-initialization.h"
+#include "include/v8-isolate.h"
+#include "include/v8-platform.h"
+#include "src/base/platform/elapsed-timer.h"
+#include "src/base/strings.h"
+#include "src/common/globals.h"
+#include "src/execution/isolate.h"
+#include "src/heap/factory.h"
+#include "src/heap/parked-scope-inl.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace v8::internal {
+namespace {
+
+// Number of strings which each thread internalizes per iteration.
+constexpr int kKeys = 10000;
+
+v8::ArrayBuffer::Allocator* array_buffer_allocator;
+// The first isolate, which owns the shared heap and the shared string table.
+v8::Isolate* main_isolate;
+// Keys are never reused, such that every iteration inserts new strings.
+std::atomic<int> next_key{0};
+
+v8::Isolate* NewIsolate() {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = array_buffer_allocator;
+  return v8::Isolate::New(create_params);
+}
+
+class InternalizationThread final : public ParkingThread {
+ public:
+  InternalizationThread(int first_key, int offset, ParkingSemaphore* ready,
+                        ParkingSemaphore* execute_start,
+                        ParkingSemaphore* execute_complete)
+      : ParkingThread(base::Thread::Options("InternalizationThread")),
+        first_key_(first_key),
+        offset_(offset),
+        ready_(ready),
+        execute_start_(execute_start),
+        execute_complete_(execute_complete) {}
+
+  void Run() override {
+    v8::Isolate* isolate = NewIsolate();
+    {
+      Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+      v8::Isolate::Scope isolate_scope(isolate);
+      ready_->Signal();
+      execute_start_->ParkedWait(i_isolate->main_thread_local_isolate());
+
+      // The threads start at different keys, so that all of them insert some
+      // of the strings and hit others which were just inserted.
+      for (int i = 0; i < kKeys; i++) {
+        HandleScope scope(i_isolate);
+        base::EmbeddedVector<char, 32> chars;
+        base::SNPrintF(chars, "k%d", first_key_ + (offset_ + i) % kKeys);
+        benchmark::DoNotOptimize(
+            i_isolate->factory()->InternalizeUtf8String(chars.begin()));
+      }
+      execute_complete_->Signal();
+    }
+    isolate->Dispose();
+  }
+
+ private:
+  const int first_key_;
+  const int offset_;
+  ParkingSemaphore* const ready_;
+  ParkingSemaphore* const execute_start_;
+  ParkingSemaphore* const execute_complete_;
+};
+
+// Internalizes the same new strings from state.range(0) client isolates in
+// parallel. Only the internalization is timed, not the isolate setup.
+void BM_InternalizeNewStrings(benchmark::State& state) {
+  const int thread_count = static_cast<int>(state.range(0));
+  LocalIsolate* local_isolate =
+      reinterpret_cast<Isolate*>(main_isolate)->main_thread_local_isolate();
+  for (auto _ : state) {
+    const int first_key = next_key.fetch_add(kKeys);
+    ParkingSemaphore ready(0);
+    ParkingSemaphore execute_start(0);
+    ParkingSemaphore execute_complete(0);
+    std::vector<std::unique_ptr<InternalizationThread>> threads;
+    for (int i = 0; i < thread_count; i++) {
+      auto thread = std::make_unique<InternalizationThread>(
+          first_key, i * kKeys / thread_count, &ready, &execute_start,
+          &execute_complete);
+      CHECK(thread->Start());
+      threads.push_back(std::move(thread));
+    }
+    for (int i = 0; i < thread_count; i++) ready.ParkedWait(local_isolate);
+
+    base::ElapsedTimer timer;
+    timer.Start();
+    for (int i = 0; i < thread_count; i++) execute_start.Signal();
+    for (int i = 0; i < thread_count; i++) {
+      execute_complete.ParkedWait(local_isolate);
+    }
+    state.SetIterationTime(timer.Elapsed().InSecondsF());
+    ParkingThread::ParkedJoinAll(local_isolate, threads);
+  }
+  state.SetItemsProcessed(state.iterations() * thread_count * kKeys);
+}
+
+BENCHMARK(BM_InternalizeNewStrings)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace v8::internal
+
+int main(int argc, char** argv) {
+  using v8::internal::array_buffer_allocator;
+  using v8::internal::main_isolate;
+
+  // All isolates share the string table, which is what the benchmark is
+  // about.
+  if (!V8_CAN_CREATE_SHARED_HEAP_BOOL) return 0;
+  v8::V8::SetFlagsFromString("--shared-string-table");
+  std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
+  v8::V8::InitializePlatform(platform.get());
+  v8::V8::Initialize();
+  std::unique_ptr<v8::ArrayBuffer::Allocator> allocator(
+      v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+  array_buffer_allocator = allocator.get();
+  main_isolate = v8::internal::NewIsolate();
+  main_isolate->Enter();
+
+  // Contents of BENCHMARK_MAIN().
+  {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+  }
+
+  main_isolate->Exit();
+  main_isolate->Dispose();
+  v8::V8::Dispose();
+  v8::V8::DisposePlatform();
+  return 0;
+}
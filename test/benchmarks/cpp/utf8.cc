@@ -0,0 +1,144 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "src/base/logging.h"
+#include "src/base/macros.h"
+#include "src/base/vector.h"
+#include "src/codegen/cpu-features.h"
+#include "src/strings/unicode-decoder.h"
+#include "src/strings/utf8-simd.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+using v8::base::uc16;
+using v8::base::Vector;
+using v8::internal::CpuFeatures;
+
+namespace {
+
+// Size of the UTF-8 input of each benchmark.
+constexpr size_t kInputSize = 1 << 20;
+
+// Each kind of text consists of words of 1 to 8 characters from a range
+// of code points, which are separated by ASCII spaces.
+enum class Text { kAscii, kLatin1, kCyrillic, kCjk, kEmoji };
+
+uint32_t FirstCodePoint(Text text) {
+  switch (text) {
+    case Text::kAscii:
+      return 'a';
+    case Text::kLatin1:
+      return 0xE0;
+    case Text::kCyrillic:
+      return 0x430;
+    case Text::kCjk:
+      return 0x4E00;
+    case Text::kEmoji:
+      return 0x1F600;
+  }
+  UNREACHABLE();
+}
+
+void EncodeUtf8(uint32_t c, std::vector<uint8_t>* out) {
+  if (c < 0x80) {
+    out->push_back(c);
+  } else if (c < 0x800) {
+    out->push_back(0xC0 | (c >> 6));
+    out->push_back(0x80 | (c & 0x3F));
+  } else if (c < 0x10000) {
+    out->push_back(0xE0 | (c >> 12));
+    out->push_back(0x80 | ((c >> 6) & 0x3F));
+    out->push_back(0x80 | (c & 0x3F));
+  } else {
+    out->push_back(0xF0 | (c >> 18));
+    out->push_back(0x80 | ((c >> 12) & 0x3F));
+    out->push_back(0x80 | ((c >> 6) & 0x3F));
+    out->push_back(0x80 | (c & 0x3F));
+  }
+}
+
+std::vector<uint8_t> MakeUtf8(Text text) {
+  std::vector<uint8_t> utf8;
+  uint32_t seed = 17;
+  auto next_random = [&seed]() {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+  };
+  while (utf8.size() < kInputSize) {
+    int word_length = 1 + next_random() % 8;
+    for (int i = 0; i < word_length; ++i) {
+      EncodeUtf8(FirstCodePoint(text) + next_random() % 26, &utf8);
+    }
+    utf8.push_back(' ');
+  }
+  return utf8;
+}
+
+std::vector<uc16> MakeUtf16(Text text) {
+  std::vector<uint8_t> utf8 = MakeUtf8(text);
+  Vector<const uint8_t> data(utf8.data(), utf8.size());
+  v8::internal::Utf8Decoder decoder(data);
+  std::vector<uc16> utf16(decoder.utf16_length());
+  decoder.Decode(utf16.data(), data);
+  return utf16;
+}
+
+void BM_Utf8Decode(benchmark::State& state, Text text) {
+  CpuFeatures::Probe(false);
+  std::vector<uint8_t> utf8 = MakeUtf8(text);
+  Vector<const uint8_t> data(utf8.data(), utf8.size());
+  std::vector<uc16> out(utf8.size());
+  for (auto _ : state) {
+    v8::internal::Utf8Decoder decoder(data);
+    if (decoder.is_one_byte()) {
+      decoder.Decode(reinterpret_cast<uint8_t*>(out.data()), data);
+    } else {
+      decoder.Decode(out.data(), data);
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * utf8.size());
+}
+
+void BM_ValidateUtf8(benchmark::State& state, Text text) {
+  CpuFeatures::Probe(false);
+  std::vector<uint8_t> utf8 = MakeUtf8(text);
+  Vector<const uint8_t> data(utf8.data(), utf8.size());
+  for (auto _ : state) {
+    int utf16_length;
+    bool is_one_byte;
+    bool valid =
+        v8::internal::ValidateUtf8(data, &utf16_length, &is_one_byte);
+    benchmark::DoNotOptimize(valid);
+    benchmark::DoNotOptimize(utf16_length);
+  }
+  state.SetBytesProcessed(state.iterations() * utf8.size());
+}
+
+void BM_Utf8EncodedLength(benchmark::State& state, Text text) {
+  CpuFeatures::Probe(false);
+  std::vector<uc16> utf16 = MakeUtf16(text);
+  Vector<const uc16> chars(utf16.data(), utf16.size());
+  for (auto _ : state) {
+    int length = v8::internal::Utf8EncodedLength(chars);
+    benchmark::DoNotOptimize(length);
+  }
+  state.SetBytesProcessed(state.iterations() * utf16.size() * sizeof(uc16));
+}
+
+}  // namespace
+
+#define UTF8_BENCHMARKS(name)                         \
+  BENCHMARK_CAPTURE(name, ascii, Text::kAscii);       \
+  BENCHMARK_CAPTURE(name, latin1, Text::kLatin1);     \
+  BENCHMARK_CAPTURE(name, cyrillic, Text::kCyrillic); \
+  BENCHMARK_CAPTURE(name, cjk, Text::kCjk);           \
+  BENCHMARK_CAPTURE(name, emoji, Text::kEmoji)
+
+UTF8_BENCHMARKS(BM_Utf8Decode);
+UTF8_BENCHMARKS(BM_ValidateUtf8);
+UTF8_BENCHMARKS(BM_Utf8EncodedLength);
+
+#undef UTF8_BENCHMARKS
@@ -6,6 +6,7 @@
 #include "src/objects/objects-inl.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/compiler/codegen-tester.h"
+#include "test/common/flag-utils.h"
 
 namespace v8 {
 namespace internal {
@@ -140,6 +141,50 @@ TEST(ProfileLoop) {
   }
 }
 
+TEST(ProfileGuidedLayout) {
+  FLAG_SCOPE(allow_natives_syntax);
+  FLAG_SCOPE(turbo_profile_guided_layout);
+  FLAG_VALUE_SCOPE(turboshaft, false);
+  FLAG_VALUE_SCOPE(concurrent_recompilation, false);
+  FlagScope<unsigned int> min_count_scope(
+      &v8_flags.turbo_profile_guided_layout_min_count, 10);
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+
+  // The first optimized code is instrumented with block counters.
+  CompileRun(
+      "function f(x) {"
+      "  if (x < 0) return -x;"
+      "  return x + 1;"
+      "}"
+      "%PrepareFunctionForOptimization(f);"
+      "f(1);"
+      "f(-1);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "for (let i = 0; i < 100; ++i) f(i);");
+  Handle<JSFunction> f = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("f")));
+  const BasicBlockProfiler::LayoutProfile* profile =
+      BasicBlockProfiler::Get()->GetLayoutProfileForTesting(f->shared());
+  CHECK_NOT_NULL(profile);
+  CHECK_EQ(1, profile->instrumentation_count);
+  CHECK_NULL(profile->hints.get());
+  const size_t unhinted_deferred_blocks = profile->deferred_block_count;
+
+  // Reoptimizing the same graph uses the counts to defer the cold branch,
+  // without instrumenting the code again.
+  CompileRun(
+      "%DeoptimizeFunction(f);"
+      "%PrepareFunctionForOptimization(f);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f(1);");
+  CHECK_EQ(profile, BasicBlockProfiler::Get()->GetLayoutProfileForTesting(
+                        f->shared()));
+  CHECK_EQ(1, profile->instrumentation_count);
+  CHECK_NOT_NULL(profile->hints.get());
+  CHECK_GT(profile->deferred_block_count, unhinted_deferred_blocks);
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,144 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "src/api/api-inl.h"
+#include "src/base/platform/platform.h"
+#include "src/base/strings.h"
+#include "src/baseline/baseline-batch-compiler.h"
+#include "src/baseline/baseline.h"
+#include "src/execution/isolate.h"
+#include "src/execution/stack-guard.h"
+#include "src/objects/js-function-inl.h"
+#include "test/cctest/cctest.h"
+#include "test/common/flag-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace test_baseline_batch_compiler {
+
+#ifdef V8_ENABLE_SPARKPLUG
+
+namespace {
+
+constexpr int kNumBatches = 8;
+
+// Creates {kNumBatches} functions with bytecode but without baseline code.
+std::vector<Handle<JSFunction>> CreateFunctions(const char* prefix) {
+  std::vector<Handle<JSFunction>> functions;
+  for (int i = 0; i < kNumBatches; i++) {
+    base::EmbeddedVector<char, 128> source;
+    base::SNPrintF(source,
+                   "function %s%d(x) { return x + %d; }; %s%d(1); %s%d", prefix,
+                   i, i, prefix, i, prefix, i);
+    Handle<JSFunction> function = Handle<JSFunction>::cast(
+        v8::Utils::OpenHandle(*CompileRun(source.begin())));
+    CHECK(!function->shared()->HasBaselineCode());
+    functions.push_back(function);
+  }
+  return functions;
+}
+
+// Enqueues every function in its own batch, and waits until all batches are
+// compiled and the background job has requested their installation.
+void CompileBatches(Isolate* isolate,
+                    const std::vector<Handle<JSFunction>>& functions) {
+  baseline::BaselineBatchCompiler* compiler =
+      isolate->baseline_batch_compiler();
+  CHECK_EQ(0, compiler->NumBatchesToInstallForTesting());
+  for (Handle<JSFunction> function : functions) {
+    compiler->EnqueueFunction(function);
+  }
+  while (compiler->NumBatchesToInstallForTesting() < functions.size() ||
+         !isolate->stack_guard()->CheckInstallBaselineCode()) {
+    base::OS::Sleep(base::TimeDelta::FromMilliseconds(1));
+  }
+  isolate->stack_guard()->ClearInstallBaselineCode();
+}
+
+int CountBaselineCode(const std::vector<Handle<JSFunction>>& functions) {
+  int count = 0;
+  for (Handle<JSFunction> function : functions) {
+    if (function->shared()->HasBaselineCode()) count++;
+  }
+  return count;
+}
+
+bool CanTest(Isolate* isolate) {
+  if (!v8_flags.concurrent_sparkplug || v8_flags.always_sparkplug) {
+    return false;
+  }
+  HandleScope scope(isolate);
+  Handle<JSFunction> function = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("(function probe() {})")));
+  return CanCompileWithBaseline(isolate, function->shared());
+}
+
+}  // namespace
+
+TEST(InstallBatchWithinBudget) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(CcTest::isolate());
+  if (!CanTest(isolate)) return;
+  // Every enqueued function is compiled in a batch of its own.
+  FlagScope<int> threshold(&v8_flags.baseline_batch_compilation_threshold, 1);
+  // Installing a single batch takes longer than the budget.
+  FlagScope<unsigned int> budget(
+      &v8_flags.concurrent_sparkplug_install_budget_us, 1);
+  baseline::BaselineBatchCompiler* compiler =
+      isolate->baseline_batch_compiler();
+  std::vector<Handle<JSFunction>> functions = CreateFunctions("f");
+  CompileBatches(isolate, functions);
+
+  // The first interrupt installs some of the batches, and requests another
+  // interrupt for the rest.
+  isolate->stack_guard()->RequestInstallBaselineCode();
+  isolate->stack_guard()->HandleInterrupts();
+  size_t remaining = compiler->NumBatchesToInstallForTesting();
+  CHECK_GT(remaining, 0);
+  CHECK_LT(remaining, kNumBatches);
+  CHECK_EQ(kNumBatches - static_cast<int>(remaining),
+           CountBaselineCode(functions));
+  CHECK(isolate->stack_guard()->CheckInstallBaselineCode());
+
+  // Each following interrupt makes progress, until all batches are installed.
+  int interrupts = 1;
+  while (isolate->stack_guard()->CheckInstallBaselineCode()) {
+    isolate->stack_guard()->HandleInterrupts();
+    CHECK_LT(compiler->NumBatchesToInstallForTesting(), remaining);
+    remaining = compiler->NumBatchesToInstallForTesting();
+    interrupts++;
+  }
+  CHECK_LE(interrupts, kNumBatches);
+  CHECK_EQ(0, compiler->NumBatchesToInstallForTesting());
+  CHECK_EQ(kNumBatches, CountBaselineCode(functions));
+}
+
+TEST(InstallBatchWithoutBudget) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(CcTest::isolate());
+  if (!CanTest(isolate)) return;
+  FlagScope<int> threshold(&v8_flags.baseline_batch_compilation_threshold, 1);
+  FlagScope<unsigned int> budget(
+      &v8_flags.concurrent_sparkplug_install_budget_us, 0);
+  baseline::BaselineBatchCompiler* compiler =
+      isolate->baseline_batch_compiler();
+  std::vector<Handle<JSFunction>> functions = CreateFunctions("g");
+  CompileBatches(isolate, functions);
+
+  // Without a budget, a single interrupt installs all batches.
+  isolate->stack_guard()->RequestInstallBaselineCode();
+  isolate->stack_guard()->HandleInterrupts();
+  CHECK_EQ(0, compiler->NumBatchesToInstallForTesting());
+  CHECK_EQ(kNumBatches, CountBaselineCode(functions));
+}
+
+#endif  // V8_ENABLE_SPARKPLUG
+
+}  // namespace test_baseline_batch_compiler
+}  // namespace internal
+}  // namespace v8
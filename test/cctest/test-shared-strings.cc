@@ -463,6 +463,114 @@ UNINITIALIZED_TEST(ConcurrentInternalizationHit) {
   TestConcurrentInternalization(kTestHit);
 }
 
+class ConcurrentNewStringInternalizationThread final : public ParkingThread {
+ public:
+  ConcurrentNewStringInternalizationThread(
+      MultiClientIsolateTest* test, const char* prefix, int first_key,
+      Handle<FixedArray> results, ParkingSemaphore* sema_ready,
+      ParkingSemaphore* sema_execute_start,
+      ParkingSemaphore* sema_execute_complete)
+      : ParkingThread(
+            base::Thread::Options("ConcurrentNewStringInternalizationThread")),
+        test_(test),
+        prefix_(prefix),
+        first_key_(first_key),
+        results_(results),
+        sema_ready_(sema_ready),
+        sema_execute_start_(sema_execute_start),
+        sema_execute_complete_(sema_execute_complete) {}
+
+  void Run() override {
+    IsolateWrapper isolate_wrapper(test_->NewClientIsolate());
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate_wrapper.isolate);
+    Factory* factory = i_isolate->factory();
+
+    sema_ready_->Signal();
+    sema_execute_start_->ParkedWait(i_isolate->main_thread_local_isolate());
+
+    // The threads start at different keys, so that all of them insert some
+    // of the strings and hit others which were just inserted.
+    const int keys = results_->length();
+    for (int i = 0; i < keys; i++) {
+      HandleScope scope(i_isolate);
+      int key = (first_key_ + i) % keys;
+      base::EmbeddedVector<char, 32> chars;
+      base::SNPrintF(chars, "%s%d", prefix_, key);
+      Handle<String> internalized =
+          factory->InternalizeUtf8String(chars.begin());
+      CHECK(internalized->IsShared());
+      results_->set(key, *internalized);
+    }
+
+    sema_execute_complete_->Signal();
+  }
+
+ private:
+  MultiClientIsolateTest* test_;
+  const char* prefix_;
+  int first_key_;
+  Handle<FixedArray> results_;
+  ParkingSemaphore* sema_ready_;
+  ParkingSemaphore* sema_execute_start_;
+  ParkingSemaphore* sema_execute_complete_;
+};
+
+UNINITIALIZED_TEST(ConcurrentInternalizationOfNewStrings) {
+  if (!V8_CAN_CREATE_SHARED_HEAP_BOOL) return;
+
+  v8_flags.shared_string_table = true;
+
+  // Enough strings to resize the string table several times while the
+  // threads insert into it.
+  constexpr int kKeys = 40000;
+  constexpr const char* kPrefixes[] = {"a", "b", "c", "d"};
+
+  MultiClientIsolateTest test;
+  Isolate* i_isolate = test.i_main_isolate();
+  Factory* factory = i_isolate->factory();
+  LocalIsolate* local_isolate = i_isolate->main_thread_local_isolate();
+
+  HandleScope scope(i_isolate);
+
+  for (int round = 0; round < 4; round++) {
+    const int threads_in_round = 1 << round;
+    ParkingSemaphore sema_ready(0);
+    ParkingSemaphore sema_execute_start(0);
+    ParkingSemaphore sema_execute_complete(0);
+    std::vector<Handle<FixedArray>> results;
+    std::vector<std::unique_ptr<ConcurrentNewStringInternalizationThread>>
+        threads;
+    for (int i = 0; i < threads_in_round; i++) {
+      results.push_back(
+          factory->NewFixedArray(kKeys, AllocationType::kSharedOld));
+      auto thread = std::make_unique<ConcurrentNewStringInternalizationThread>(
+          &test, kPrefixes[round], i * kKeys / threads_in_round, results[i],
+          &sema_ready, &sema_execute_start, &sema_execute_complete);
+      CHECK(thread->Start());
+      threads.push_back(std::move(thread));
+    }
+
+    for (int i = 0; i < threads_in_round; i++) {
+      sema_ready.ParkedWait(local_isolate);
+    }
+    for (int i = 0; i < threads_in_round; i++) {
+      sema_execute_start.Signal();
+    }
+    for (int i = 0; i < threads_in_round; i++) {
+      sema_execute_complete.ParkedWait(local_isolate);
+    }
+    ParkingThread::ParkedJoinAll(local_isolate, threads);
+
+    // All threads got the same string for each key.
+    for (int key = 0; key < kKeys; key++) {
+      CHECK(IsInternalizedString(results[0]->get(key)));
+      for (int i = 1; i < threads_in_round; i++) {
+        CHECK_EQ(results[0]->get(key), results[i]->get(key));
+      }
+    }
+  }
+}
+
 class ConcurrentStringTableLookupThread final
     : public ConcurrentStringThreadBase {
  public:
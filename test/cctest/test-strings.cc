@@ -39,6 +39,7 @@
 #include "src/base/strings.h"
 #include "src/execution/messages.h"
 #include "src/heap/factory.h"
+#include "src/heap/cold-string-compressor.h"
 #include "src/heap/heap-inl.h"
 #include "src/objects/objects-inl.h"
 #include "test/cctest/cctest.h"
@@ -2128,6 +2129,165 @@ TEST(CheckCachedDataInternalExternalUncachedStringTwoByte) {
   }
 }
 
+#ifdef V8_USE_ZLIB
+UNINITIALIZED_TEST(CompressColdScriptSources) {
+  v8_flags.compress_cold_strings = true;
+  v8_flags.cold_string_compression_min_length = 1024;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  ColdStringCompressor* compressor =
+      i_isolate->heap()->cold_string_compressor();
+  CHECK_NOT_NULL(compressor);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    LocalContext context(isolate);
+    v8::HandleScope scope(isolate);
+
+    // The inner functions are compiled lazily from the compressed sources.
+    const char* kComments[] = {"// one-byte", "// two-byte \u1234"};
+    std::string expected[2];
+    Handle<Script> scripts[2];
+    for (int i = 0; i < 2; ++i) {
+      std::string comment = kComments[i];
+      std::string body = "function f" + std::to_string(i) +
+                         "() { return 'abc' + " + std::to_string(i) + "; }\n";
+      std::string source = body;
+      for (int j = 0; j < 200; ++j) source += comment + "\n";
+      expected[i] = body.substr(0, body.size() - 1);
+      CompileRun(source.c_str());
+      std::string name = "f" + std::to_string(i);
+      Handle<JSFunction> function = Handle<JSFunction>::cast(
+          v8::Utils::OpenHandle(*CompileRun(name.c_str())));
+      scripts[i] =
+          handle(Script::cast(function->shared()->script()), i_isolate);
+    }
+    heap::InvokeMajorGC(i_isolate->heap());
+    heap::InvokeMajorGC(i_isolate->heap());
+
+    compressor->CompressColdStrings(
+        ColdStringCompressor::ReleaseUncompressed::kNo);
+    CHECK_LE(2u, compressor->number_of_compressed_strings());
+    for (int i = 0; i < 2; ++i) {
+      Tagged<Object> source = scripts[i]->source();
+      CHECK(IsExternalString(source));
+      CHECK(ExternalString::cast(source)->is_uncached());
+      CHECK_EQ(i == 0, IsExternalOneByteString(source));
+    }
+
+    for (int round = 0; round < 3; ++round) {
+      for (int i = 0; i < 2; ++i) {
+        std::string index = std::to_string(i);
+        CHECK(CompileRun(("f" + index + "()").c_str())
+                  ->StrictEquals(v8_str(("abc" + index).c_str())));
+        CHECK(CompileRun(("f" + index + ".toString()").c_str())
+                  ->StrictEquals(v8_str(expected[i].c_str())));
+      }
+      // The first pass only clears the access bits, the second one releases
+      // the uncompressed characters, which are decompressed again above.
+      compressor->CompressColdStrings(
+          ColdStringCompressor::ReleaseUncompressed::kYes);
+      compressor->CompressColdStrings(
+          ColdStringCompressor::ReleaseUncompressed::kYes);
+    }
+    CHECK_LE(2u, compressor->number_of_compressed_strings());
+  }
+  isolate->Dispose();
+}
+
+namespace {
+
+Handle<Script> ScriptOfFunction(Isolate* isolate, const char* name) {
+  Handle<JSFunction> function =
+      Handle<JSFunction>::cast(v8::Utils::OpenHandle(*CompileRun(name)));
+  return handle(Script::cast(function->shared()->script()), isolate);
+}
+
+}  // namespace
+
+UNINITIALIZED_TEST(CompressColdScriptSourcesSelectively) {
+  v8_flags.compress_cold_strings = true;
+  v8_flags.cold_string_compression_min_length = 1024;
+  v8_flags.cold_string_compression_max_pass_size_kb = 4;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  ColdStringCompressor* compressor =
+      i_isolate->heap()->cold_string_compressor();
+  CHECK_NOT_NULL(compressor);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    LocalContext context(isolate);
+    v8::HandleScope scope(isolate);
+
+    // Three compressible sources of 3 KB each, only one of which fits into
+    // the work limit of a pass.
+    constexpr int kCompressible = 3;
+    Handle<Script> compressible[kCompressible];
+    for (int i = 0; i < kCompressible; ++i) {
+      std::string name = "f" + std::to_string(i);
+      std::string source = "function " + name + "() {}\n";
+      while (source.size() < 3 * KB) source += "// compressible\n";
+      CompileRun(source.c_str());
+      compressible[i] = ScriptOfFunction(i_isolate, name.c_str());
+    }
+
+    // Random printable characters don't compress well enough.
+    std::string random_source = "function g() {}\n//";
+    uint32_t seed = 17;
+    while (random_source.size() < 2 * KB) {
+      seed = seed * 1103515245 + 12345;
+      random_source += static_cast<char>(' ' + (seed >> 16) % 95);
+    }
+    CompileRun(random_source.c_str());
+    Handle<Script> incompressible = ScriptOfFunction(i_isolate, "g");
+
+    // Sources of eval are not compressed.
+    CompileRun(
+        "eval('function h() {}\\n' + '// not compressed\\n'.repeat(200));");
+    Handle<Script> eval_script = ScriptOfFunction(i_isolate, "h");
+    CHECK_EQ(Script::CompilationType::kEval,
+             eval_script->compilation_type());
+    CHECK(IsSeqString(eval_script->source()));
+
+    heap::InvokeMajorGC(i_isolate->heap());
+    heap::InvokeMajorGC(i_isolate->heap());
+
+    auto count_compressed = [&]() {
+      int count = 0;
+      for (int i = 0; i < kCompressible; ++i) {
+        if (IsExternalString(compressible[i]->source())) count++;
+      }
+      return count;
+    };
+    compressor->CompressColdStrings(
+        ColdStringCompressor::ReleaseUncompressed::kNo);
+    CHECK_GE(1, count_compressed());
+    for (int pass = 0; pass < 10; ++pass) {
+      compressor->CompressColdStrings(
+          ColdStringCompressor::ReleaseUncompressed::kNo);
+    }
+    CHECK_EQ(kCompressible, count_compressed());
+    CHECK(IsSeqString(incompressible->source()));
+    CHECK(IsSeqString(eval_script->source()));
+    CHECK_LE(1u, compressor->number_of_incompressible_sources());
+
+    // The incompressible source is remembered across passes, and no longer
+    // counts towards the work limit.
+    size_t incompressible_sources =
+        compressor->number_of_incompressible_sources();
+    compressor->CompressColdStrings(
+        ColdStringCompressor::ReleaseUncompressed::kNo);
+    CHECK_EQ(incompressible_sources,
+             compressor->number_of_incompressible_sources());
+    CHECK(IsSeqString(incompressible->source()));
+  }
+  isolate->Dispose();
+}
+#endif  // V8_USE_ZLIB
+
 }  // namespace test_strings
 }  // namespace internal
 }  // namespace v8
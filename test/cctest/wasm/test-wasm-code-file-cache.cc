@@ -0,0 +1,162 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdio.h>
+
+#include <string>
+
+#include "src/base/platform/platform.h"
+#include "src/objects/objects-inl.h"
+#include "src/wasm/code-file-cache.h"
+#include "src/wasm/wasm-engine.h"
+#include "src/wasm/wasm-module-builder.h"
+#include "src/wasm/wasm-objects-inl.h"
+#include "test/cctest/cctest.h"
+#include "test/common/wasm/flag-utils.h"
+#include "test/common/wasm/test-signatures.h"
+#include "test/common/wasm/wasm-macro-gen.h"
+#include "test/common/wasm/wasm-module-runner.h"
+
+namespace v8::internal::wasm {
+
+namespace {
+
+constexpr const char* kFunctionName = "increment";
+
+class CodeFileCacheTest {
+ public:
+  CodeFileCacheTest()
+      : zone_(&allocator_, ZONE_NAME),
+        wire_bytes_buffer_(&zone_),
+        isolate_(CcTest::i_isolate()),
+        enabled_features_(WasmFeatures::FromIsolate(isolate_)) {
+    WasmModuleBuilder* builder = zone_.New<WasmModuleBuilder>(&zone_);
+    TestSignatures sigs;
+    WasmFunctionBuilder* f = builder->AddFunction(sigs.i_i());
+    uint8_t code[] = {WASM_LOCAL_GET(0), kExprI32Const, 1, kExprI32Add,
+                      kExprEnd};
+    f->EmitCode(code, sizeof(code));
+    builder->AddExport(base::CStrVector(kFunctionName), f);
+    builder->WriteTo(&wire_bytes_buffer_);
+    filename_ =
+        GetCodeFileCacheFileNameForTesting(wire_bytes(), enabled_features_);
+    base::OS::Remove(filename_.c_str());
+  }
+
+  ~CodeFileCacheTest() { base::OS::Remove(filename_.c_str()); }
+
+  base::Vector<const uint8_t> wire_bytes() const {
+    return base::VectorOf(wire_bytes_buffer_.begin(),
+                          wire_bytes_buffer_.size());
+  }
+
+  Handle<WasmModuleObject> Compile() {
+    ErrorThrower thrower(isolate_, "CodeFileCacheTest");
+    return GetWasmEngine()
+        ->SyncCompile(isolate_, enabled_features_, &thrower,
+                      ModuleWireBytes(wire_bytes()))
+        .ToHandleChecked();
+  }
+
+  MaybeHandle<WasmModuleObject> Load(WasmFeatures enabled_features) {
+    return LoadModuleFromCodeFileCache(isolate_, enabled_features,
+                                       wire_bytes());
+  }
+
+  bool FileExists() {
+    FILE* file = base::OS::FOpen(filename_.c_str(), "rb");
+    if (!file) return false;
+    base::Fclose(file);
+    return true;
+  }
+
+  void CorruptLastByteOfFile() {
+    FILE* file = base::OS::FOpen(filename_.c_str(), "r+b");
+    CHECK_NOT_NULL(file);
+    CHECK_EQ(0, fseek(file, -1, SEEK_END));
+    int value = fgetc(file);
+    CHECK_NE(EOF, value);
+    CHECK_EQ(0, fseek(file, -1, SEEK_END));
+    CHECK_NE(EOF, fputc(value ^ 0xff, file));
+    base::Fclose(file);
+  }
+
+  void Run(Handle<WasmModuleObject> module_object) {
+    ErrorThrower thrower(isolate_, "CodeFileCacheTest");
+    Handle<WasmInstanceObject> instance =
+        GetWasmEngine()
+            ->SyncInstantiate(isolate_, &thrower, module_object, {}, {})
+            .ToHandleChecked();
+    Handle<Object> params[1] = {handle(Smi::FromInt(41), isolate_)};
+    CHECK_EQ(42, testing::CallWasmFunctionForTesting(
+                     isolate_, instance, kFunctionName,
+                     base::ArrayVector(params)));
+  }
+
+  WasmFeatures enabled_features() const { return enabled_features_; }
+
+ private:
+  // Compile with TurboFan only, such that the module is stored as soon as
+  // synchronous compilation finished.
+  FlagScope<const char*> cache_dir_{&v8_flags.wasm_code_cache_dir, "."};
+  FlagScope<bool> no_liftoff_{&v8_flags.liftoff, false};
+  FlagScope<bool> no_dynamic_tiering_{&v8_flags.wasm_dynamic_tiering, false};
+  FlagScope<bool> no_lazy_compilation_{&v8_flags.wasm_lazy_compilation,
+                                       false};
+  AccountingAllocator allocator_;
+  Zone zone_;
+  ZoneBuffer wire_bytes_buffer_;
+  Isolate* const isolate_;
+  const WasmFeatures enabled_features_;
+  std::string filename_;
+};
+
+}  // namespace
+
+TEST(CodeFileCacheMissAndHit) {
+  CcTest::InitIsolateOnce();
+  HandleScope scope(CcTest::i_isolate());
+  testing::SetupIsolateForWasmModule(CcTest::i_isolate());
+  CodeFileCacheTest test;
+  CHECK(test.Load(test.enabled_features()).is_null());
+
+  test.Run(test.Compile());
+  CHECK(test.FileExists());
+
+  Handle<WasmModuleObject> cached_module;
+  CHECK(test.Load(test.enabled_features()).ToHandle(&cached_module));
+  test.Run(cached_module);
+}
+
+TEST(CodeFileCacheFeatureMismatch) {
+  CcTest::InitIsolateOnce();
+  HandleScope scope(CcTest::i_isolate());
+  testing::SetupIsolateForWasmModule(CcTest::i_isolate());
+  CodeFileCacheTest test;
+  test.Compile();
+  CHECK(test.FileExists());
+
+  WasmFeatures other_features = test.enabled_features();
+  if (other_features.contains(kFeature_stringref)) {
+    other_features.Remove(kFeature_stringref);
+  } else {
+    other_features.Add(kFeature_stringref);
+  }
+  CHECK(test.Load(other_features).is_null());
+  CHECK(!test.Load(test.enabled_features()).is_null());
+}
+
+TEST(CodeFileCacheCorruptFile) {
+  CcTest::InitIsolateOnce();
+  HandleScope scope(CcTest::i_isolate());
+  testing::SetupIsolateForWasmModule(CcTest::i_isolate());
+  CodeFileCacheTest test;
+  test.Compile();
+  CHECK(test.FileExists());
+
+  test.CorruptLastByteOfFile();
+  CHECK(test.Load(test.enabled_features()).is_null());
+}
+
+}  // namespace v8::internal::wasm
@@ -2,16 +2,21 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "src/api/api-inl.h"
 #include "src/compiler/wasm-compiler.h"
 #include "src/wasm/function-compiler.h"
 #include "src/wasm/module-compiler.h"
 #include "src/wasm/wasm-code-manager.h"
 #include "src/wasm/wasm-engine.h"
 #include "src/wasm/wasm-import-wrapper-cache.h"
+#include "src/wasm/wasm-module-builder.h"
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-objects.h"
 #include "test/cctest/cctest.h"
+#include "test/common/flag-utils.h"
 #include "test/common/wasm/test-signatures.h"
+#include "test/common/wasm/wasm-macro-gen.h"
+#include "test/common/wasm/wasm-module-runner.h"
 
 namespace v8 {
 namespace internal {
@@ -163,6 +168,94 @@ TEST(CacheHitMissSig) {
   CHECK_EQ(c2, c4);
 }
 
+// Compiles a module which imports "m.f" with signature {sig} and exports a
+// function {name} which forwards its two parameters to the import.
+Handle<WasmModuleObject> CompileModuleWithImport(Isolate* isolate,
+                                                 FunctionSig* sig,
+                                                 const char* name) {
+  AccountingAllocator allocator;
+  Zone zone(&allocator, ZONE_NAME);
+  WasmModuleBuilder* builder = zone.New<WasmModuleBuilder>(&zone);
+  uint32_t import =
+      builder->AddImport(base::CStrVector("f"), sig, base::CStrVector("m"));
+  WasmFunctionBuilder* f = builder->AddFunction(sig);
+  uint8_t code[] = {
+      WASM_CALL_FUNCTION(import, WASM_LOCAL_GET(0), WASM_LOCAL_GET(1)),
+      kExprEnd};
+  f->EmitCode(code, sizeof(code));
+  builder->AddExport(base::CStrVector(name), f);
+  ZoneBuffer buffer(&zone);
+  builder->WriteTo(&buffer);
+  ErrorThrower thrower(isolate, "CompileModuleWithImport");
+  return testing::CompileForTesting(
+             isolate, &thrower, ModuleWireBytes(buffer.begin(), buffer.end()))
+      .ToHandleChecked();
+}
+
+// Import wrappers which are compiled in the background during module
+// compilation go to the shared cache, and later modules copy them from there.
+TEST(SharedCacheModuleCompilation) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+  testing::SetupIsolateForWasmModule(isolate);
+  TestSignatures sigs;
+  FunctionSig* sig = sigs.i_ii();
+  if (UseGenericWasmToJSWrapper(kDefaultImportCallKind, sig, kNoSuspend)) {
+    return;
+  }
+  FlagScope<bool> shared_wrappers(&v8_flags.wasm_shared_import_wrappers,
+                                  true);
+  SharedImportWrapperCache* shared_cache =
+      GetWasmEngine()->shared_import_wrapper_cache();
+
+  // Different export names keep the native module cache from returning the
+  // first module again.
+  Handle<WasmModuleObject> first = CompileModuleWithImport(isolate, sig, "a");
+  NativeModule* first_module = first->native_module();
+  uint32_t canonical_type_index =
+      first_module->module()->isorecursive_canonical_type_ids
+          [first_module->module()->functions[0].sig_index];
+  int expected_arity = static_cast<int>(sig->parameter_count());
+  SharedImportWrapperCache::Key key{
+      {kDefaultImportCallKind, canonical_type_index, expected_arity,
+       kNoSuspend},
+      first_module->enabled_features(),
+      false};
+  std::shared_ptr<const WasmCompilationResult> shared_result =
+      shared_cache->MaybeGet(key);
+  CHECK_NOT_NULL(shared_result);
+  WasmCode* first_wrapper = first_module->import_wrapper_cache()->MaybeGet(
+      kDefaultImportCallKind, canonical_type_index, expected_arity,
+      kNoSuspend);
+  CHECK_NOT_NULL(first_wrapper);
+
+  Handle<WasmModuleObject> second = CompileModuleWithImport(isolate, sig, "b");
+  NativeModule* second_module = second->native_module();
+  CHECK_NE(first_module, second_module);
+  WasmCode* second_wrapper = second_module->import_wrapper_cache()->MaybeGet(
+      kDefaultImportCallKind, canonical_type_index, expected_arity,
+      kNoSuspend);
+  CHECK_NOT_NULL(second_wrapper);
+  CHECK_NE(first_wrapper, second_wrapper);
+  CHECK_EQ(first_wrapper->instructions().size(),
+           second_wrapper->instructions().size());
+  CHECK_EQ(shared_result.get(), shared_cache->MaybeGet(key).get());
+
+  // The copied wrapper calls into JS through the second module's stubs.
+  Handle<JSReceiver> imports = Handle<JSReceiver>::cast(v8::Utils::OpenHandle(
+      *CompileRun("({m: {f: (a, b) => a - b}})")));
+  ErrorThrower thrower(isolate, "SharedCacheModuleCompilation");
+  Handle<WasmInstanceObject> instance =
+      GetWasmEngine()
+          ->SyncInstantiate(isolate, &thrower, second, imports, {})
+          .ToHandleChecked();
+  Handle<Object> args[] = {handle(Smi::FromInt(7), isolate),
+                           handle(Smi::FromInt(3), isolate)};
+  CHECK_EQ(4, testing::CallWasmFunctionForTesting(isolate, instance, "b",
+                                                  base::ArrayVector(args)));
+}
+
 }  // namespace test_wasm_import_wrapper_cache
 }  // namespace wasm
 }  // namespace internal
@@ -7,10 +7,13 @@
 
 #include "include/v8-wasm.h"
 #include "src/api/api-inl.h"
+#include "src/codegen/reloc-info.h"
 #include "src/objects/objects-inl.h"
 #include "src/snapshot/code-serializer.h"
 #include "src/utils/version.h"
 #include "src/wasm/module-decoder.h"
+#include "src/wasm/wasm-builtin-list.h"
+#include "src/wasm/wasm-code-manager.h"
 #include "src/wasm/wasm-engine.h"
 #include "src/wasm/wasm-module-builder.h"
 #include "src/wasm/wasm-module.h"
@@ -26,12 +29,28 @@
 
 namespace v8::internal::wasm {
 
+// The location of a serialized relocation patch, see {RelocationPatch} in
+// wasm-serialization.cc.
+struct SerializedPatch {
+  uint8_t* pc_offset() const { return location; }
+  uint8_t* mode() const { return location + sizeof(uint32_t); }
+  uint8_t* tag() const { return location + 2 * sizeof(uint32_t); }
+
+  uint8_t* location;
+  // Size of the instructions of the patched function.
+  uint32_t code_size;
+};
+
 // Approximate gtest TEST_F style, in case we adopt gtest.
 class WasmSerializationTest {
  public:
-  WasmSerializationTest() : zone_(&allocator_, ZONE_NAME) {
+  using BuildWireBytesCallback = void (*)(Zone*, ZoneBuffer*);
+
+  explicit WasmSerializationTest(
+      BuildWireBytesCallback build_wire_bytes = BuildWireBytes)
+      : zone_(&allocator_, ZONE_NAME) {
     // Don't call here if we move to gtest.
-    SetUp();
+    SetUp(build_wire_bytes);
   }
 
   static constexpr const char* kFunctionName = "increment";
@@ -53,6 +72,62 @@ class WasmSerializationTest {
     builder->WriteTo(buffer);
   }
 
+  // Generates an "increment" function whose code needs every kind of
+  // relocation: it calls another function, divides (calling trap stubs), fills
+  // memory (calling a C function through an external reference), and
+  // dispatches over a br_table (a jump table of internal references on some
+  // architectures). The memory stays zero, so that the result is still x + 1.
+  static void BuildWireBytesWithRelocations(Zone* zone, ZoneBuffer* buffer) {
+    WasmModuleBuilder* builder = zone->New<WasmModuleBuilder>(zone);
+    TestSignatures sigs;
+
+    WasmFunctionBuilder* add_one = builder->AddFunction(sigs.i_i());
+    uint8_t add_one_code[] = {WASM_I32_ADD(WASM_LOCAL_GET(0), WASM_ONE),
+                              kExprEnd};
+    add_one->EmitCode(add_one_code, sizeof(add_one_code));
+
+    WasmFunctionBuilder* f = builder->AddFunction(sigs.i_i());
+    // Each case of the br_table stores to a different address, so that the
+    // cases can't be merged.
+    constexpr int kCases = 8;
+    std::vector<uint8_t> code;
+    for (int i = 0; i <= kCases; ++i) {
+      code.insert(code.end(), {kExprBlock, kVoidCode});
+    }
+    code.insert(code.end(),
+                {WASM_I32_AND(WASM_LOCAL_GET(0), WASM_I32V_1(kCases - 1)),
+                 kExprBrTable, U32V_1(kCases - 1)});
+    for (int i = 0; i < kCases; ++i) code.push_back(static_cast<uint8_t>(i));
+    for (int i = 0; i < kCases; ++i) {
+      code.insert(code.end(),
+                  {kExprEnd, WASM_STORE_MEM(MachineType::Int32(),
+                                            WASM_I32V_1(4 * i), WASM_ZERO)});
+      // Continue after the outermost block.
+      if (i < kCases - 1) {
+        code.insert(code.end(),
+                    {kExprBr, static_cast<uint8_t>(kCases - 1 - i)});
+      }
+    }
+    code.push_back(kExprEnd);
+    // The size is not a constant, such that the fill is not inlined.
+    code.insert(code.end(),
+                {WASM_MEMORY_FILL(
+                    WASM_ZERO, WASM_ZERO,
+                    WASM_LOAD_MEM(MachineType::Int32(), WASM_I32V_1(64)))});
+    code.insert(code.end(),
+                {WASM_I32_DIVS(
+                     WASM_CALL_FUNCTION(add_one->func_index(),
+                                        WASM_LOCAL_GET(0)),
+                     WASM_I32_ADD(WASM_LOAD_MEM(MachineType::Int32(),
+                                                WASM_I32V_1(64)),
+                                  WASM_ONE)),
+                 kExprEnd});
+    f->EmitCode(code.data(), static_cast<uint32_t>(code.size()));
+    builder->AddExport(base::CStrVector(kFunctionName), f);
+
+    builder->WriteTo(buffer);
+  }
+
   void ClearSerializedData() { serialized_bytes_ = {}; }
 
   void InvalidateVersion() {
@@ -71,6 +146,45 @@ class WasmSerializationTest {
                          serialized_bytes_.size() - 1};
   }
 
+  // Returns the relocation patches of all functions with TurboFan code in the
+  // serialized data. This follows the layout written by the
+  // {NativeModuleSerializer}.
+  std::vector<SerializedPatch> FindPatches() {
+    // See {kTurboFanFunction} in wasm-serialization.cc.
+    constexpr uint8_t kTurboFanFunction = 4;
+    uint8_t* data = const_cast<uint8_t*>(serialized_bytes_.data());
+    // Skip the total code size and whether all functions are validated. The
+    // module has no imports, hence no import statuses.
+    size_t offset = WasmSerializer::kHeaderSize + sizeof(size_t) + sizeof(bool);
+    auto read_int = [&]() {
+      int value = ReadUnalignedValue<int>(reinterpret_cast<Address>(data) +
+                                          offset);
+      offset += sizeof(int);
+      return value;
+    };
+    std::vector<SerializedPatch> patches;
+    for (uint32_t i = 0; i < num_declared_functions_; ++i) {
+      if (data[offset++] != kTurboFanFunction) continue;
+      // Constant pool, safepoint table, handler table and code comments
+      // offsets, unpadded binary size, stack slots, tagged parameter slots.
+      offset += 7 * sizeof(int);
+      int code_size = read_int();
+      int metadata_size = read_int();  // Reloc info.
+      metadata_size += read_int();     // Source positions.
+      metadata_size += read_int();     // Inlining positions.
+      metadata_size += read_int();     // Protected instructions.
+      offset += sizeof(WasmCode::Kind) + sizeof(ExecutionTier);
+      uint32_t num_patches = static_cast<uint32_t>(read_int());
+      offset += metadata_size;
+      for (uint32_t j = 0; j < num_patches; ++j) {
+        patches.push_back({data + offset, static_cast<uint32_t>(code_size)});
+        offset += 3 * sizeof(uint32_t);
+      }
+    }
+    CHECK_LE(offset, serialized_bytes_.size());
+    return patches;
+  }
+
   MaybeHandle<WasmModuleObject> Deserialize(
       base::Vector<const char> source_url = {}) {
     return DeserializeNativeModule(CcTest::i_isolate(),
@@ -115,10 +229,10 @@ class WasmSerializationTest {
  private:
   Zone* zone() { return &zone_; }
 
-  void SetUp() {
+  void SetUp(BuildWireBytesCallback build_wire_bytes) {
     CcTest::InitIsolateOnce();
     ZoneBuffer buffer(&zone_);
-    WasmSerializationTest::BuildWireBytes(zone(), &buffer);
+    build_wire_bytes(zone(), &buffer);
 
     v8::Isolate::CreateParams create_params;
     create_params.array_buffer_allocator =
@@ -148,6 +262,8 @@ class WasmSerializationTest {
       weak_native_module = module_object->shared_native_module();
       // Check that the native module exists at this point.
       CHECK(weak_native_module.lock());
+      num_declared_functions_ =
+          module_object->module()->num_declared_functions;
 
       v8::Local<v8::Object> v8_module_obj =
           v8::Utils::ToLocal(Handle<JSObject>::cast(module_object));
@@ -202,6 +318,7 @@ class WasmSerializationTest {
   v8::OwnedBuffer data_;
   v8::MemorySpan<const uint8_t> wire_bytes_ = {nullptr, 0};
   v8::MemorySpan<const uint8_t> serialized_bytes_ = {nullptr, 0};
+  uint32_t num_declared_functions_ = 0;
   FlagScope<int> tier_up_quickly_{&v8_flags.wasm_tiering_budget, 1000};
 };
 
@@ -426,6 +543,118 @@ TEST(SerializeTieringBudget) {
   }
 }
 
+TEST(DeserializeAllRelocationModes) {
+  // Compile all functions with TurboFan right away.
+  FlagScope<bool> no_liftoff(&v8_flags.liftoff, false);
+  WasmSerializationTest test(
+      WasmSerializationTest::BuildWireBytesWithRelocations);
+  Isolate* isolate = CcTest::i_isolate();
+  {
+    HandleScope scope(isolate);
+    Handle<WasmModuleObject> module_object;
+    CHECK(test.Deserialize().ToHandle(&module_object));
+    NativeModule* native_module = module_object->native_module();
+    WasmCodeRefScope code_ref_scope;
+    WasmCode* code = native_module->GetCode(1);
+    CHECK_NOT_NULL(code);
+    CHECK_EQ(ExecutionTier::kTurbofan, code->tier());
+
+    // Check that each relocated target points to what the original code
+    // referred to.
+    constexpr int kModeMask =
+        RelocInfo::ModeMask(RelocInfo::WASM_CALL) |
+        RelocInfo::ModeMask(RelocInfo::WASM_STUB_CALL) |
+        RelocInfo::ModeMask(RelocInfo::EXTERNAL_REFERENCE) |
+        RelocInfo::ModeMask(RelocInfo::INTERNAL_REFERENCE) |
+        RelocInfo::ModeMask(RelocInfo::INTERNAL_REFERENCE_ENCODED);
+    int seen_modes = 0;
+    bool calls_memory_fill = false;
+    for (RelocIterator it(code->instructions(), code->reloc_info(),
+                          code->constant_pool(), kModeMask);
+         !it.done(); it.next()) {
+      RelocInfo::Mode mode = it.rinfo()->rmode();
+      seen_modes |= RelocInfo::ModeMask(mode);
+      switch (mode) {
+        case RelocInfo::WASM_CALL:
+          CHECK_EQ(0, native_module->GetFunctionIndexFromJumpTableSlot(
+                          it.rinfo()->wasm_call_address()));
+          break;
+        case RelocInfo::WASM_STUB_CALL:
+          CHECK(BuiltinLookup::IsWasmBuiltinId(
+              native_module->GetBuiltinInJumptableSlot(
+                  it.rinfo()->wasm_stub_call_address())));
+          break;
+        case RelocInfo::EXTERNAL_REFERENCE:
+          if (it.rinfo()->target_external_reference() ==
+              ExternalReference::wasm_memory_fill().address()) {
+            calls_memory_fill = true;
+          }
+          break;
+        case RelocInfo::INTERNAL_REFERENCE:
+        case RelocInfo::INTERNAL_REFERENCE_ENCODED:
+          CHECK(code->contains(it.rinfo()->target_internal_reference()));
+          break;
+        default:
+          UNREACHABLE();
+      }
+    }
+    CHECK_NE(0, seen_modes & RelocInfo::ModeMask(RelocInfo::WASM_CALL));
+    CHECK_NE(0, seen_modes & RelocInfo::ModeMask(RelocInfo::WASM_STUB_CALL));
+    CHECK(calls_memory_fill);
+#if V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_IA32
+    // The br_table is compiled to a jump table of absolute addresses.
+    CHECK_NE(0,
+             seen_modes & RelocInfo::ModeMask(RelocInfo::INTERNAL_REFERENCE));
+#endif
+
+    // Run all cases of the br_table.
+    ErrorThrower thrower(isolate, "");
+    Handle<WasmInstanceObject> instance =
+        GetWasmEngine()
+            ->SyncInstantiate(isolate, &thrower, module_object, {}, {})
+            .ToHandleChecked();
+    for (int i = 0; i < 8; ++i) {
+      Handle<Object> params[1] = {handle(Smi::FromInt(i), isolate)};
+      CHECK_EQ(i + 1,
+               testing::CallWasmFunctionForTesting(
+                   isolate, instance, WasmSerializationTest::kFunctionName,
+                   base::ArrayVector(params)));
+    }
+  }
+  test.CollectGarbage();
+}
+
+TEST(DeserializeCorruptedRelocationPatches) {
+  FlagScope<bool> no_liftoff(&v8_flags.liftoff, false);
+  WasmSerializationTest test(
+      WasmSerializationTest::BuildWireBytesWithRelocations);
+  {
+    HandleScope scope(CcTest::i_isolate());
+    std::vector<SerializedPatch> patches = test.FindPatches();
+    CHECK(!patches.empty());
+    // Deserialization fails gracefully if any single field of any patch is
+    // out of range, and the module would have to be compiled instead.
+    auto check_rejected = [&test](uint8_t* field, uint32_t value) {
+      Address address = reinterpret_cast<Address>(field);
+      uint32_t original = ReadUnalignedValue<uint32_t>(address);
+      WriteUnalignedValue<uint32_t>(address, value);
+      CHECK(test.Deserialize().is_null());
+      WriteUnalignedValue<uint32_t>(address, original);
+    };
+    for (const SerializedPatch& patch : patches) {
+      check_rejected(patch.mode(), RelocInfo::NUMBER_OF_MODES);
+      check_rejected(patch.mode(), RelocInfo::FULL_EMBEDDED_OBJECT);
+      check_rejected(patch.tag(), kMaxUInt32);
+      check_rejected(patch.pc_offset(), patch.code_size);
+      check_rejected(patch.pc_offset(), patch.code_size - 1);
+      check_rejected(patch.pc_offset(), kMaxUInt32);
+    }
+    // The unmodified data still deserializes.
+    test.DeserializeAndRun();
+  }
+  test.CollectGarbage();
+}
+
 TEST(DeserializeTieringBudgetPartlyMissing) {
   WasmSerializationTest test;
   {
@@ -0,0 +1,124 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "src/base/platform/platform.h"
+#include "src/wasm/memory-tracing.h"
+#include "src/wasm/wasm-opcodes-inl.h"
+#include "test/cctest/cctest.h"
+#include "test/cctest/wasm/wasm-run-utils.h"
+#include "test/common/flag-utils.h"
+#include "test/common/wasm/wasm-macro-gen.h"
+
+namespace v8::internal::wasm {
+
+namespace {
+
+// Points --wasm-trace-file to a file of this process, and reads the records
+// back from it. The trace file is opened on the first flush and stays open, so
+// each test must run in its own process.
+class WasmTraceFileScope {
+ public:
+  WasmTraceFileScope()
+      : path_("wasm-trace-test-" +
+              std::to_string(base::OS::GetCurrentProcessId()) + ".bin"),
+        trace_file_(&v8_flags.wasm_trace_file, path_.c_str()) {}
+
+  ~WasmTraceFileScope() { base::OS::Remove(path_.c_str()); }
+
+  std::vector<WasmTraceRecord> Read() {
+    CHECK(FlushWasmTraceBuffers());
+    std::vector<WasmTraceRecord> records;
+    FILE* file = base::OS::FOpen(path_.c_str(), "rb");
+    CHECK_NOT_NULL(file);
+    WasmTraceChunkHeader header;
+    while (fread(&header, sizeof(header), 1, file) == 1) {
+      CHECK_EQ(kWasmTraceMagic, header.magic);
+      CHECK_EQ(kWasmTraceVersion, header.version);
+      size_t first = records.size();
+      records.resize(first + header.record_count);
+      CHECK_EQ(header.record_count, fread(&records[first], sizeof(records[0]),
+                                          header.record_count, file));
+    }
+    base::Fclose(file);
+    return records;
+  }
+
+ private:
+  const std::string path_;
+  FlagScope<const char*> trace_file_;
+};
+
+std::vector<WasmTraceRecord> RecordsOfKind(
+    const std::vector<WasmTraceRecord>& records, WasmTraceRecordKind kind,
+    uint32_t func_index) {
+  std::vector<WasmTraceRecord> result;
+  for (const WasmTraceRecord& record : records) {
+    if (record.kind != kind) continue;
+    if (record.func_index != static_cast<int32_t>(func_index)) continue;
+    result.push_back(record);
+  }
+  return result;
+}
+
+}  // namespace
+
+WASM_COMPILED_EXEC_TEST(TraceFileMemoryAccesses) {
+  WasmTraceFileScope trace_file;
+  FlagScope<bool> trace_memory(&v8_flags.trace_wasm_memory, true);
+  WasmRunner<int32_t, int32_t> r(execution_tier);
+  r.builder().AddMemoryElems<int32_t>(kWasmPageSize / sizeof(int32_t));
+  r.Build({WASM_STORE_MEM(MachineType::Int32(), WASM_LOCAL_GET(0),
+                          WASM_I32V_1(7)),
+           WASM_LOAD_MEM(MachineType::Int32(), WASM_LOCAL_GET(0))});
+
+  const int32_t offsets[] = {0, 8, 4096};
+  for (int32_t offset : offsets) CHECK_EQ(7, r.Call(offset));
+
+  std::vector<WasmTraceRecord> accesses =
+      RecordsOfKind(trace_file.Read(), WasmTraceRecordKind::kMemoryAccess,
+                    r.function_index());
+  CHECK_EQ(2 * arraysize(offsets), accesses.size());
+  for (size_t i = 0; i < accesses.size(); ++i) {
+    const WasmTraceRecord& access = accesses[i];
+    CHECK_EQ(static_cast<uint8_t>(execution_tier), access.tier);
+    CHECK_EQ(static_cast<uint8_t>(MachineRepresentation::kWord32),
+             access.mem_rep);
+    // The store comes before the load.
+    CHECK_EQ(i % 2 == 0 ? 1 : 0, access.is_store);
+    CHECK_EQ(static_cast<uint64_t>(offsets[i / 2]), access.offset);
+    CHECK_LT(0, access.position);
+  }
+}
+
+TEST(TraceFileLoopIterations) {
+  WasmTraceFileScope trace_file;
+  FlagScope<bool> trace_loops(&v8_flags.wasm_trace_loops, true);
+  WasmRunner<int32_t, int32_t> r(TestExecutionTier::kLiftoff);
+  r.Build({WASM_LOOP(WASM_IF(WASM_LOCAL_GET(0),
+                             WASM_LOCAL_SET(0, WASM_I32_SUB(WASM_LOCAL_GET(0),
+                                                            WASM_I32V_1(1))),
+                             WASM_BR(1))),
+           WASM_LOCAL_GET(0)});
+  CHECK_EQ(0, r.Call(3));
+  CHECK_EQ(0, r.Call(5));
+
+  std::vector<WasmTraceRecord> records = trace_file.Read();
+  std::vector<WasmTraceRecord> entries = RecordsOfKind(
+      records, WasmTraceRecordKind::kLoopEntry, r.function_index());
+  std::vector<WasmTraceRecord> iterations = RecordsOfKind(
+      records, WasmTraceRecordKind::kLoopIteration, r.function_index());
+  CHECK_EQ(size_t{2}, entries.size());
+  // The loop header runs once more than the loop body, for the exit check.
+  CHECK_EQ(size_t{4 + 6}, iterations.size());
+  for (const WasmTraceRecord& record : iterations) {
+    CHECK_EQ(entries[0].position, record.position);
+    CHECK_EQ(static_cast<uint8_t>(ExecutionTier::kLiftoff), record.tier);
+  }
+}
+
+}  // namespace v8::internal::wasm
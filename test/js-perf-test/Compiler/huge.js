@@ -0,0 +1,68 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Very large generated functions, for which most of the TurboFan time is
+// spent in the back-end (instruction selection and register allocation).
+// Run d8 with --turbo-stats to get the per-phase breakdown.
+
+(() => {
+
+  let a = 19, b = 3;
+  let heap = new Int32Array(256);
+
+  // A minified-style switch dispatch function, similar to the state machines
+  // emitted by transpilers and bundlers.
+  const kCases = 1000;
+  let switch_body = 'let r = 0; switch (op) {';
+  for (let i = 0; i < kCases; ++i) {
+    switch_body += `case ${i}: r = (a * ${i % 13 + 1} + b) ^ ${i};` +
+                   ` a = r & 0xffff; break;`;
+  }
+  switch_body += 'default: r = -1; } return r;';
+  const dispatch = new Function('op', 'a', 'b', switch_body);
+
+  // An asm.js-style straight-line kernel with lots of live values. Its
+  // bytecode has to stay below --max-optimized-bytecode-size, otherwise
+  // TurboFan bails out right away.
+  const kStatements = 1200;
+  let kernel_body = 'let x = 0, y = 1;';
+  for (let i = 0; i < kStatements; ++i) {
+    kernel_body += `x = (x + (heap[${i % 256}] | 0) * ${i % 7 + 1}) | 0;` +
+                   ` y = (y ^ x) | 0; heap[${(i * 7) % 256}] = y;`;
+  }
+  kernel_body += 'return (x + y) | 0;';
+  const kernel = new Function('heap', kernel_body);
+
+  // Initializing feedback for each function
+  %PrepareFunctionForOptimization(dispatch);
+  for (let op = 0; op <= kCases; ++op) {
+    dispatch(op, a, b);
+  }
+
+  %PrepareFunctionForOptimization(kernel);
+  kernel(heap);
+  kernel(heap);
+
+  // Make sure that both functions actually get optimized, rather than
+  // measuring bailouts.
+  const kTurboFanned = 1 << 6;
+  for (const [name, f] of [['dispatch', dispatch], ['kernel', kernel]]) {
+    %BenchTurbofan(f, 1);
+    if (!(%GetOptimizationStatus(f) & kTurboFanned)) {
+      throw new Error(`${name} was not optimized`);
+    }
+  }
+
+  // Creating runners
+  function run_switch() {
+    %BenchTurbofan(dispatch, 1);
+  }
+  function run_kernel() {
+    %BenchTurbofan(kernel, 1);
+  }
+
+  // Registering tests
+  createSuite('Huge-Switch', 1, run_switch);
+  createSuite('Huge-AsmKernel', 1, run_kernel);
+})();
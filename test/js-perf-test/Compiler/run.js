@@ -7,6 +7,7 @@ d8.file.execute('../base.js');
 d8.file.execute('small.js');
 d8.file.execute('medium.js');
 d8.file.execute('large.js');
+d8.file.execute('huge.js');
 
 var success = true;
 
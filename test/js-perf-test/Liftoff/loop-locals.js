@@ -0,0 +1,93 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compile time and run time of Liftoff code for tight loops over locals.
+// Run with --liftoff --no-wasm-tier-up, with and without
+// --liftoff-loop-register-locals, to compare the two loop header strategies.
+//
+// The wasm module builder is not available for performance tests, so the
+// module bytes are assembled by hand below.
+
+(() => {
+
+  function leb(value) {
+    let bytes = [];
+    do {
+      let b = value & 0x7f;
+      value >>>= 7;
+      bytes.push(value ? b | 0x80 : b);
+    } while (value);
+    return bytes;
+  }
+
+  function section(id, contents) {
+    return [id, ...leb(contents.length), ...contents];
+  }
+
+  // (func (param $n i32) (result i32) (local $i i32) (local $acc i32)
+  //   (local $x i32)
+  //   (loop
+  //     $acc = $acc + ($i * $i ^ $x)
+  //     $x = ($acc >>> shift) + $i
+  //     (br_if 0 (i32.lt_u (local.tee $i (i32.add $i 1)) $n)))
+  //   $acc)
+  function loopBody(shift) {
+    let code = [
+      0x01, 0x03, 0x7f,                    // 3 i32 locals
+      0x03, 0x40,                          // loop
+      0x20, 0x02, 0x20, 0x01, 0x20, 0x01,  // acc, i, i
+      0x6c, 0x20, 0x03, 0x73, 0x6a,        // i32.mul, x, i32.xor, i32.add
+      0x21, 0x02,                          // local.set acc
+      0x20, 0x02, 0x41, shift, 0x76,       // acc, shift, i32.shr_u
+      0x20, 0x01, 0x6a, 0x21, 0x03,        // i, i32.add, local.set x
+      0x20, 0x01, 0x41, 0x01, 0x6a,        // i, 1, i32.add
+      0x22, 0x01, 0x20, 0x00, 0x49,        // local.tee i, n, i32.lt_u
+      0x0d, 0x00,                          // br_if 0
+      0x0b,                                // end
+      0x20, 0x02,                          // local.get acc
+      0x0b                                 // end
+    ];
+    return [...leb(code.length), ...code];
+  }
+
+  // A module with {num_functions} copies of the loop function, the first of
+  // which is exported as "sum".
+  function moduleBytes(num_functions, shift) {
+    let functions = [...leb(num_functions)];
+    let bodies = [...leb(num_functions)];
+    for (let i = 0; i < num_functions; ++i) {
+      functions.push(0x00);
+      bodies.push(...loopBody(shift));
+    }
+    return new Uint8Array([
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+      ...section(1, [0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f]),
+      ...section(3, functions),
+      ...section(7, [0x01, 0x03, 0x73, 0x75, 0x6d, 0x00, 0x00]),
+      ...section(10, bodies)
+    ]);
+  }
+
+  const kCompileFunctions = 500;
+  const kIterations = 100000;
+
+  const sum = new WebAssembly.Instance(
+      new WebAssembly.Module(moduleBytes(1, 3))).exports.sum;
+
+  // Different shift amounts produce different wire bytes, so the modules are
+  // compiled again instead of being taken from the native module cache.
+  let shift = 0;
+  function compile() {
+    shift = (shift % 31) + 1;
+    new WebAssembly.Module(moduleBytes(kCompileFunctions, shift));
+  }
+
+  let result;
+  function run() {
+    result = sum(kIterations);
+  }
+
+  createSuite('LoopLocals-Compile', 1, compile);
+  createSuite('LoopLocals-Run', 1, run);
+})();
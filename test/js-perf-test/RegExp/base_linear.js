@@ -0,0 +1,45 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+d8.file.execute("base.js");
+
+// Patterns and subjects without catastrophic backtracking, to compare the
+// experimental linear-time engine against irregexp.
+
+var str;
+var re;
+
+const kLog = "INFO: request handled in 12ms\n".repeat(200) +
+             "ERROR: 503 failed\n";
+const kWords = "the quick brown fox jumps over the lazy dog ".repeat(50);
+
+function LinearExec() {
+  re.exec(str);
+}
+
+function LinearReplace() {
+  str.replace(re, "$2 $1");
+}
+
+function createLinearBenchmarks(flags) {
+  function LogSetup() {
+    re = new RegExp("ERROR: (\\d+) failed", flags);
+    str = kLog;
+  }
+
+  function NoMatchSetup() {
+    re = new RegExp("fatal|panic", flags + "i");
+    str = kLog;
+  }
+
+  function WordsSetup() {
+    re = new RegExp("\\b(\\w+) (\\w+)\\b", flags + "g");
+    str = kWords;
+  }
+
+  return [ [LinearExec, LogSetup],
+           [LinearExec, NoMatchSetup],
+           [LinearReplace, WordsSetup],
+         ];
+}
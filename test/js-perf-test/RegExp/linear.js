@@ -0,0 +1,12 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+d8.file.execute("base.js");
+d8.file.execute("base_linear.js");
+
+benchmarks = createLinearBenchmarks("l");
+createBenchmarkSuite("Linear");
+
+benchmarks = createLinearBenchmarks("");
+createBenchmarkSuite("Backtracking");
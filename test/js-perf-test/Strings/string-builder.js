@@ -0,0 +1,81 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Builds long strings from many short pieces.
+
+new BenchmarkSuite('ArrayJoin', [1000], [
+  new Benchmark('ArrayJoin', true, false, 0, ArrayJoin),
+]);
+
+new BenchmarkSuite('ArrayJoinTwoByte', [1000], [
+  new Benchmark('ArrayJoinTwoByte', true, false, 0, ArrayJoinTwoByte),
+]);
+
+new BenchmarkSuite('ConcatLoop', [1000], [
+  new Benchmark('ConcatLoop', true, false, 0, ConcatLoop),
+]);
+
+new BenchmarkSuite('TemplateLiteralLoop', [1000], [
+  new Benchmark('TemplateLiteralLoop', true, false, 0, TemplateLiteralLoop),
+]);
+
+new BenchmarkSuite('StringRaw', [1000], [
+  new Benchmark('StringRaw', true, false, 0, StringRaw),
+]);
+
+new BenchmarkSuite('StringRawTwoByte', [1000], [
+  new Benchmark('StringRawTwoByte', true, false, 0, StringRawTwoByte),
+]);
+
+function makeWords(count, first) {
+  let result = [];
+  for (let i = 0; i < count; ++i) {
+    let word = '';
+    for (let j = 0; j < 1 + i % 8; ++j) {
+      word += String.fromCharCode(first + (i * 7 + j) % 26);
+    }
+    result.push(word);
+  }
+  return result;
+}
+
+const oneByteWords = makeWords(10000, 0x61);
+const twoByteWords = makeWords(10000, 0x430);
+const mixedWords = oneByteWords.map((w, i) => i % 100 ? w : twoByteWords[i]);
+
+const oneByteRaw = { raw: oneByteWords.slice(0, 2001) };
+const mixedRaw = { raw: mixedWords.slice(0, 2001) };
+const substitutions = oneByteWords.slice(0, 2000);
+
+function ArrayJoin() {
+  return oneByteWords.join(' ');
+}
+
+function ArrayJoinTwoByte() {
+  return mixedWords.join(' ');
+}
+
+function ConcatLoop() {
+  let result = '';
+  for (let i = 0; i < oneByteWords.length; ++i) {
+    result += oneByteWords[i] + ' ';
+  }
+  return result;
+}
+
+function TemplateLiteralLoop() {
+  let result = '';
+  for (let i = 0; i < oneByteWords.length; ++i) {
+    result = `${result}${oneByteWords[i]}:${i},`;
+  }
+  return result;
+}
+
+function StringRaw() {
+  return String.raw(oneByteRaw, ...substitutions);
+}
+
+function StringRawTwoByte() {
+  return String.raw(mixedRaw, ...substitutions);
+}
@@ -0,0 +1,74 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Searches for short patterns in long, log-like subjects.
+
+new BenchmarkSuite('OneByteIndexOfShortPattern', [1000], [
+  new Benchmark('OneByteIndexOfShortPattern', true, false, 0,
+  OneByteIndexOfShortPattern),
+]);
+
+new BenchmarkSuite('OneByteIndexOfMediumPattern', [1000], [
+  new Benchmark('OneByteIndexOfMediumPattern', true, false, 0,
+  OneByteIndexOfMediumPattern),
+]);
+
+new BenchmarkSuite('TwoByteIndexOfShortPattern', [1000], [
+  new Benchmark('TwoByteIndexOfShortPattern', true, false, 0,
+  TwoByteIndexOfShortPattern),
+]);
+
+new BenchmarkSuite('TwoByteIndexOfSingleChar', [1000], [
+  new Benchmark('TwoByteIndexOfSingleChar', true, false, 0,
+  TwoByteIndexOfSingleChar),
+]);
+
+new BenchmarkSuite('OneByteIncludesMissing', [1000], [
+  new Benchmark('OneByteIncludesMissing', true, false, 0,
+  OneByteIncludesMissing),
+]);
+
+new BenchmarkSuite('OneByteSplit', [1000], [
+  new Benchmark('OneByteSplit', true, false, 0,
+  OneByteSplit),
+]);
+
+function makeLog(lines, extra) {
+  let result = [];
+  for (let i = 0; i < lines; ++i) {
+    result.push(`2023-05-0${i % 9 + 1} 12:${i % 60}:00 INFO ` +
+                `request ${i} served in ${i % 97}ms | user=u${i % 13}` +
+                extra);
+  }
+  // Use Array.join to create a flat string
+  return result.join('\n');
+}
+
+const oneByteLog = makeLog(4000, '') + '\nERROR: disk full';
+const twoByteLog = makeLog(4000, ' été ✓') +
+    '\nERROR: disk full ✗';
+
+function OneByteIndexOfShortPattern() {
+  return oneByteLog.indexOf('ERROR');
+}
+
+function OneByteIndexOfMediumPattern() {
+  return oneByteLog.indexOf('ERROR: disk full');
+}
+
+function TwoByteIndexOfShortPattern() {
+  return twoByteLog.indexOf('ERROR');
+}
+
+function TwoByteIndexOfSingleChar() {
+  return twoByteLog.indexOf('✗');
+}
+
+function OneByteIncludesMissing() {
+  return oneByteLog.includes('WARNING');
+}
+
+function OneByteSplit() {
+  return oneByteLog.split(' | ').length;
+}
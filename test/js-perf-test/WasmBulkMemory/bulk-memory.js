@@ -0,0 +1,76 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Memory bandwidth of wasm memory.copy and memory.fill, for sizes below and
+// above --wasm-bulk-memory-nontemporal-threshold.
+//
+// The wasm module builder is not available for performance tests, so the
+// module bytes are assembled by hand below.
+
+(() => {
+
+  function leb(value) {
+    let bytes = [];
+    do {
+      let b = value & 0x7f;
+      value >>>= 7;
+      bytes.push(value ? b | 0x80 : b);
+    } while (value);
+    return bytes;
+  }
+
+  function section(id, contents) {
+    return [id, ...leb(contents.length), ...contents];
+  }
+
+  function body(code) {
+    return [...leb(code.length + 1), 0x00, ...code];
+  }
+
+  const kPages = 512;  // 32 MiB.
+
+  // (memory 512)
+  // (func (export "copy") (param i32 i32 i32)
+  //   (memory.copy (local.get 0) (local.get 1) (local.get 2)))
+  // (func (export "fill") (param i32 i32 i32)
+  //   (memory.fill (local.get 0) (local.get 1) (local.get 2)))
+  const bytes = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    ...section(1, [0x01, 0x60, 0x03, 0x7f, 0x7f, 0x7f, 0x00]),
+    ...section(3, [0x02, 0x00, 0x00]),
+    ...section(5, [0x01, 0x00, ...leb(kPages)]),
+    ...section(7, [
+      0x02,
+      0x04, 0x63, 0x6f, 0x70, 0x79, 0x00, 0x00,  // "copy"
+      0x04, 0x66, 0x69, 0x6c, 0x6c, 0x00, 0x01   // "fill"
+    ]),
+    ...section(10, [
+      0x02,
+      ...body([0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0xfc, 0x0a, 0x00, 0x00,
+               0x0b]),
+      ...body([0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0xfc, 0x0b, 0x00, 0x0b])
+    ])
+  ]);
+
+  const {copy, fill} =
+      new WebAssembly.Instance(new WebAssembly.Module(bytes)).exports;
+
+  const kHalf = kPages * 65536 / 2;
+  const kTotalBytes = 256 * 1024 * 1024;
+
+  // Each run moves the same total number of bytes, in chunks of {size}.
+  function benchmark(name, size) {
+    const count = kTotalBytes / size;
+    createSuite(`Copy-${name}`, 1, () => {
+      for (let i = 0; i < count; ++i) copy(kHalf, 0, size);
+    });
+    createSuite(`Fill-${name}`, 1, () => {
+      for (let i = 0; i < count; ++i) fill(0, i, size);
+    });
+  }
+
+  benchmark('4KB', 4 * 1024);
+  benchmark('256KB', 256 * 1024);
+  benchmark('16MB', 16 * 1024 * 1024);
+})();
@@ -0,0 +1,109 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbofan --call-target-histogram
+// Flags: --min-call-target-share=0.1
+
+function a(x) { return x + 1; }
+function b(x) { return x + 2; }
+function c(x) { return x + 3; }
+function d(x) { return x + 4; }
+function e(x) { return x + 5; }
+function rare(x) { return x + 6; }
+function thrower(x) { throw x; }
+
+(function TestHotTargetsAndGenericFallback() {
+  function dispatch(f, x) {
+    return f(x);
+  }
+
+  %PrepareFunctionForOptimization(dispatch);
+  const targets = [a, b, c, d, e, a, b, a];
+  for (let i = 0; i < 100; ++i) {
+    const f = targets[i % targets.length];
+    assertEquals(f(i), dispatch(f, i));
+  }
+  assertEquals(7, dispatch(rare, 1));
+  %OptimizeFunctionOnNextCall(dispatch);
+  assertEquals(2, dispatch(a, 1));
+  assertEquals(3, dispatch(b, 1));
+  assertEquals(6, dispatch(e, 1));
+  assertOptimized(dispatch);
+
+  // Targets that were not inlined go through the generic call.
+  assertEquals(7, dispatch(rare, 1));
+  assertEquals(42, dispatch((x) => x, 42));
+  assertOptimized(dispatch);
+})();
+
+(function TestExceptionalCall() {
+  function dispatch(f, x) {
+    try {
+      return f(x);
+    } catch (e) {
+      return -e;
+    }
+  }
+
+  %PrepareFunctionForOptimization(dispatch);
+  const targets = [a, b, thrower, c];
+  for (let i = 0; i < 40; ++i) {
+    const f = targets[i % targets.length];
+    assertEquals(f === thrower ? -i : f(i), dispatch(f, i));
+  }
+  %OptimizeFunctionOnNextCall(dispatch);
+  assertEquals(2, dispatch(a, 1));
+  assertEquals(-1, dispatch(thrower, 1));
+  assertEquals(-2, dispatch((x) => { throw x; }, 2));
+  assertEquals(5, dispatch(d, 1));
+  assertOptimized(dispatch);
+})();
+
+(function TestFullHistogram() {
+  function dispatch(f, x) {
+    return f(x);
+  }
+
+  // Fill the histogram with more targets than it can hold; later targets
+  // are only reflected in the total call count.
+  const targets = [];
+  for (let i = 0; i < 16; ++i) {
+    targets.push(new Function('x', `return x + ${i};`));
+  }
+  %PrepareFunctionForOptimization(dispatch);
+  for (let round = 0; round < 10; ++round) {
+    for (let i = 0; i < targets.length; ++i) {
+      assertEquals(round + i, dispatch(targets[i], round));
+    }
+  }
+  %OptimizeFunctionOnNextCall(dispatch);
+  assertEquals(1, dispatch(targets[1], 0));
+  assertEquals(15, dispatch(targets[15], 0));
+  assertOptimized(dispatch);
+})();
+
+(function TestUnrecordedTargets() {
+  function dispatch(f, x) {
+    return f(x);
+  }
+
+  // Bound functions and functions from another native context are never
+  // recorded in the histogram.
+  const realm = Realm.create();
+  const foreign = Realm.eval(realm, '(function(x) { return x + 100; })');
+  const bound = b.bind(null);
+  %PrepareFunctionForOptimization(dispatch);
+  for (let i = 0; i < 40; ++i) {
+    assertEquals(i + 1, dispatch(a, i));
+    assertEquals(i + 2, dispatch(bound, i));
+    assertEquals(i + 100, dispatch(foreign, i));
+    assertEquals(i + 3, dispatch(c, i));
+  }
+  %OptimizeFunctionOnNextCall(dispatch);
+  assertEquals(2, dispatch(a, 1));
+  assertEquals(3, dispatch(bound, 1));
+  assertEquals(101, dispatch(foreign, 1));
+  assertEquals(4, dispatch(c, 1));
+  assertOptimized(dispatch);
+})();
@@ -0,0 +1,86 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --deopt-storm-backoff --deopt-storm-threshold=2
+// Flags: --deopt-storm-decay-ticks=100000 --trace-deopt-storm
+// Flags: --maglev --turbofan --no-always-turbofan --no-use-osr
+// Flags: --no-concurrent-recompilation --invocation-count-for-maglev=20
+// Flags: --invocation-count-for-turbofan=20
+// Flags: --minimum-invocations-after-ic-update=1
+
+// The functions below tier up by themselves, i.e. without
+// %PrepareFunctionForOptimization, since the d8 test runner excludes manually
+// optimized functions from heuristic tiering.
+
+let keep_going = 1000000;  // A counter to avoid test hangs on failure.
+
+function isMaglevCode(f) {
+  return (%GetOptimizationStatus(f) & V8OptimizationStatus.kMaglevved) !== 0;
+}
+
+function isTurboFanCode(f) {
+  return (%GetOptimizationStatus(f) & V8OptimizationStatus.kTurboFanned) !==
+      0;
+}
+
+// Calls {f} with {arg} until {done(f)}, and returns the number of calls.
+function callsUntil(done, f, arg) {
+  let calls = 0;
+  while (!done(f) && --keep_going) {
+    f(arg);
+    ++calls;
+  }
+  assertTrue(done(f));
+  return calls;
+}
+
+// Each new object shape deoptimizes the code specialized for the previous
+// shapes. The shapes stay within the polymorphic limit of the property load.
+const shapes = [{x: 1}, {a: 0, x: 2}, {b: 0, x: 3}, {c: 0, x: 4}];
+
+function TestBackoff() {
+  function load(o) {
+    return o.x;
+  }
+
+  // Every round ends in a deopt of the Maglev code. Up to the threshold, the
+  // function tiers up as usual, after that the interrupt budget doubles with
+  // every deopt.
+  const calls = [];
+  for (let i = 0; i + 1 < shapes.length; ++i) {
+    calls.push(callsUntil(isMaglevCode, load, shapes[i]));
+    assertEquals(i + 2, load(shapes[i + 1]));
+    assertFalse(isMaglevCode(load));
+  }
+  // 2 deopts so far, backoff 2^1.
+  assertTrue(calls[2] > calls[1], `${calls}`);
+  // 3 deopts, backoff 2^2.
+  const last = callsUntil(isMaglevCode, load, shapes[0]);
+  assertTrue(last > 2 * calls[1], `${calls},${last}`);
+}
+
+function TestLimitToMaglev() {
+  function load(o) {
+    return o.x;
+  }
+
+  // Every round ends in a deopt of the TurboFan code.
+  for (let i = 0; i < 2; ++i) {
+    callsUntil(isTurboFanCode, load, shapes[i]);
+    assertEquals(i + 2, load(shapes[i + 1]));
+    assertFalse(isTurboFanCode(load));
+  }
+
+  // The function is unstable now, and stays in Maglev even with stable
+  // feedback, until the deopt counts decay.
+  callsUntil(isMaglevCode, load, shapes[0]);
+  for (let i = 0; i < 10000; ++i) load(shapes[i % 3]);
+  assertTrue(isMaglevCode(load));
+  assertFalse(isTurboFanCode(load));
+}
+
+if (%IsMaglevEnabled() && %IsTurbofanEnabled()) {
+  TestBackoff();
+  TestLimitToMaglev();
+}
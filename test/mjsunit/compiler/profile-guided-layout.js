@@ -0,0 +1,29 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-profile-guided-layout
+// Flags: --turbo-profile-guided-layout-min-count=10
+
+function f(x) {
+  if (x < 0) {
+    return -x;
+  }
+  return x + 1;
+}
+
+// The first optimized version is instrumented with block counters.
+%PrepareFunctionForOptimization(f);
+assertEquals(2, f(1));
+assertEquals(1, f(-1));
+%OptimizeFunctionOnNextCall(f);
+assertEquals(2, f(1));
+for (let i = 0; i < 100; ++i) assertEquals(i + 1, f(i));
+
+// Reoptimizing the same graph uses the collected counts to defer the cold
+// branch; the result must not change.
+%DeoptimizeFunction(f);
+%PrepareFunctionForOptimization(f);
+%OptimizeFunctionOnNextCall(f);
+assertEquals(2, f(1));
+assertEquals(5, f(-5));
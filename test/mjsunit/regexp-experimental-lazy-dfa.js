@@ -0,0 +1,134 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --enable-experimental-regexp-engine
+// Flags: --experimental-regexp-engine-for-unsafe-patterns
+
+// The experimental engine first scans subjects with a lazily built DFA and
+// only simulates the NFA if the DFA can reach an accepting state.  Compare
+// against irregexp for patterns which are backtracking-safe, so that only the
+// regexps with the linear flag use the experimental engine.
+
+function check(source, flags, subject) {
+  let linear = new RegExp(source, flags + 'l');
+  let backtracking = new RegExp(source, flags);
+  assertEquals('EXPERIMENTAL', %RegexpTypeTag(linear));
+  assertEquals('IRREGEXP', %RegexpTypeTag(backtracking));
+  let message = `/${source}/${flags} on ${JSON.stringify(subject)}`;
+  assertEquals(backtracking.exec(subject), linear.exec(subject), message);
+  assertEquals(backtracking.lastIndex, linear.lastIndex, message);
+  assertEquals(subject.replace(new RegExp(source, flags + 'g'), '<$&>'),
+               subject.replace(new RegExp(source, flags + 'gl'), '<$&>'),
+               message);
+}
+
+const kPatterns = [
+  'abc',
+  'a[bc]+d',
+  '(a|b)c(d|e)',
+  '^abc',
+  'abc$',
+  '\\bfoo\\b',
+  '[^a-c]x',
+  'x(?:yz)?',
+  'a.c',
+  '(\\d+)-(\\d+)',
+  'ሴ+b',
+  '',
+  'x*',
+  '(?:a|b)*a(?:a|b){3}',
+];
+
+const kSubjects = [
+  '',
+  'abc',
+  'xxabcxx',
+  'abbcbd acd ace bce',
+  'foo food afoo foo',
+  'axbxcxdx',
+  'xyz xy x',
+  'a\nc abc',
+  '12-34 5-',
+  'ሴሴb ሴ b',
+  'ABC aBc xAbCx',
+  'Foo FOO',
+  'bbbbabab babbbb',
+];
+
+for (let source of kPatterns) {
+  for (let subject of kSubjects) {
+    for (let flags of ['', 'i', 'm', 's', 'y']) {
+      check(source, flags, subject);
+      check(source, flags, subject + 'ħ');
+    }
+  }
+}
+
+(function TestIgnoreCase() {
+  assertEquals(['aBc'], /abc/il.exec('xaBcx'));
+  assertEquals(['ΣΑΣ'], /σας/il.exec('ΣΑΣ'));
+  assertEquals(['Xy'], /[^a-w]Y/il.exec('aY Xy'));
+  assertEquals(null, /[^a-z]/il.exec('ABC'));
+})();
+
+(function TestManyStates() {
+  // The DFA for this pattern has 2^17 states, more than fit into the budget.
+  // On a long random subject it gives up, and the NFA simulation has to find
+  // the match on its own.
+  let seed = 17;
+  let subject = '';
+  for (let i = 0; i < 50000; ++i) {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    subject += (seed >> 16) & 1 ? 'a' : 'b';
+  }
+  let source = '(?:a|b)*a(?:a|b){16}';
+  assertEquals(new RegExp(source).exec(subject),
+               new RegExp(source, 'l').exec(subject));
+  assertEquals(null, new RegExp(source, 'l').exec('b'.repeat(200)));
+})();
+
+(function TestUnsafePatterns() {
+  // Patterns with nested unbounded quantifiers use the experimental engine
+  // even without the linear flag.
+  for (let re of [/(a+)+b/, /(?:a*)*b/, /(x|y+)*z/]) {
+    assertEquals('EXPERIMENTAL', %RegexpTypeTag(re));
+  }
+  for (let re of [/a+b/, /(a+)b+/, /(a{2})*b/, /(?:a|b)*c/]) {
+    assertEquals('IRREGEXP', %RegexpTypeTag(re));
+  }
+  // Unsupported by the experimental engine.
+  assertEquals('IRREGEXP', %RegexpTypeTag(/(a+)+\1/));
+
+  let subject = 'a'.repeat(50);
+  assertEquals(null, /(a+)+b/.exec(subject));
+  assertEquals(['aab', 'aa'], /(a+)+b/.exec('xaab'));
+  assertEquals(['yyyz', 'yyy'], /(x|y+)*z/.exec('yyyz'));
+})();
+
+(function TestSkippedPrefix() {
+  // The NFA simulation starts where the DFA scan found the last attempt at a
+  // match to begin.  Attempts which fail midway must not move the captures.
+  const kCases = [
+    ['a*b', 'xxxaaab'],
+    ['(x)(a+)b', 'zzzxaxaab'],
+    ['(ab|a)(c|bcd)', 'aaaabcd'],
+    ['\\bfoo', 'xfoo foo'],
+    ['x\\Ba+', 'xa xaa'],
+    ['(a)|b', 'cccb'],
+  ];
+  for (let [source, subject] of kCases) {
+    check(source, '', subject);
+    check(source, '', subject.repeat(3));
+  }
+})();
+
+(function TestCachedDfaIsReused() {
+  // The DFAs are cached per isolate by bytecode, so that distinct regexps
+  // with the same source share one and keep their results.
+  for (let i = 0; i < 3; ++i) {
+    for (let source of kPatterns) {
+      check(source, '', 'xxabcd12-34foo x ayz aaaa');
+    }
+  }
+})();
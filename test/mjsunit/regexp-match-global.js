@@ -0,0 +1,85 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// String.prototype.match with an unmodified global regexp computes all
+// matches in the runtime in batches. Compare against the spec-conforming
+// path, which is taken if the regexp has an own exec property.
+
+function slowRegExp(re) {
+  let slow = new RegExp(re.source, re.flags);
+  slow.exec = RegExp.prototype.exec;
+  return slow;
+}
+
+function check(re, subject) {
+  let slow = slowRegExp(re);
+  re.lastIndex = 3;
+  slow.lastIndex = 3;
+  let message = `${JSON.stringify(subject)}.match(${re})`;
+  let expected = subject.match(slow);
+  let expected_statics =
+      [RegExp.lastMatch, RegExp.leftContext, RegExp.rightContext, RegExp.$1];
+  assertEquals(expected, subject.match(re), message);
+  assertEquals(expected_statics,
+               [RegExp.lastMatch, RegExp.leftContext, RegExp.rightContext,
+                RegExp.$1],
+               message);
+  assertEquals(slow.lastIndex, re.lastIndex, message);
+  assertEquals(0, re.lastIndex, message);
+}
+
+const kRegExps = [
+  /a/g,
+  /abc/g,
+  /b+/g,
+  /(\w)(\d)?/g,
+  /x*/g,
+  /$/g,
+  /\b/gm,
+  /(?:)/gu,
+  /./gu,
+  /.?/gu,
+  /[a-c]/gi,
+  /(a)|(b)/g,
+  /\d{2}(?=\D)/g,
+];
+
+const kSubjects = [
+  '',
+  'a',
+  'abcabcabc',
+  'xbbxbxbbbx',
+  'a1b2c3d',
+  'no match here',
+  '😀a😀b',
+  '\ud83dabc\ude00',
+  'ABCabc',
+  '12 34 5 678x',
+];
+
+for (let re of kRegExps) {
+  for (let subject of kSubjects) {
+    check(re, subject);
+    check(re, subject.repeat(40));
+    check(re, 'ሴ' + subject);
+  }
+}
+
+(function TestManyMatches() {
+  // More matches than fit into one batch of registers.
+  let subject = 'ab'.repeat(1000);
+  assertEquals(1000, subject.match(/a/g).length);
+  assertEquals(1000, subject.match(/(a)(b)/g).length);
+  assertEquals(2001, subject.match(/x*/g).length);
+  assertEquals(['ab'], [...new Set(subject.match(/(a)(b)/g))]);
+})();
+
+(function TestMatchesAreStrings() {
+  let matches = 'a-bb-ccc'.match(/[a-z]+/g);
+  assertEquals(['a', 'bb', 'ccc'], matches);
+  assertTrue(Array.isArray(matches));
+  matches.push('d');
+  assertEquals(4, matches.length);
+  assertNull('abc'.match(/x/g));
+})();
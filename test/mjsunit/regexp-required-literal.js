@@ -0,0 +1,80 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Regexps whose matches all contain a certain literal first scan the subject
+// for it. Compare against the same regexps wrapped in a disjunction, for
+// which no required literal is extracted.
+
+function unfiltered(re) {
+  return new RegExp(`(?:${re.source})|(?!)`, re.flags);
+}
+
+function check(re, subject) {
+  let expected_re = unfiltered(re);
+  for (let last_index of [0, 1, 5, 17, subject.length]) {
+    re.lastIndex = last_index;
+    expected_re.lastIndex = last_index;
+    let message = `${re}.exec(${JSON.stringify(subject)}) at ${last_index}`;
+    assertEquals(expected_re.exec(subject), re.exec(subject), message);
+    assertEquals(expected_re.lastIndex, re.lastIndex, message);
+  }
+  assertEquals(subject.replace(unfiltered(re), '<$&>'),
+               subject.replace(re, '<$&>'));
+  assertEquals(subject.search(unfiltered(re)), subject.search(re));
+}
+
+const kRegExps = [
+  /ERROR: (\d+) failed/,
+  /ERROR: (\d+) failed/g,
+  /(\d+) ERROR/g,
+  /\d{3}ERROR/g,
+  /.ab.cd/g,
+  /a(b(c))d\w?e/,
+  /(?<=x)abc/g,
+  /\babc\b/g,
+  /a.😀b/gu,
+  /[😀]x/gu,
+  /a+ba+c/g,
+  /(a|b)abcd/g,
+  /(?:xy){2}z/g,
+  /(?!abcd)abc/g,
+  /ab(?=cd)c/g,
+  /ሴab/g,
+];
+
+const kSubjects = [
+  '',
+  'abc',
+  'ERROR: 42 failed',
+  'INFO: 1 ok\nERROR: 123 failed\nERROR: x failed\nERROR: 7 failed',
+  '1 ERROR 22 ERROR 333ERROR ERROR',
+  'xxabc abc xabcd abcd ab cd',
+  'aab1cd abcd b.abcd abcde abce',
+  'a😀b ab😀b a-😀b 😀x',
+  'aabaac aaba abac bbabcd aabcd',
+  'xyxyz xyz xyxyxyz',
+  'ሴab ab ሴሴab',
+  'abcdabcd'.repeat(20) + 'ERROR: 9 failed',
+];
+
+for (let re of kRegExps) {
+  for (let subject of kSubjects) {
+    check(re, subject);
+    check(re, '☃' + subject);
+    check(re, subject + '.'.repeat(40));
+  }
+}
+
+(function TestLongSubjects() {
+  let noise = 'INFO: all good, nothing to report\n'.repeat(1000);
+  let re = /ERROR: (\d+) failed/g;
+  assertNull(re.exec(noise));
+  let subject = noise + 'ERROR: 17 failed\n' + noise + 'ERROR: 18 failed';
+  assertEquals(['ERROR: 17 failed', 'ERROR: 18 failed'], subject.match(re));
+  assertEquals([['ERROR: 17 failed', '17'], ['ERROR: 18 failed', '18']],
+               [...subject.matchAll(re)].map(m => [...m]));
+  assertEquals(noise.length, subject.search(re));
+  assertTrue(/ERROR: (\d+)/.test(subject));
+  assertFalse(/ERROR: (\d+) passed/.test(subject));
+})();
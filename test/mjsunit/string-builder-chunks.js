@@ -0,0 +1,74 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// String.raw builds its result with the IncrementalStringBuilder, which
+// collects the characters in chunks and copies them into a flat string once.
+// Compare against a plain concatenation.
+
+function concatRaw(strings, ...substitutions) {
+  let result = '';
+  for (let i = 0; i < strings.raw.length; ++i) {
+    result += strings.raw[i];
+    if (i < substitutions.length) result += substitutions[i];
+  }
+  return result;
+}
+
+function check(pieces) {
+  let strings = { raw: pieces.filter((_, i) => i % 2 == 0) };
+  let substitutions = pieces.filter((_, i) => i % 2 == 1);
+  let expected = concatRaw(strings, ...substitutions);
+  let result = String.raw(strings, ...substitutions);
+  assertEquals(expected, result);
+}
+
+(function TestEmpty() {
+  assertEquals('', String.raw({ raw: [] }));
+  assertEquals('', String.raw({ raw: [''] }));
+  assertEquals('', String.raw({ raw: ['', ''] }, ''));
+})();
+
+(function TestShort() {
+  check(['a']);
+  check(['a', 'b', 'c']);
+  check(['a', 1, 'b', null, 'c']);
+})();
+
+(function TestManyParts() {
+  // Enough characters to fill several chunks of growing length.
+  let pieces = [];
+  for (let i = 0; i < 5000; ++i) pieces.push('x'.repeat(i % 17) + i);
+  check(pieces);
+})();
+
+(function TestTwoByte() {
+  let pieces = [];
+  for (let i = 0; i < 2000; ++i) pieces.push(i % 500 == 3 ? 'ሴ' : 'ab' + i);
+  check(pieces);
+  check(['ሴ', 'a', 'b']);
+  check(['a', 'b', 'ÿ', 'ሴ']);
+  // Latin-1 characters in one-byte chunks are widened when the result has to
+  // be two-byte.
+  check(['à'.repeat(100), 'ሴ'.repeat(100), 'ÿ'.repeat(100)]);
+})();
+
+(function TestLongStrings() {
+  let one_byte = 'abcdefgh'.repeat(1000);
+  let two_byte = 'ሴ' + 'abcdefgh'.repeat(1000);
+  let cons = 'x'.repeat(3000) + 'y'.repeat(3000);
+  check([one_byte]);
+  check([two_byte]);
+  check([cons]);
+  check(['a', one_byte, 'b', two_byte, 'c']);
+  check([one_byte, two_byte, one_byte]);
+  check(['a'.repeat(50), cons, 'ሴ', cons]);
+})();
+
+(function TestInvalidStringLength() {
+  let long = 'a'.repeat(%StringMaxLength() / 2 + 1);
+  assertThrows(() => String.raw({ raw: [long, long] }, ''), RangeError);
+  assertThrows(() => String.raw({ raw: ['ab', long] }, long), RangeError);
+})();
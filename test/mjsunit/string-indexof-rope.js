@@ -0,0 +1,107 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Long cons strings are searched segment by segment without flattening them.
+// Compare against the same strings after flattening.
+
+function flat(string) {
+  return JSON.parse(JSON.stringify(string));
+}
+
+function check(rope, pattern) {
+  let expected = flat(rope);
+  for (let start of [0, 1, 1000, rope.length - pattern.length,
+                     rope.length]) {
+    let message = `${JSON.stringify(pattern)} from ${start}`;
+    assertEquals(expected.indexOf(pattern, start),
+                 rope.indexOf(pattern, start), message);
+    assertEquals(expected.includes(pattern, start),
+                 rope.includes(pattern, start), message);
+  }
+}
+
+function buildRope(pieces, count) {
+  let rope = '';
+  for (let i = 0; i < count; ++i) rope += pieces[i % pieces.length];
+  return rope;
+}
+
+const kOneBytePieces = ['ab', 'c', 'abcd', 'x', 'yz', 'abcabcabd', 'q'];
+const kTwoBytePieces = ['ሴ', 'ab', 'ሴሴx', 'c', 'ĀāĂ', 'x'];
+
+const kPatterns = [
+  'a', 'abc', 'cab', 'dxy', 'zqa', 'abcabd', 'ab'.repeat(20), 'ሴ', 'ሴab',
+  'cሴ', 'xĀā', 'Ăab', 'not found', 'END', 'qab\0',
+];
+
+for (let pieces of [kOneBytePieces, kTwoBytePieces]) {
+  let rope = buildRope(pieces, 150000);
+  assertTrue(rope.length >= 256 * 1024);
+  for (let pattern of kPatterns) {
+    check(rope, pattern);
+    check(rope + 'END', pattern);
+    check('END' + rope, pattern);
+  }
+}
+
+(function TestMatchAcrossManySegments() {
+  // The pattern starts in one segment and ends several segments later.
+  let rope = 'x'.repeat(300 * 1024);
+  for (let i = 0; i < 1000; ++i) rope += 'ab';
+  rope += 'c';
+  let pattern = 'ab'.repeat(1000) + 'c';
+  assertEquals(300 * 1024, rope.indexOf(pattern));
+  assertEquals(-1, rope.indexOf(pattern, 300 * 1024 + 1));
+  assertEquals(300 * 1024 + 2, rope.indexOf(pattern.substring(2)));
+  assertEquals(-1, rope.indexOf(pattern + 'c'));
+})();
+
+(function TestStringUnchanged() {
+  let rope = buildRope(kTwoBytePieces, 150000);
+  let expected = flat(rope);
+  rope.indexOf('ሴሴxc');
+  rope.indexOf('not found');
+  assertEquals(expected, rope);
+})();
+
+(function TestManyShortSegments() {
+  // Segments shorter than the pattern are collected before they are searched.
+  let pattern = 'abcdefghij'.repeat(10) + 'k';
+  let rope = '';
+  for (let i = 0; i < 300 * 1024; ++i) rope += 'abcdefghij'[i % 10];
+  let expected = flat(rope);
+  for (let suffix of ['k', 'x', 'kx']) {
+    let string = rope + suffix;
+    assertEquals(expected.concat(suffix).indexOf(pattern),
+                 string.indexOf(pattern));
+  }
+})();
+
+(function TestOptimizedCode() {
+  // Optimized code calls the StringIndexOf builtin directly.
+  function indexOf(string, pattern, start) {
+    return string.indexOf(pattern, start);
+  }
+  function includes(string, pattern) {
+    return string.includes(pattern);
+  }
+  let rope = buildRope(kOneBytePieces, 150000);
+  assertTrue(rope.length >= 256 * 1024);
+  let expected = flat(rope);
+  %PrepareFunctionForOptimization(indexOf);
+  %PrepareFunctionForOptimization(includes);
+  indexOf('abc', 'b', 0);
+  includes('abc', 'b');
+  %OptimizeFunctionOnNextCall(indexOf);
+  %OptimizeFunctionOnNextCall(includes);
+  for (let pattern of kPatterns) {
+    for (let start of [0, 1000, rope.length - 3]) {
+      assertEquals(expected.indexOf(pattern, start),
+                   indexOf(rope, pattern, start));
+    }
+    assertEquals(expected.includes(pattern), includes(rope, pattern));
+  }
+})();
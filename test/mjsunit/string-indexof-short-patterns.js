@@ -0,0 +1,91 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Short patterns are searched with a vectorized first-and-last-character
+// filter. Compare against a naive search around vector boundaries, with
+// matches close to the end of the subject, and in one-byte and two-byte
+// subjects.
+
+function naiveIndexOf(subject, pattern, from) {
+  outer: for (let i = from; i + pattern.length <= subject.length; ++i) {
+    for (let j = 0; j < pattern.length; ++j) {
+      if (subject[i + j] !== pattern[j]) continue outer;
+    }
+    return i;
+  }
+  return -1;
+}
+
+// Pseudo-random, but deterministic.
+let seed = 17;
+function random(n) {
+  seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+  return seed % n;
+}
+
+function randomString(length, alphabet) {
+  let result = '';
+  for (let i = 0; i < length; ++i) {
+    result += alphabet[random(alphabet.length)];
+  }
+  return result;
+}
+
+function check(subject, pattern) {
+  for (let from of [0, 1, 15, 16, 17, 31, 33]) {
+    if (from > subject.length) break;
+    assertEquals(naiveIndexOf(subject, pattern, from),
+                 subject.indexOf(pattern, from),
+                 `${JSON.stringify(subject)}.indexOf(${
+                     JSON.stringify(pattern)}, ${from})`);
+  }
+  assertEquals(naiveIndexOf(subject, pattern, 0) >= 0,
+               subject.includes(pattern));
+}
+
+(function TestRandom() {
+  for (let alphabet of ['ab', 'abcd', 'abሴ', 'aĀā']) {
+    for (let i = 0; i < 300; ++i) {
+      let subject = randomString(random(100), alphabet);
+      let pattern = randomString(1 + random(34), alphabet);
+      check(subject, pattern);
+      // Also with a match inserted at a random position.
+      let at = random(subject.length + 1);
+      check(subject.substring(0, at) + pattern + subject.substring(at),
+            pattern);
+    }
+  }
+})();
+
+(function TestFirstAndLastCharacterMatchOnly() {
+  let pattern = 'x' + 'abcdefghijklmnopqrstuvwxyz'.substring(0, 20) + 'y';
+  let decoy = 'x' + 'abcdefghijklmnopqrstuvwxyZ'.substring(0, 20) + 'y';
+  for (let prefix = 0; prefix < 70; ++prefix) {
+    let subject = '.'.repeat(prefix) + decoy + decoy + pattern + '.';
+    check(subject, pattern);
+    check(subject + '☃', pattern);
+    check(subject, pattern + '☃');
+  }
+})();
+
+(function TestMatchAtEnd() {
+  for (let length = 1; length <= 40; ++length) {
+    let pattern = 'e' + randomString(length - 1, 'abc');
+    for (let prefix = 0; prefix < 70; ++prefix) {
+      let subject = 'd'.repeat(prefix) + pattern;
+      assertEquals(prefix, subject.indexOf(pattern));
+      assertEquals(prefix + 1, ('Ā' + subject).indexOf(pattern));
+      // The pattern is cut off by one character.
+      assertEquals(-1, subject.substring(0, subject.length - 1)
+                           .indexOf(pattern));
+    }
+  }
+})();
+
+(function TestSplit() {
+  let subject = 'ab--cd--ef'.repeat(20);
+  assertEquals(41, subject.split('--').length);
+  assertEquals(41, ('ሴ' + subject).split('--').length);
+  assertEquals(['ab', 'cd', 'ef'], 'abሴ-cdሴ-ef'.split('ሴ-'));
+})();
@@ -0,0 +1,115 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --no-liftoff --wasm-bulk-memory-nontemporal-threshold=4096
+
+// Tests the inline code for small memory.copy and memory.fill with a constant
+// size in TurboFan, and the non-temporal store path for large sizes.
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+function instantiateBulkMemoryModule(sizes) {
+  const builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1);
+  builder.exportMemoryAs('memory');
+  for (let size of sizes) {
+    builder.addFunction(`copy${size}`, kSig_v_ii)
+        .addBody([
+          kExprLocalGet, 0, kExprLocalGet, 1, ...wasmI32Const(size),
+          kNumericPrefix, kExprMemoryCopy, 0, 0
+        ])
+        .exportFunc();
+    builder.addFunction(`fill${size}`, kSig_v_ii)
+        .addBody([
+          kExprLocalGet, 0, kExprLocalGet, 1, ...wasmI32Const(size),
+          kNumericPrefix, kExprMemoryFill, 0
+        ])
+        .exportFunc();
+  }
+  builder.addFunction('copy', kSig_v_iii)
+      .addBody([
+        kExprLocalGet, 0, kExprLocalGet, 1, kExprLocalGet, 2,
+        kNumericPrefix, kExprMemoryCopy, 0, 0
+      ])
+      .exportFunc();
+  builder.addFunction('fill', kSig_v_iii)
+      .addBody([
+        kExprLocalGet, 0, kExprLocalGet, 1, kExprLocalGet, 2,
+        kNumericPrefix, kExprMemoryFill, 0
+      ])
+      .exportFunc();
+  return builder.instantiate().exports;
+}
+
+function initialize(mem) {
+  for (let i = 0; i < mem.length; ++i) mem[i] = i * 7;
+}
+
+(function TestInlineCopy() {
+  print(arguments.callee.name);
+  const sizes = [1, 2, 3, 7, 8, 9, 15, 16];
+  const exports = instantiateBulkMemoryModule(sizes);
+  const mem = new Uint8Array(exports.memory.buffer);
+  for (let size of sizes) {
+    const copy = exports[`copy${size}`];
+    // Disjoint, and overlapping in both directions.
+    for (let [dst, src] of [[100, 200], [100, 103], [103, 100], [5, 5]]) {
+      initialize(mem);
+      const expected = mem.slice();
+      expected.copyWithin(dst, src, src + size);
+      copy(dst, src);
+      assertEquals(expected, mem);
+    }
+    // Out of bounds accesses trap without writing anything.
+    initialize(mem);
+    const expected = mem.slice();
+    assertTraps(kTrapMemOutOfBounds, () => copy(mem.length - size + 1, 0));
+    assertTraps(kTrapMemOutOfBounds, () => copy(0, mem.length - size + 1));
+    assertTraps(kTrapMemOutOfBounds, () => copy(-1, 0));
+    assertEquals(expected, mem);
+    copy(mem.length - size, 0);
+    copy(0, mem.length - size);
+  }
+})();
+
+(function TestInlineFill() {
+  print(arguments.callee.name);
+  const sizes = [1, 2, 3, 7, 8, 9, 15, 16];
+  const exports = instantiateBulkMemoryModule(sizes);
+  const mem = new Uint8Array(exports.memory.buffer);
+  for (let size of sizes) {
+    const fill = exports[`fill${size}`];
+    initialize(mem);
+    const expected = mem.slice();
+    // Only the lowest byte of the value is used.
+    fill(13, 0x1234ab);
+    expected.fill(0xab, 13, 13 + size);
+    assertEquals(expected, mem);
+    assertTraps(kTrapMemOutOfBounds, () => fill(mem.length - size + 1, 1));
+    assertEquals(expected, mem);
+  }
+})();
+
+(function TestNonTemporalPath() {
+  print(arguments.callee.name);
+  const exports = instantiateBulkMemoryModule([]);
+  const mem = new Uint8Array(exports.memory.buffer);
+  // Sizes around the threshold, with unaligned start and end addresses.
+  for (let size of [4095, 4096, 4097, 20000]) {
+    for (let [dst, src] of [[30001, 3], [7, 30013], [100, 1000]]) {
+      initialize(mem);
+      const expected = mem.slice();
+      expected.copyWithin(dst, src, src + size);
+      exports.copy(dst, src, size);
+      assertEquals(expected, mem);
+    }
+    initialize(mem);
+    const expected = mem.slice();
+    expected.fill(0x5a, 33, 33 + size);
+    exports.fill(33, 0x5a, size);
+    assertEquals(expected, mem);
+  }
+  assertTraps(kTrapMemOutOfBounds, () => exports.copy(0, 1, mem.length));
+  assertTraps(kTrapMemOutOfBounds, () => exports.fill(1, 0, mem.length));
+})();
@@ -0,0 +1,49 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --wasm-code-flushing
+// Flags: --wasm-code-flushing-age=2 --wasm-dynamic-tiering
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+(function TestFlushColdTurbofanCode() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addFunction('hot', kSig_i_i)
+      .addBody([kExprLocalGet, 0, kExprI32Const, 1, kExprI32Add])
+      .exportFunc();
+  builder.addFunction('cold', kSig_i_i)
+      .addBody([kExprLocalGet, 0, kExprI32Const, 2, kExprI32Mul])
+      .exportFunc();
+  const {hot, cold} = builder.instantiate().exports;
+
+  assertEquals(2, hot(1));
+  assertEquals(6, cold(3));
+  %WasmTierUpFunction(hot);
+  %WasmTierUpFunction(cold);
+  assertTrue(%IsTurboFanFunction(hot));
+  assertTrue(%IsTurboFanFunction(cold));
+
+  // Both functions executed before the first aging cycle.
+  assertEquals(2, hot(1));
+  assertEquals(6, cold(3));
+  %WasmAgeCode();
+  assertTrue(%IsTurboFanFunction(hot));
+  assertTrue(%IsTurboFanFunction(cold));
+
+  // Only {hot} keeps executing.
+  for (let i = 0; i < 2; ++i) {
+    assertEquals(2, hot(1));
+    %WasmAgeCode();
+  }
+  assertTrue(%IsTurboFanFunction(hot));
+  assertTrue(%IsUncompiledWasmFunction(cold));
+
+  // The flushed function gets compiled lazily again, and can tier up again.
+  assertEquals(8, cold(4));
+  assertFalse(%IsUncompiledWasmFunction(cold));
+  %WasmTierUpFunction(cold);
+  assertTrue(%IsTurboFanFunction(cold));
+  assertEquals(10, cold(5));
+})();
@@ -0,0 +1,131 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --liftoff --no-wasm-tier-up --liftoff-loop-register-locals
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+(function TestSumLoop() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  builder.addFunction('sum', kSig_i_i)
+      .addLocals(kWasmI32, 2)  // i, acc
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 2, kExprLocalGet, 1, kExprI32Add, kExprLocalSet, 2,
+          kExprLocalGet, 1, kExprI32Const, 1, kExprI32Add, kExprLocalTee, 1,
+          kExprLocalGet, 0, kExprI32LtU, kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 2
+      ])
+      .exportFunc();
+  let instance = builder.instantiate();
+  assertEquals(0, instance.exports.sum(0));
+  assertEquals(45, instance.exports.sum(10));
+  assertEquals(4950, instance.exports.sum(100));
+})();
+
+(function TestMixedKindsAndNestedLoops() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  // Counts {n * m} iterations of nested loops, accumulating in i64, f64 and
+  // externref locals. Only the numeric ones can stay in registers.
+  builder.addFunction('nested', makeSig([kWasmI32, kWasmI32, kWasmExternRef],
+                                        [kWasmF64]))
+      .addLocals(kWasmI32, 2)       // 3: i, 4: j
+      .addLocals(kWasmI64, 1)       // 5: count
+      .addLocals(kWasmF64, 1)       // 6: sum
+      .addLocals(kWasmExternRef, 1)  // 7: ref
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprI32Const, 0, kExprLocalSet, 4,
+          kExprLoop, kWasmVoid,
+            kExprLocalGet, 5, kExprI64Const, 1, kExprI64Add, kExprLocalSet, 5,
+            kExprLocalGet, 6, kExprLocalGet, 4, kExprF64SConvertI32,
+            kExprF64Add, kExprLocalSet, 6,
+            kExprLocalGet, 2, kExprLocalSet, 7,
+            kExprLocalGet, 4, kExprI32Const, 1, kExprI32Add, kExprLocalTee, 4,
+            kExprLocalGet, 1, kExprI32LtS, kExprBrIf, 0,
+          kExprEnd,
+          kExprLocalGet, 3, kExprI32Const, 1, kExprI32Add, kExprLocalTee, 3,
+          kExprLocalGet, 0, kExprI32LtS, kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 7, kExprRefIsNull,
+        kExprIf, kWasmF64,
+          kExprF64Const, 0, 0, 0, 0, 0, 0, 0xf0, 0xbf,  // -1
+        kExprElse,
+          kExprLocalGet, 6, kExprLocalGet, 5, kExprF64SConvertI64, kExprF64Add,
+        kExprEnd
+      ])
+      .exportFunc();
+  let instance = builder.instantiate();
+  // sum = n * (0 + ... + (m - 1)), count = n * m.
+  assertEquals(3 * 10 + 3 * 5, instance.exports.nested(3, 5, {}));
+  assertEquals(7 * 28 + 7 * 8, instance.exports.nested(7, 8, 'x'));
+  assertEquals(-1, instance.exports.nested(2, 2, null));
+})();
+
+(function TestManyLocalsAndBranchOut() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  // Uses more locals than there are registers, and exits the loop through a
+  // branch to an outer block.
+  const kNumLocals = 40;
+  let body = [kExprBlock, kWasmVoid, kExprLoop, kWasmVoid];
+  for (let i = 1; i <= kNumLocals; ++i) {
+    body.push(kExprLocalGet, i, ...wasmI32Const(i), kExprI32Add,
+              kExprLocalSet, i);
+  }
+  body.push(
+      kExprLocalGet, 1, kExprLocalGet, 0, kExprI32GeS, kExprBrIf, 1,
+      kExprBr, 0, kExprEnd, kExprEnd, kExprI32Const, 0);
+  for (let i = 1; i <= kNumLocals; ++i) {
+    body.push(kExprLocalGet, i, kExprI32Add);
+  }
+  builder.addFunction('many', kSig_i_i)
+      .addLocals(kWasmI32, kNumLocals)
+      .addBody(body)
+      .exportFunc();
+  let instance = builder.instantiate();
+  // Each local {i} is incremented by {i} in each of the {k} iterations, where
+  // {k} is the first iteration count with {k >= limit}.
+  function expected(limit) {
+    let k = Math.max(1, limit);
+    return k * kNumLocals * (kNumLocals + 1) / 2;
+  }
+  assertEquals(expected(0), instance.exports.many(0));
+  assertEquals(expected(17), instance.exports.many(17));
+})();
+
+(function TestLoopWithTryDelegate() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  let tag = builder.addTag(kSig_v_v);
+  // The loop body contains a {try} which is closed by {delegate} instead of
+  // {end}; the locals after the loop are used more often than the ones in it.
+  builder.addFunction('delegate', kSig_i_i)
+      .addLocals(kWasmI32, 3)  // 1: i, 2: acc, 3: after
+      .addBody([
+        kExprTry, kWasmVoid,
+          kExprLoop, kWasmVoid,
+            kExprTry, kWasmVoid,
+              kExprLocalGet, 1, kExprI32Const, 5, kExprI32Eq,
+              kExprIf, kWasmVoid, kExprThrow, tag, kExprEnd,
+            kExprDelegate, 1,
+            kExprLocalGet, 2, kExprLocalGet, 1, kExprI32Add, kExprLocalSet, 2,
+            kExprLocalGet, 1, kExprI32Const, 1, kExprI32Add, kExprLocalTee, 1,
+            kExprLocalGet, 0, kExprI32LtS, kExprBrIf, 0,
+          kExprEnd,
+        kExprCatch, tag,
+          kExprLocalGet, 2, kExprI32Const, 100, kExprI32Add, kExprLocalSet, 2,
+        kExprEnd,
+        kExprLocalGet, 3, kExprLocalGet, 3, kExprLocalGet, 3, kExprLocalGet, 3,
+        kExprI32Add, kExprI32Add, kExprI32Add, kExprLocalGet, 2, kExprI32Add
+      ])
+      .exportFunc();
+  let instance = builder.instantiate();
+  assertEquals(0 + 1 + 2 + 3, instance.exports.delegate(4));
+  // Iteration 5 throws; the exception is caught outside the loop.
+  assertEquals(0 + 1 + 2 + 3 + 4 + 100, instance.exports.delegate(10));
+})();
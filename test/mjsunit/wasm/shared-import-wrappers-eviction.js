@@ -0,0 +1,33 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --wasm-shared-import-wrapper-cache-size=8
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+// The cache only holds a few wrappers, so instantiating modules with many
+// different signatures evicts wrappers which are later needed again.
+function instantiateWithImport(num_params, imp) {
+  let builder = new WasmModuleBuilder();
+  let sig = makeSig(new Array(num_params).fill(kWasmF64), [kWasmF64]);
+  let imp_index = builder.addImport('m', 'f', sig);
+  let body = [];
+  for (let i = 0; i < num_params; ++i) body.push(kExprLocalGet, i);
+  builder.addFunction('main', sig)
+      .addBody([...body, kExprCallFunction, imp_index])
+      .exportFunc();
+  return builder.instantiate({m: {f: imp}});
+}
+
+(function TestEviction() {
+  print(arguments.callee.name);
+  const sum = (...args) => args.reduce((a, b) => a + b, 0.5);
+  for (let round = 0; round < 3; ++round) {
+    for (let num_params = 0; num_params < 20; ++num_params) {
+      let instance = instantiateWithImport(num_params, sum);
+      let args = new Array(num_params).fill(1.25);
+      assertEquals(1.25 * num_params + 0.5, instance.exports.main(...args));
+    }
+  }
+})();
@@ -0,0 +1,84 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --experimental-wasm-gc
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+// Each module differs in its body, so the modules are not deduplicated by the
+// native module cache, but the import wrappers are shared.
+function instantiateWithImport(addend, imp) {
+  let builder = new WasmModuleBuilder();
+  let sig = makeSig([kWasmI32, kWasmF64], [kWasmI32]);
+  let imp_index = builder.addImport('m', 'f', sig);
+  builder.addFunction('main', sig)
+      .addBody([
+        kExprLocalGet, 0, kExprLocalGet, 1, kExprCallFunction, imp_index,
+        ...wasmI32Const(addend), kExprI32Add
+      ])
+      .exportFunc();
+  return builder.instantiate({m: {f: imp}});
+}
+
+(function TestSameSignatureInDifferentModules() {
+  print(arguments.callee.name);
+  for (let i = 0; i < 5; ++i) {
+    let instance = instantiateWithImport(i, (a, b) => a * 2 + b);
+    assertEquals(2 * 3 + 1 + i, instance.exports.main(3, 1));
+  }
+})();
+
+(function TestArityMismatchInDifferentModules() {
+  print(arguments.callee.name);
+  for (let i = 0; i < 3; ++i) {
+    let instance = instantiateWithImport(i, (a) => a + 1);
+    assertEquals(4 + i, instance.exports.main(3, 1));
+    instance = instantiateWithImport(i, (a, b, c) => c === undefined ? a : -1);
+    assertEquals(3 + i, instance.exports.main(3, 1));
+  }
+})();
+
+(function TestThrowingImport() {
+  print(arguments.callee.name);
+  for (let i = 0; i < 3; ++i) {
+    let instance = instantiateWithImport(i, () => { throw i; });
+    assertThrowsEquals(() => instance.exports.main(1, 2), i);
+  }
+})();
+
+// The following wrappers call runtime stubs (e.g. to allocate heap numbers,
+// convert BigInts or convert return values), which are relocated when a
+// cached wrapper is added to another module.
+function instantiateWithTypedImport(addend, sig, imp, body) {
+  let builder = new WasmModuleBuilder();
+  let imp_index = builder.addImport('m', 'f', sig);
+  builder.addFunction('main', sig)
+      .addBody([
+        ...body(imp_index),
+        ...wasmI32Const(addend), kExprDrop
+      ])
+      .exportFunc();
+  return builder.instantiate({m: {f: imp}});
+}
+
+(function TestWrappersCallingStubs() {
+  print(arguments.callee.name);
+  const f64_sig = makeSig([kWasmF64, kWasmF64], [kWasmF64]);
+  const i64_sig = makeSig([kWasmI64], [kWasmI64]);
+  const ref_sig = makeSig([kWasmExternRef], [kWasmF32]);
+  for (let i = 0; i < 5; ++i) {
+    let instance = instantiateWithTypedImport(
+        i, f64_sig, (a, b) => a * b + 0.5,
+        imp => [kExprLocalGet, 0, kExprLocalGet, 1, kExprCallFunction, imp]);
+    assertEquals(3.5 * 1.5 + 0.5, instance.exports.main(3.5, 1.5));
+    instance = instantiateWithTypedImport(
+        i, i64_sig, a => a * 3n,
+        imp => [kExprLocalGet, 0, kExprCallFunction, imp]);
+    assertEquals(2n ** 40n * 3n, instance.exports.main(2n ** 40n));
+    instance = instantiateWithTypedImport(
+        i, ref_sig, o => ({valueOf: () => o.x + 0.25}),
+        imp => [kExprLocalGet, 0, kExprCallFunction, imp]);
+    assertEquals(2.25, instance.exports.main({x: 2}));
+  }
+})();
@@ -0,0 +1,39 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --experimental-wasm-stringref --allow-natives-syntax
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+// A recognized String.prototype.indexOf import calls the StringIndexOf
+// builtin, which searches long ropes segment by segment.
+(function TestIndexOfRope() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  let sig_i_wwi =
+      makeSig([kWasmStringRef, kWasmStringRef, kWasmI32], [kWasmI32]);
+  let indexOf = builder.addImport('m', 'indexOf', sig_i_wwi);
+  builder.addFunction('call_indexof', sig_i_wwi).exportFunc().addBody([
+    kExprLocalGet, 0,
+    kExprLocalGet, 1,
+    kExprLocalGet, 2,
+    kExprCallFunction, indexOf,
+  ]);
+  indexOf = builder.instantiate({
+      m: {indexOf: Function.prototype.call.bind(String.prototype.indexOf)}
+  }).exports.call_indexof;
+  %WasmTierUpFunction(indexOf);
+
+  let rope = '';
+  const pieces = ['ab', 'c', 'ሴx', 'abcabd', 'q'];
+  for (let i = 0; i < 150000; ++i) rope += pieces[i % pieces.length];
+  assertTrue(rope.length >= 256 * 1024);
+  let expected = JSON.parse(JSON.stringify(rope));
+  for (let pattern of ['abc', 'qab', 'xab', 'dqabcሴ', 'not found']) {
+    for (let start of [0, 1000, rope.length - 3]) {
+      assertEquals(expected.indexOf(pattern, start),
+                   indexOf(rope, pattern, start));
+    }
+  }
+})();
@@ -0,0 +1,91 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/strings/string-case.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+uint8_t ExpectedLower(uint8_t c) {
+  if (('A' <= c && c <= 'Z') || (0xC0 <= c && c <= 0xDE && c != 0xD7)) {
+    return c + 0x20;
+  }
+  return c;
+}
+
+uint8_t ExpectedUpper(uint8_t c) {
+  if (('a' <= c && c <= 'z') || (0xE0 <= c && c <= 0xFE && c != 0xF7)) {
+    return c - 0x20;
+  }
+  return c;
+}
+
+// All Latin-1 characters, rotated by {offset} so that every character ends
+// up at every position of a vector.
+std::vector<uint8_t> Latin1Chars(int offset, bool with_special_upper_case) {
+  std::vector<uint8_t> chars;
+  for (int i = 0; i < 256; ++i) {
+    uint8_t c = static_cast<uint8_t>(i + offset);
+    if (!with_special_upper_case && (c == 0xB5 || c == 0xFF)) c = 'x';
+    chars.push_back(c);
+  }
+  return chars;
+}
+
+}  // namespace
+
+TEST(StringCaseTest, Latin1ConvertToLower) {
+  for (int offset = 0; offset < 64; ++offset) {
+    std::vector<uint8_t> src = Latin1Chars(offset, true);
+    for (size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 100, 256}) {
+      std::vector<uint8_t> dst(length);
+      Latin1ConvertToLower(dst.data(), src.data(), static_cast<int>(length));
+      for (size_t i = 0; i < length; ++i) {
+        EXPECT_EQ(ExpectedLower(src[i]), dst[i]);
+      }
+    }
+  }
+}
+
+TEST(StringCaseTest, Latin1ConvertToUpper) {
+  for (int offset = 0; offset < 64; ++offset) {
+    std::vector<uint8_t> src = Latin1Chars(offset, false);
+    for (size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 100, 256}) {
+      std::vector<uint8_t> dst(length);
+      int sharp_s_count = -1;
+      EXPECT_TRUE(Latin1ConvertToUpper(dst.data(), src.data(),
+                                       static_cast<int>(length),
+                                       &sharp_s_count));
+      int expected_sharp_s_count = 0;
+      for (size_t i = 0; i < length; ++i) {
+        if (src[i] == 0xDF) expected_sharp_s_count++;
+        EXPECT_EQ(ExpectedUpper(src[i]), dst[i]);
+      }
+      EXPECT_EQ(expected_sharp_s_count, sharp_s_count);
+    }
+  }
+}
+
+TEST(StringCaseTest, Latin1ConvertToUpperBeyondLatin1) {
+  for (uint8_t special : {0xB5, 0xFF}) {
+    for (int position = 0; position < 70; ++position) {
+      std::vector<uint8_t> src(70, 'a');
+      src[position] = special;
+      std::vector<uint8_t> dst(src.size());
+      int sharp_s_count;
+      EXPECT_FALSE(Latin1ConvertToUpper(dst.data(), src.data(),
+                                        static_cast<int>(src.size()),
+                                        &sharp_s_count));
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
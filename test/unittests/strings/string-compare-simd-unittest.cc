@@ -0,0 +1,83 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/strings/string-compare-simd.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+int Sign(int value) { return (value > 0) - (value < 0); }
+
+template <typename lchar, typename rchar>
+int ExpectedCompare(const std::vector<lchar>& lhs,
+                    const std::vector<rchar>& rhs) {
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    int r = static_cast<int>(lhs[i]) - static_cast<int>(rhs[i]);
+    if (r != 0) return r;
+  }
+  return 0;
+}
+
+template <typename lchar, typename rchar>
+void CheckCompare(const std::vector<lchar>& lhs,
+                  const std::vector<rchar>& rhs) {
+  int expected = ExpectedCompare(lhs, rhs);
+  EXPECT_EQ(Sign(expected),
+            Sign(CompareCharsVectorized(lhs.data(), rhs.data(), lhs.size())));
+  EXPECT_EQ(Sign(-expected),
+            Sign(CompareCharsVectorized(rhs.data(), lhs.data(), lhs.size())));
+  EXPECT_EQ(expected == 0, CompareCharsEqualVectorized(lhs.data(), rhs.data(),
+                                                       lhs.size()));
+  EXPECT_EQ(expected == 0, CompareCharsEqualVectorized(rhs.data(), lhs.data(),
+                                                       lhs.size()));
+}
+
+}  // namespace
+
+TEST(StringCompareSimdTest, OneByteAndTwoByte) {
+  for (size_t length : {0, 1, 7, 8, 9, 15, 16, 17, 33, 100}) {
+    std::vector<uint8_t> one_byte(length);
+    std::vector<base::uc16> two_byte(length);
+    for (size_t i = 0; i < length; ++i) {
+      one_byte[i] = static_cast<uint8_t>(0x61 + 0x35 * i);
+      two_byte[i] = one_byte[i];
+    }
+    CheckCompare(one_byte, two_byte);
+    // Move a difference over all positions of the vectors, with characters
+    // which differ in the low and in the high byte.
+    for (size_t position = 0; position < length; ++position) {
+      for (base::uc16 c : {0x00, 0x61, 0xFF, 0x100, 0x161, 0xFFFF}) {
+        std::vector<base::uc16> other = two_byte;
+        other[position] = c;
+        CheckCompare(one_byte, other);
+      }
+    }
+  }
+}
+
+TEST(StringCompareSimdTest, TwoByte) {
+  for (size_t length : {0, 1, 7, 8, 9, 15, 16, 17, 33, 100}) {
+    std::vector<base::uc16> chars(length);
+    for (size_t i = 0; i < length; ++i) {
+      chars[i] = static_cast<base::uc16>(0x61 + 0x1235 * i);
+    }
+    CheckCompare(chars, chars);
+    for (size_t position = 0; position < length; ++position) {
+      for (base::uc16 c : {0x00, 0x61, 0xFF, 0x8000, 0xFFFF}) {
+        std::vector<base::uc16> other = chars;
+        other[position] = c;
+        CheckCompare(chars, other);
+      }
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -10,6 +10,7 @@
 #include "src/base/vector.h"
 #include "src/strings/unicode-decoder.h"
 #include "src/strings/unicode-inl.h"
+#include "src/strings/utf8-simd.h"
 #include "test/unittests/heap/heap-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -495,6 +496,68 @@ TEST(UnicodeTest, IncrementalUTF8DecodingVsNonIncrementalUtf8Decoding) {
   }
 }
 
+TEST(UnicodeTest, Utf8DecodingAcrossVectorBlocks) {
+  // Valid UTF-8 is validated and measured a vector of bytes at a time. Move
+  // valid and invalid sequences over the boundaries of the vectors, after a
+  // non-ASCII character so that the vectors start at the same position.
+  const std::vector<uint8_t> sequences[] = {
+      {0xC3, 0xA9},              // U+00E9
+      {0xD0, 0x96},              // U+0416
+      {0xE2, 0x82, 0xAC},        // U+20AC
+      {0xF0, 0x9F, 0x98, 0x80},  // U+1F600
+      {0xED, 0xA0, 0x80},        // Encoded surrogate.
+      {0xC0, 0x80},              // Overlong encoding.
+      {0xF4, 0x90, 0x80, 0x80},  // Beyond U+10FFFF.
+      {0xE2, 0x82},              // Cut off.
+      {0x80},                    // Lone continuation byte.
+  };
+  for (const std::vector<uint8_t>& sequence : sequences) {
+    for (size_t prefix = 0; prefix < 70; ++prefix) {
+      for (size_t suffix : {0, 1, 2, 3, 40}) {
+        std::vector<uint8_t> bytes = {0xC3, 0xA9};
+        bytes.insert(bytes.end(), prefix, 'a');
+        bytes.insert(bytes.end(), sequence.begin(), sequence.end());
+        bytes.insert(bytes.end(), suffix, 'b');
+
+        std::vector<unibrow::uchar> output_incremental;
+        DecodeIncrementally(bytes, &output_incremental);
+        std::vector<unibrow::uchar> output_utf16;
+        DecodeUtf16(bytes, &output_utf16);
+        CHECK(output_incremental == output_utf16);
+      }
+    }
+  }
+}
+
+TEST(UnicodeTest, Utf8EncodedLength) {
+  const uint16_t kChars[] = {'a',    0xE9,   0x416, 0x20AC, 0xD83D,
+                             0xDE00, 0xDC00, 'b',   0xD800, 0xFFFF};
+  std::vector<uint16_t> two_byte;
+  std::vector<uint8_t> one_byte;
+  for (size_t i = 0; i < 200; ++i) {
+    int expected_two_byte = 0;
+    int previous = unibrow::Utf16::kNoPreviousCharacter;
+    for (uint16_t c : two_byte) {
+      expected_two_byte += unibrow::Utf8::Length(c, previous);
+      previous = c;
+    }
+    CHECK_EQ(expected_two_byte,
+             Utf8EncodedLength(base::VectorOf(two_byte.data(), i)));
+    int expected_one_byte = 0;
+    for (uint8_t c : one_byte) {
+      expected_one_byte += unibrow::Utf8::Length(c, 0);
+    }
+    CHECK_EQ(expected_one_byte,
+             Utf8EncodedLength(base::VectorOf(one_byte.data(), i)));
+    CHECK_EQ(std::min(static_cast<int>(i), 37),
+             AsciiPrefixLength(base::VectorOf(one_byte.data(), i)));
+
+    // Mostly ASCII, with other characters in between.
+    two_byte.push_back(i % 7 == 3 ? kChars[(i / 7) % 10] : 'x');
+    one_byte.push_back(i >= 37 && i % 3 == 1 ? 0xE9 : 'x');
+  }
+}
+
 class UnicodeWithGCTest : public TestWithHeapInternals {};
 
 #define GC_INSIDE_NEW_STRING_FROM_UTF8_SUB_STRING(NAME, STRING)                \
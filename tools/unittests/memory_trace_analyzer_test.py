@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+# Copyright 2023 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+import importlib.util
+import os
+import tempfile
+import unittest
+
+TOOLS_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+ANALYZER = os.path.join(TOOLS_DIR, 'wasm', 'memory-trace-analyzer.py')
+
+# The file name is not a valid module name, hence import it by path.
+spec = importlib.util.spec_from_file_location('memory_trace_analyzer',
+                                              ANALYZER)
+analyzer = importlib.util.module_from_spec(spec)
+spec.loader.exec_module(analyzer)
+
+
+def record(kind, func_index, position=0, offset=0, is_store=False):
+  return analyzer.RECORD.pack(kind, 0, 0, int(is_store), func_index, position,
+                              0, offset)
+
+
+def chunk(thread_id, records):
+  header = analyzer.CHUNK_HEADER.pack(analyzer.WASM_TRACE_MAGIC,
+                                      analyzer.WASM_TRACE_VERSION, thread_id,
+                                      len(records), 0)
+  return header + b''.join(records)
+
+
+class MemoryTraceAnalyzerTest(unittest.TestCase):
+
+  def analyze(self, data):
+    fd, path = tempfile.mkstemp()
+    try:
+      with os.fdopen(fd, 'wb') as trace:
+        trace.write(data)
+      return analyzer.analyze(path, 64)
+    finally:
+      os.remove(path)
+
+  def testFunctionEntries(self):
+    functions, loops = self.analyze(
+        chunk(1, [record(analyzer.KIND_FUNCTION_ENTRY, 3)] * 5) +
+        chunk(2, [record(analyzer.KIND_FUNCTION_ENTRY, 3),
+                  record(analyzer.KIND_FUNCTION_EXIT, 3)]))
+    self.assertEqual(6, functions[3].entries)
+    self.assertEqual(0, functions[3].accesses())
+    self.assertEqual({}, loops)
+
+  def testMemoryLocality(self):
+    access = lambda offset, is_store=False: record(
+        analyzer.KIND_MEMORY_ACCESS, 1, offset=offset, is_store=is_store)
+    # Sequential accesses, then one jump of more than a page.
+    functions, _ = self.analyze(
+        chunk(1, [access(0), access(8), access(64, True), access(1 << 20)]))
+    stats = functions[1]
+    self.assertEqual(3, stats.loads)
+    self.assertEqual(1, stats.stores)
+    self.assertEqual(3, len(stats.cache_lines))
+    self.assertEqual(2, stats.local_accesses)
+    self.assertEqual(1, stats.far_accesses)
+
+  def testThreadsAreNotMixed(self):
+    access = lambda offset: record(analyzer.KIND_MEMORY_ACCESS, 1,
+                                   offset=offset)
+    functions, _ = self.analyze(
+        chunk(1, [access(0)]) + chunk(2, [access(1 << 20)]) +
+        chunk(1, [access(8)]) + chunk(2, [access((1 << 20) + 8)]))
+    self.assertEqual(2, functions[1].local_accesses)
+    self.assertEqual(0, functions[1].far_accesses)
+
+  def testLoopTripCounts(self):
+    loop_records = []
+    for trips in (3, 5):
+      loop_records.append(record(analyzer.KIND_LOOP_ENTRY, 2, position=0x20))
+      loop_records += [record(analyzer.KIND_LOOP_ITERATION, 2, position=0x20)
+                      ] * trips
+    loop_records.append(record(analyzer.KIND_LOOP_ENTRY, 2, position=0x40))
+    _, loops = self.analyze(chunk(1, loop_records))
+    self.assertEqual(2, loops[(2, 0x20)].entries)
+    self.assertEqual(8, loops[(2, 0x20)].iterations)
+    self.assertEqual(4.0, loops[(2, 0x20)].trip_count())
+    self.assertEqual(1, loops[(2, 0x40)].entries)
+    self.assertEqual(0.0, loops[(2, 0x40)].trip_count())
+
+  def testUnsupportedVersion(self):
+    header = analyzer.CHUNK_HEADER.pack(analyzer.WASM_TRACE_MAGIC, 1, 1, 0, 0)
+    with self.assertRaises(SystemExit):
+      self.analyze(header)
+
+
+if __name__ == '__main__':
+  unittest.main()
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+# vim:fenc=utf-8:ts=2:sw=2:softtabstop=2:expandtab:
+# Copyright 2023 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Analyzes a binary Wasm execution trace written with --wasm-trace-file.
+
+Record a trace with e.g.
+  d8 --trace-wasm --trace-wasm-memory --wasm-trace-loops \\
+     --wasm-trace-file=trace.bin --wasm-trace-memory-sample-rate=1 test.js
+and run
+  memory-trace-analyzer.py trace.bin
+
+Generated code records each event with a C call into a per-thread buffer, so
+tracing is cheap enough for realistic workloads. Embedders can write out the
+buffers of a running application with v8::WasmTrace::Flush().
+
+The output lists the most frequently entered functions, and for each function
+with memory accesses how local these accesses are: the share of accesses
+that hit the same or the next cache line as the previous access of the same
+function, and the share of accesses that jumped further than a page. Functions
+with a low locality are candidates for cache-unfriendly access patterns. For
+sampled traces, only the per-function totals are meaningful. With
+--wasm-trace-loops, which restricts execution to Liftoff, it also lists the
+hottest loops with their average trip count.
+
+The format is defined in src/wasm/memory-tracing.h.
+"""
+
+import argparse
+import collections
+import struct
+import sys
+
+WASM_TRACE_MAGIC = 0x74727377
+WASM_TRACE_VERSION = 2
+# magic, version, thread_id, record_count, reserved
+CHUNK_HEADER = struct.Struct('=IIQII')
+# kind, tier, mem_rep, is_store, func_index, position, reserved, offset
+RECORD = struct.Struct('=BBBBiiIQ')
+
+KIND_FUNCTION_ENTRY = 0
+KIND_FUNCTION_EXIT = 1
+KIND_MEMORY_ACCESS = 2
+KIND_LOOP_ENTRY = 3
+KIND_LOOP_ITERATION = 4
+
+PAGE_SIZE = 4096
+
+
+class FunctionStats:
+
+  def __init__(self):
+    self.entries = 0
+    self.loads = 0
+    self.stores = 0
+    self.local_accesses = 0
+    self.far_accesses = 0
+    self.cache_lines = set()
+    self.last_offset = None
+
+  def accesses(self):
+    return self.loads + self.stores
+
+  def locality(self):
+    if self.accesses() <= 1: return 1.0
+    return self.local_accesses / (self.accesses() - 1)
+
+
+class LoopStats:
+
+  def __init__(self):
+    self.entries = 0
+    self.iterations = 0
+
+  def trip_count(self):
+    if self.entries == 0: return 0.0
+    return self.iterations / self.entries
+
+
+def read_records(path):
+  with open(path, 'rb') as trace:
+    while True:
+      header = trace.read(CHUNK_HEADER.size)
+      if not header: return
+      if len(header) != CHUNK_HEADER.size:
+        sys.exit('Truncated chunk header')
+      magic, version, thread_id, count, _ = CHUNK_HEADER.unpack(header)
+      if magic != WASM_TRACE_MAGIC or version != WASM_TRACE_VERSION:
+        sys.exit('Not a Wasm trace, or unsupported version')
+      data = trace.read(count * RECORD.size)
+      if len(data) != count * RECORD.size:
+        sys.exit('Truncated chunk')
+      for record in RECORD.iter_unpack(data):
+        yield thread_id, record
+
+
+def analyze(path, cache_line_size):
+  # Functions are keyed by function index, loops by function index and the
+  # position of the loop instruction. Accesses of different threads are not
+  # mixed up when computing the locality.
+  functions = collections.defaultdict(FunctionStats)
+  loops = collections.defaultdict(LoopStats)
+  last_offsets = {}
+  for thread_id, record in read_records(path):
+    kind, _, _, is_store, func_index, position, _, offset = record
+    stats = functions[func_index]
+    if kind == KIND_FUNCTION_ENTRY:
+      stats.entries += 1
+    elif kind == KIND_LOOP_ENTRY:
+      loops[(func_index, position)].entries += 1
+    elif kind == KIND_LOOP_ITERATION:
+      loops[(func_index, position)].iterations += 1
+    elif kind == KIND_MEMORY_ACCESS:
+      if is_store:
+        stats.stores += 1
+      else:
+        stats.loads += 1
+      line = offset // cache_line_size
+      stats.cache_lines.add(line)
+      last = last_offsets.get((thread_id, func_index))
+      if last is not None:
+        last_line = last // cache_line_size
+        if line in (last_line, last_line + 1):
+          stats.local_accesses += 1
+        elif abs(offset - last) >= PAGE_SIZE:
+          stats.far_accesses += 1
+      last_offsets[(thread_id, func_index)] = offset
+  return functions, loops
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+  parser.add_argument('trace', help='file written with --wasm-trace-file')
+  parser.add_argument('--cache-line-size', type=int, default=64)
+  parser.add_argument('--top', type=int, default=20,
+                      help='number of functions to list')
+  args = parser.parse_args()
+
+  functions, loops = analyze(args.trace, args.cache_line_size)
+
+  print('Most frequently entered functions:')
+  print('%10s  %s' % ('entries', 'function'))
+  by_entries = sorted(functions.items(), key=lambda f: -f[1].entries)
+  for func_index, stats in by_entries[:args.top]:
+    if stats.entries == 0: break
+    print('%10d  wasm-function[%d]' % (stats.entries, func_index))
+
+  print()
+  print('Memory accesses, least local first:')
+  print('%10s %10s %10s %8s %8s  %s' % ('loads', 'stores', 'lines', 'local',
+                                        'far', 'function'))
+  with_accesses = [(i, s) for i, s in functions.items() if s.accesses() > 1]
+  with_accesses.sort(key=lambda f: (f[1].locality(), -f[1].accesses()))
+  for func_index, stats in with_accesses[:args.top]:
+    far = stats.far_accesses / (stats.accesses() - 1)
+    print('%10d %10d %10d %7.1f%% %7.1f%%  wasm-function[%d]' %
+          (stats.loads, stats.stores, len(stats.cache_lines),
+           100 * stats.locality(), 100 * far, func_index))
+
+  if not loops: return
+  print()
+  print('Loops with the most iterations:')
+  print('%10s %10s %10s  %s' % ('iterations', 'entries', 'trips', 'loop'))
+  by_iterations = sorted(loops.items(), key=lambda l: -l[1].iterations)
+  for (func_index, position), stats in by_iterations[:args.top]:
+    print('%10d %10d %10.1f  wasm-function[%d]:0x%x' %
+          (stats.iterations, stats.entries, stats.trip_count(), func_index,
+           position))
+
+
+if __name__ == '__main__':
+  main()